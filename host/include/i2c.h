@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Host stand-in for the lib-i2c public header.
+//!	
+//!	@details		Provides the subset of lib-i2c types and constants referenced by the "wii" 
+//!					library so it may be compiled on a workstation. All bus traffic is handled by 
+//!					the simulated backend ("wii_sim.c").
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __I2C__
+#define	__I2C__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+typedef int32_t		BOOL;																			//!< Boolean type used throughout lib-i2c.
+
+#ifndef TRUE
+#define	TRUE		1																				//!< Boolean true.
+#endif
+#ifndef FALSE
+#define	FALSE		0																				//!< Boolean false.
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Enum of return code values.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _I2C_RC
+{
+	I2C_RC_SUCCESS									= 0,											//!< Successfully completed transfer.
+	I2C_RC_NO_ACK									= 1,											//!< Target did not acknowledge the transfer.
+	I2C_RC_BUS_ERROR								= 2												//!< Bus or port error.
+} I2C_RC;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			I2C modules (ports) available.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _I2C_MODULE
+{
+	I2C1											= 0,											//!< I2C module 1.
+	I2C2											= 1,											//!< I2C module 2.
+	I2C3											= 2,											//!< I2C module 3.
+	I2C4											= 3,											//!< I2C module 4.
+	I2C5											= 4,											//!< I2C module 5.
+	I2C_NUMBER_OF_MODULES							= 5												//!< Number of I2C modules available.
+} I2C_MODULE;
+
+
+#define	I2C_ENABLE_SLAVE_CLOCK_STRETCHING			0x0001											//!< Port configuration flag (unused by simulation).
+#define	I2C_STOP_IN_IDLE							0x0002											//!< Port configuration flag (unused by simulation).
+#define	I2C_CLOCK_RATE_STANDARD						100000											//!< Standard mode bus clock (Hz).
+#define	I2C_CLOCK_RATE_FAST							400000											//!< Fast mode bus clock (Hz).
+#define	I2C_ACK_MODE_ACK							0												//!< Acknowledge received bytes.
+#define	I2C_MODE_MASTER								0												//!< Operate port as a bus master.
+#define	I2C_ADDR_LEN_7_BITS							0												//!< Use 7-bit addressing.
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			I2C port settings.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _I2C_Port
+{
+	uint32_t										config;											//!< Port configuration flags.
+	I2C_MODULE										module;											//!< I2C module used by port.
+	uint32_t										clkFreq;										//!< Bus clock frequency (Hz).
+	uint32_t										ackMode;										//!< Acknowledge mode.
+} I2C_Port;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			I2C device (target) settings.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _I2C_Device
+{
+	I2C_Port										port;											//!< Port used to reach the target.
+	uint32_t										mode;											//!< Master/slave mode.
+	uint32_t										addrLength;										//!< Address length.
+	uint8_t											addr;											//!< Target address.
+	uint32_t										delayAfterSend_Ms;								//!< Delay (ms) after transmitting before raising stop.
+	uint32_t										delayAfterReceive_Ms;							//!< Delay (ms) after receiving before raising stop.
+	uint32_t										delayBetweenTxRx_Ms;							//!< Delay (ms) between transmit and receive phases of a combined transfer.
+} I2C_Device;
+
+
+#endif	// __I2C__
@@ -0,0 +1,840 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Host benchmark for the "wii" library module.
+//!	
+//!	@details		Reports:
+//!						-	Decode throughput of the target-specific status processing (host CPU).
+//!						-	Decode throughput of 'WiiBatch_Decode()' over a large capture (host CPU).
+//!						-	Cost of identifying a target through the driver registry (host CPU).
+//!						-	Cost of a single 'WiiFusion_Update()' (host CPU, in time and time stamp 
+//!							counter cycles where available).
+//!						-	Cost of a single 'WiiOutput_Process()' (host CPU, same units).
+//!						-	Modelled time per status poll (bus + delays) using the simulated bus.
+//!						-	Frames per second achieved by 'WiiLib_Service()' on the simulated bus, with 
+//!							blocking transfers and with the interrupt driven transaction queue.
+//!						-	Aggregate frames per second per bus achieved by 'WiiScheduler_Service()' 
+//!							with several targets behind multiplexers.
+//!						-	Transfer statistics ('WiiStats_Block{}') recorded while servicing a target 
+//!							(host CPU time and modelled time, in ns, as separate counters).
+//!						-	Size of a capture ('WiiCapture_Recorder{}') and the rate at which it 
+//!							replays through the simulated bus ("wii_replay.h") on the host CPU.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "wii_lib.h"
+#include "wii_sim.h"
+#include "wii_replay.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_BENCH_DECODE_FRAMES						20000000UL										//!< Number of frames decoded per decode benchmark.
+#define	WII_BENCH_FRAME_POOL						256												//!< Number of distinct random frames cycled through while decoding.
+#define	WII_BENCH_BATCH_FRAMES						(1UL << 20)										//!< Number of frames in the capture decoded by the batch benchmark.
+#define	WII_BENCH_BATCH_PASSES						16												//!< Number of passes over the capture made by the batch benchmark.
+#define	WII_BENCH_FUSION_UPDATES					5000000UL										//!< Number of updates applied per fusion benchmark.
+#define	WII_BENCH_OUTPUT_FRAMES						20000000UL										//!< Number of frames processed per output stage benchmark.
+#define	WII_BENCH_POLLS								1000											//!< Number of polls averaged by the poll benchmarks.
+#define	WII_BENCH_SERVICE_US						1000000UL										//!< Virtual time (us) the service benchmark runs for.
+#define	WII_BENCH_LOOP_US							50												//!< Virtual time (us) the main loop spends on other work between service calls.
+#define	WII_BENCH_MUX_ADDR							0x70											//!< Address of the simulated multiplexer on each bus.
+#define	WII_BENCH_MAX_BUSES							2												//!< Most buses used by the scheduler benchmark.
+#define	WII_BENCH_MAX_PER_BUS						4												//!< Most targets per bus used by the scheduler benchmark.
+#define	WII_BENCH_CAPTURE_POLLS						200000UL										//!< Number of polls recorded by the capture benchmark.
+#define	WII_BENCH_CAPTURE_MOVE_EVERY				8												//!< Polls between joystick movements while recording.
+#define	WII_BENCH_REPLAY_PASSES						4												//!< Number of passes over the capture made while replaying.
+#define	WII_BENCH_LOOKUPS							20000000UL										//!< Number of identifiers looked up per registry benchmark.
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static double		WiiBench_Seconds(			void																			);
+static uint32_t		WiiBench_Random(			void																			);
+static uint64_t		WiiBench_Cycles(			void																			);
+static void			WiiBench_Decode(			const char *name,		WII_LIB_TARGET_DEVICE target,	WII_LIB_RC (*decode)(WiiLib_Device *)	);
+static void			WiiBench_Batch(				const char *name,		WII_LIB_TARGET_DEVICE target											);
+static void			WiiBench_Lookup(			const char *name,		const uint8_t (*ids)[WII_LIB_ID_LENGTH],	uint32_t count				);
+static void			WiiBench_Fusion(			const char *name,		uint8_t sources															);
+static void			WiiBench_Output(			const char *name,		WII_LIB_TARGET_DEVICE target,	WII_OUTPUT_DEADZONE mode,	BOOL curved	);
+static void			WiiBench_Poll(				const char *name,		WII_LIB_TARGET_DEVICE target,	WII_LIB_REPORT report,	BOOL configureEachPoll	);
+static void			WiiBench_Service(			const char *name,		WII_LIB_TARGET_DEVICE target,	BOOL queued								);
+static void			WiiBench_Scheduler(			uint32_t buses,			uint32_t perBus,				BOOL queued,			WII_SCHEDULER_MODE mode		);
+static void			WiiBench_Stats(				const char *name,		WII_LIB_TARGET_DEVICE target											);
+static BOOL			WiiBench_Capture(			const char *name,		WII_LIB_TARGET_DEVICE target											);
+static void			WiiBench_Write(				void *context,			const uint8_t *data,			uint32_t len							);
+static void			WiiBench_Isr(				void *context																	);
+
+
+
+
+//==================================================================================================
+//	PRIVATE CONSTANTS
+//--------------------------------------------------------------------------------------------------
+// Identifiers looked up by the registry benchmark.
+static const uint8_t	WiiBench_IdsKnown[][WII_LIB_ID_LENGTH]		= {	WII_LIB_ID_NUNCHUCK,	WII_LIB_ID_CLASSIC_CONTROLLER,	WII_LIB_ID_CLASSIC_CONTROLLER_HIGH_RES,	WII_LIB_ID_WII_MOTION_PLUS, 
+																		WII_GUITAR_HERO_ID_GUITAR,	WII_GUITAR_HERO_ID_DRUMS,	WII_GUITAR_HERO_ID_TURNTABLE,	WII_LIB_ID_WII_MOTION_PLUS_PASS_NUNCHUCK	};
+static const uint8_t	WiiBench_IdsUnknown[][WII_LIB_ID_LENGTH]	= {	{ 0x00, 0x00, 0xA4, 0x20, 0x01, 0x12 },	{ 0x00, 0x00, 0xA4, 0x20, 0x01, 0x11 },	{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }	};
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Runs all benchmarks and prints the results.
+//!	
+//!	@returns		Zero on success (non-zero if a replay did not reproduce the interface recorded).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int main( void )
+{
+	BOOL			replayed	= TRUE;
+	
+	printf( "== decode throughput (host CPU) ==\n" );
+	WiiBench_Decode( "nunchuck",				WII_LIB_TARGET_DEVICE_NUNCHUCK,						WiiNunchuck_ProcessStatusParam	);
+	WiiBench_Decode( "nunchuck pass-through",	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK,	WiiNunchuck_ProcessStatusParam	);
+	WiiBench_Decode( "classic",					WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,			WiiClassic_ProcessStatusParam	);
+	WiiBench_Decode( "classic pass-through",	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC,		WiiClassic_ProcessStatusParam	);
+	WiiBench_Decode( "motion plus",				WII_LIB_TARGET_DEVICE_MOTION_PLUS,					WiiMotionPlus_ProcessStatusParam	);
+	WiiBench_Decode( "motion plus pass-through",	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK,	WiiMotionPlus_ProcessPassThrough	);
+	WiiBench_Decode( "guitar",					WII_LIB_TARGET_DEVICE_GUITAR,						WiiGuitarHero_ProcessGuitar		);
+	WiiBench_Decode( "drums",					WII_LIB_TARGET_DEVICE_DRUMS,						WiiGuitarHero_ProcessDrums		);
+	WiiBench_Decode( "turntable",				WII_LIB_TARGET_DEVICE_TURNTABLE,					WiiGuitarHero_ProcessTurntable	);
+	
+	printf( "\n== batch decode throughput (host CPU, %lu frame capture) ==\n", (unsigned long)WII_BENCH_BATCH_FRAMES );
+	WiiBench_Batch( "nunchuck",					WII_LIB_TARGET_DEVICE_NUNCHUCK						);
+	WiiBench_Batch( "nunchuck pass-through",	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK		);
+	WiiBench_Batch( "classic",					WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER			);
+	WiiBench_Batch( "classic pass-through",		WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC		);
+	
+	printf( "\n== target identification (host CPU, driver registry) ==\n" );
+	WiiBench_Lookup( "known identifiers",		WiiBench_IdsKnown,		sizeof(WiiBench_IdsKnown) / WII_LIB_ID_LENGTH	);
+	WiiBench_Lookup( "unknown identifiers",		WiiBench_IdsUnknown,	sizeof(WiiBench_IdsUnknown) / WII_LIB_ID_LENGTH	);
+	
+	printf( "\n== orientation fusion update cost (host CPU) ==\n" );
+	WiiBench_Fusion( "accelerometer only",			WII_FUSION_SOURCE_ACCEL								);
+	WiiBench_Fusion( "gyroscope only",				WII_FUSION_SOURCE_GYRO								);
+	WiiBench_Fusion( "gyroscope + accelerometer",	WII_FUSION_SOURCE_GYRO | WII_FUSION_SOURCE_ACCEL	);
+	
+	printf( "\n== joystick output stage cost (host CPU) ==\n" );
+	WiiBench_Output( "nunchuck axial",				WII_LIB_TARGET_DEVICE_NUNCHUCK,				WII_OUTPUT_DEADZONE_AXIAL,	FALSE	);
+	WiiBench_Output( "nunchuck radial",				WII_LIB_TARGET_DEVICE_NUNCHUCK,				WII_OUTPUT_DEADZONE_RADIAL,	FALSE	);
+	WiiBench_Output( "classic axial + curve",		WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,	WII_OUTPUT_DEADZONE_AXIAL,	TRUE	);
+	WiiBench_Output( "classic radial + curve",		WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,	WII_OUTPUT_DEADZONE_RADIAL,	TRUE	);
+	
+	printf( "\n== modelled time per blocking poll (simulated bus, 100 kHz) ==\n" );
+	WiiBench_Poll( "nunchuck",							WII_LIB_TARGET_DEVICE_NUNCHUCK,				WII_LIB_REPORT_STANDARD,		FALSE	);
+	WiiBench_Poll( "nunchuck (buttons-only report)",	WII_LIB_TARGET_DEVICE_NUNCHUCK,				WII_LIB_REPORT_BUTTONS,			FALSE	);
+	WiiBench_Poll( "classic",							WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,	WII_LIB_REPORT_STANDARD,		FALSE	);
+	WiiBench_Poll( "classic (buttons-only report)",		WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,	WII_LIB_REPORT_BUTTONS,			FALSE	);
+	WiiBench_Poll( "classic (high-res report)",			WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,	WII_LIB_REPORT_HIGH_RESOLUTION,	FALSE	);
+	WiiBench_Poll( "classic + reconfigure each poll",	WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,	WII_LIB_REPORT_STANDARD,		TRUE	);
+	WiiBench_Poll( "guitar",							WII_LIB_TARGET_DEVICE_GUITAR,				WII_LIB_REPORT_STANDARD,		FALSE	);
+	
+	printf( "\n== non-blocking service (simulated bus, %u us of other work per loop) ==\n", (unsigned)WII_BENCH_LOOP_US );
+	WiiBench_Service( "nunchuck",					WII_LIB_TARGET_DEVICE_NUNCHUCK,				FALSE	);
+	WiiBench_Service( "classic",					WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,	FALSE	);
+	WiiBench_Service( "nunchuck (interrupt queue)",	WII_LIB_TARGET_DEVICE_NUNCHUCK,				TRUE	);
+	WiiBench_Service( "classic (interrupt queue)",	WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,	TRUE	);
+	WiiBench_Service( "motion plus",				WII_LIB_TARGET_DEVICE_MOTION_PLUS,			FALSE	);
+	WiiBench_Service( "motion plus (interrupt queue)",	WII_LIB_TARGET_DEVICE_MOTION_PLUS,		TRUE	);
+	WiiBench_Service( "motion plus pass-through",		WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK,	FALSE	);
+	WiiBench_Service( "motion plus pass-through (queue)",	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK,	TRUE	);
+	
+	printf( "\n== scheduler (nunchucks behind a multiplexer per bus, %u us of other work per loop) ==\n", (unsigned)WII_BENCH_LOOP_US );
+	WiiBench_Scheduler( 1, 1, FALSE,	WII_SCHEDULER_MODE_FIXED	);
+	WiiBench_Scheduler( 1, 4, FALSE,	WII_SCHEDULER_MODE_FIXED	);
+	WiiBench_Scheduler( 2, 4, FALSE,	WII_SCHEDULER_MODE_FIXED	);
+	WiiBench_Scheduler( 1, 4, TRUE,		WII_SCHEDULER_MODE_FIXED	);
+	WiiBench_Scheduler( 2, 4, TRUE,		WII_SCHEDULER_MODE_FIXED	);
+	WiiBench_Scheduler( 1, 4, FALSE,	WII_SCHEDULER_MODE_ADAPTIVE	);
+	WiiBench_Scheduler( 2, 4, TRUE,		WII_SCHEDULER_MODE_ADAPTIVE	);
+	
+	printf( "\n== transfer statistics (non-blocking service, ns of host CPU time and of modelled time) ==\n" );
+	WiiBench_Stats( "nunchuck",		WII_LIB_TARGET_DEVICE_NUNCHUCK				);
+	WiiBench_Stats( "classic",		WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER	);
+	
+	printf( "\n== capture and replay (%lu blocking polls recorded, replayed at max speed on the host CPU) ==\n", (unsigned long)WII_BENCH_CAPTURE_POLLS );
+	replayed &= WiiBench_Capture( "nunchuck",	WII_LIB_TARGET_DEVICE_NUNCHUCK				);
+	replayed &= WiiBench_Capture( "classic",	WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER	);
+	
+	return ( replayed ? 0 : 1 );
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reads the host monotonic clock.
+//!	
+//!	@returns		Current time in seconds.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static double WiiBench_Seconds( void )
+{
+	struct timespec		ts;
+	
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Small deterministic pseudo-random generator (xorshift32).
+//!	
+//!	@returns		Next pseudo-random value.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint32_t WiiBench_Random( void )
+{
+	static uint32_t		state		= 0x12345678;
+	
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reads the time stamp counter of the host CPU.
+//!	
+//!	@returns		Current count (zero if the host has no counter this bench knows how to read).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint64_t WiiBench_Cycles( void )
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Measures decode throughput for a target-specific status processing function.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		target				Target type to decode as.
+//!	@param[in]		decode				Status processing function under test.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Decode( const char *name, WII_LIB_TARGET_DEVICE target, WII_LIB_RC (*decode)(WiiLib_Device *) )
+{
+	static uint8_t		frames[WII_BENCH_FRAME_POOL][WII_LIB_PARAM_RESPONSE_LEN_DEFAULT];
+	static WiiLib_Device	device;
+	volatile int32_t	sink		= 0;
+	uint32_t			index;
+	uint32_t			frame;
+	double				start;
+	double				elapsed;
+	
+	for( frame = 0; frame < WII_BENCH_FRAME_POOL; ++frame )
+		for( index = 0; index < WII_LIB_PARAM_RESPONSE_LEN_DEFAULT; ++index )
+			frames[frame][index] = (uint8_t)WiiBench_Random();
+	
+	memset( &device, 0, sizeof(device) );
+	device.target = target;
+	
+	start = WiiBench_Seconds();
+	for( index = 0; index < WII_BENCH_DECODE_FRAMES; ++index )
+	{
+		memcpy( &device.dataCurrent[0], &frames[index % WII_BENCH_FRAME_POOL][0], WII_LIB_PARAM_RESPONSE_LEN_DEFAULT );
+		decode( &device );
+		sink += device.interfaceCurrent.analogLeftX + (int32_t)device.interfaceCurrent.buttons;
+	}
+	elapsed = WiiBench_Seconds() - start;
+	
+	printf( "  %-32s %8.1f Mframes/s  %6.2f ns/frame\n", name, (double)WII_BENCH_DECODE_FRAMES / elapsed / 1e6, elapsed * 1e9 / (double)WII_BENCH_DECODE_FRAMES );
+	(void)sink;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Measures 'WiiBatch_Decode()' throughput over a capture of random frames with all 
+//!					outputs requested.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		target				Target type to decode as.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Batch( const char *name, WII_LIB_TARGET_DEVICE target )
+{
+	static uint8_t		frames[WII_BENCH_BATCH_FRAMES * WII_BATCH_FRAME_LEN];
+	static uint32_t		buttons[WII_BENCH_BATCH_FRAMES];
+	static int8_t		triggers[2][WII_BENCH_BATCH_FRAMES];
+	static int16_t		axes[7][WII_BENCH_BATCH_FRAMES];
+	WiiBatch_Output		output;
+	uint32_t			index;
+	double				start;
+	double				elapsed;
+	
+	for( index = 0; index < sizeof(frames); ++index )
+		frames[index] = (uint8_t)WiiBench_Random();
+	
+	output.buttons			= buttons;
+	output.triggerLeft		= triggers[0];
+	output.triggerRight		= triggers[1];
+	output.analogLeftX		= axes[0];
+	output.analogLeftY		= axes[1];
+	output.analogRightX		= axes[2];
+	output.analogRightY		= axes[3];
+	output.accelX			= axes[4];
+	output.accelY			= axes[5];
+	output.accelZ			= axes[6];
+	
+	start = WiiBench_Seconds();
+	for( index = 0; index < WII_BENCH_BATCH_PASSES; ++index )
+		WiiBatch_Decode( target, frames, WII_BENCH_BATCH_FRAMES, &output );
+	elapsed = WiiBench_Seconds() - start;
+	
+	printf( "  %-32s %8.1f Mframes/s  %6.2f ns/frame\n", name, (double)WII_BENCH_BATCH_FRAMES * WII_BENCH_BATCH_PASSES / elapsed / 1e6, elapsed * 1e9 / ((double)WII_BENCH_BATCH_FRAMES * WII_BENCH_BATCH_PASSES) );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Measures the cost of looking identifiers up in the driver registry.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		*ids				Identifiers cycled through.
+//!	@param[in]		count				Number of identifiers in 'ids'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Lookup( const char *name, const uint8_t (*ids)[WII_LIB_ID_LENGTH], uint32_t count )
+{
+	volatile uint32_t	found		= 0;
+	uint32_t			index;
+	uint64_t			cycles;
+	double				start;
+	double				elapsed;
+	
+	start	= WiiBench_Seconds();
+	cycles	= WiiBench_Cycles();
+	for( index = 0; index < WII_BENCH_LOOKUPS; ++index )
+		found += ( WiiDriver_FindById( &ids[index % count][0] ) != NULL );
+	cycles	= WiiBench_Cycles() - cycles;
+	elapsed	= WiiBench_Seconds() - start;
+	
+	printf( "  %-32s %8.1f ns/lookup  %6.0f cycles/lookup  %u of %u found\n", name, elapsed * 1e9 / (double)WII_BENCH_LOOKUPS, 
+			(double)cycles / (double)WII_BENCH_LOOKUPS, (unsigned)((uint64_t)found * count / WII_BENCH_LOOKUPS), (unsigned)count );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Measures the cost of a single 'WiiFusion_Update()' over a pool of random inputs.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		sources				Sources fused by every update ('WII_FUSION_SOURCE_*').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Fusion( const char *name, uint8_t sources )
+{
+	static WiiLib_Interface	inputs[WII_BENCH_FRAME_POOL];
+	WiiFusion_State		fusion;
+	volatile int32_t	sink		= 0;
+	uint32_t			index;
+	uint64_t			cycles;
+	double				start;
+	double				elapsed;
+	
+	// Level at rest with noise on every axis.
+	for( index = 0; index < WII_BENCH_FRAME_POOL; ++index )
+	{
+		memset( &inputs[index], 0, sizeof(WiiLib_Interface) );
+		inputs[index].accelX	= (int16_t)( WII_FUSION_ACCEL_ZERO + (int32_t)(WiiBench_Random() % 41) - 20 );
+		inputs[index].accelY	= (int16_t)( WII_FUSION_ACCEL_ZERO + (int32_t)(WiiBench_Random() % 41) - 20 );
+		inputs[index].accelZ	= (int16_t)( WII_FUSION_ACCEL_ZERO + 200 + (int32_t)(WiiBench_Random() % 41) - 20 );
+		inputs[index].gyroX		= (int16_t)( (int32_t)(WiiBench_Random() % 801) - 400 );
+		inputs[index].gyroY		= (int16_t)( (int32_t)(WiiBench_Random() % 801) - 400 );
+		inputs[index].gyroZ		= (int16_t)( (int32_t)(WiiBench_Random() % 801) - 400 );
+	}
+	
+	WiiFusion_Init( &fusion, 10000 );
+	
+	start	= WiiBench_Seconds();
+	cycles	= WiiBench_Cycles();
+	for( index = 0; index < WII_BENCH_FUSION_UPDATES; ++index )
+	{
+		WiiFusion_Update( &fusion, &inputs[index % WII_BENCH_FRAME_POOL], sources );
+		sink += fusion.pitch;
+	}
+	cycles	= WiiBench_Cycles() - cycles;
+	elapsed	= WiiBench_Seconds() - start;
+	
+	printf( "  %-32s %8.1f ns/update  %6.0f cycles/update\n", name, elapsed * 1e9 / (double)WII_BENCH_FUSION_UPDATES, (double)cycles / (double)WII_BENCH_FUSION_UPDATES );
+	(void)sink;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Measures the cost of a single 'WiiOutput_Process()' over a pool of random 
+//!					joystick positions.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		target				Target type the output stage is set up for.
+//!	@param[in]		mode				Shape of the deadzone.
+//!	@param[in]		curved				Flag indicating if a (quadratic) response curve is applied.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Output( const char *name, WII_LIB_TARGET_DEVICE target, WII_OUTPUT_DEADZONE mode, BOOL curved )
+{
+	static WiiLib_Interface	inputs[WII_BENCH_FRAME_POOL];
+	WiiLib_Device		device;
+	WiiOutput_Config	config;
+	WiiOutput_Axes		axes;
+	int16_t				curve[WII_OUTPUT_CURVE_POINTS];
+	volatile int32_t	sink		= 0;
+	uint32_t			index;
+	uint32_t			point;
+	uint64_t			cycles;
+	double				start;
+	double				elapsed;
+	
+	// Anywhere within the nominal travel of each joystick.
+	for( index = 0; index < WII_BENCH_FRAME_POOL; ++index )
+	{
+		memset( &inputs[index], 0, sizeof(WiiLib_Interface) );
+		inputs[index].analogLeftX	= (int16_t)( (int32_t)(WiiBench_Random() % 257) - 128 );
+		inputs[index].analogLeftY	= (int16_t)( (int32_t)(WiiBench_Random() % 257) - 128 );
+		inputs[index].analogRightX	= (int16_t)( (int32_t)(WiiBench_Random() % 33) - 16 );
+		inputs[index].analogRightY	= (int16_t)( (int32_t)(WiiBench_Random() % 33) - 16 );
+	}
+	
+	// Quadratic response curve (finer control near the center).
+	for( index = 0; index < WII_OUTPUT_CURVE_POINTS; ++index )
+	{
+		point			= (index << WII_OUTPUT_CURVE_STEP_BITS);
+		point			= (point * point) >> 15;
+		curve[index]	= (int16_t)( point < WII_OUTPUT_Q15_MAX ? point : WII_OUTPUT_Q15_MAX );
+	}
+	
+	memset( &device, 0, sizeof(WiiLib_Device) );
+	device.target = target;
+	WiiOutput_Init( &config, &device, mode, 3000, ( curved ? curve : NULL ) );
+	
+	start	= WiiBench_Seconds();
+	cycles	= WiiBench_Cycles();
+	for( index = 0; index < WII_BENCH_OUTPUT_FRAMES; ++index )
+	{
+		WiiOutput_Process( &config, &inputs[index % WII_BENCH_FRAME_POOL], &axes );
+		sink += axes.leftX + axes.rightY;
+	}
+	cycles	= WiiBench_Cycles() - cycles;
+	elapsed	= WiiBench_Seconds() - start;
+	
+	printf( "  %-32s %8.1f ns/frame   %6.0f cycles/frame\n", name, elapsed * 1e9 / (double)WII_BENCH_OUTPUT_FRAMES, (double)cycles / (double)WII_BENCH_OUTPUT_FRAMES );
+	(void)sink;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Measures modelled time per blocking status poll.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		target				Target type to simulate and poll.
+//!	@param[in]		report				Report profile used by the polls (see 'WiiLib_SetReport()').
+//!	@param[in]		configureEachPoll	Flag indicating if the target is reconfigured before every 
+//!										poll (behaviour of the library prior to removing the 
+//!										classic controller reconfiguration hack).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Poll( const char *name, WII_LIB_TARGET_DEVICE target, WII_LIB_REPORT report, BOOL configureEachPoll )
+{
+	static WiiLib_Device	device;
+	WiiSim_Stats		stats;
+	uint64_t			start;
+	uint32_t			polls;
+	uint32_t			frames		= 0;
+	double				perPoll;
+	
+	WiiSim_Reset();
+	WiiSim_AddExtension( I2C1, target );
+	
+	memset( &device, 0, sizeof(device) );
+	if( WiiLib_Init( I2C1, 80000000UL, target, TRUE, &device ) != WII_LIB_RC_SUCCESS || WiiLib_SetReport( &device, report ) != WII_LIB_RC_SUCCESS )
+	{
+		printf( "  %-32s init failed\n", name );
+		return;
+	}
+	
+	// The data format of the report (high-resolution) is written while configuring.
+	WiiLib_ConfigureDevice( &device );
+	
+	WiiSim_ClearStats();
+	start = WiiSim_NowUs64();
+	for( polls = 0; polls < WII_BENCH_POLLS; ++polls )
+	{
+		if( configureEachPoll )
+			WiiLib_ConfigureDevice( &device );
+		
+		if( WiiLib_PollStatus( &device ) == WII_LIB_RC_SUCCESS )
+			++frames;
+	}
+	WiiSim_GetStats( &stats );
+	
+	perPoll = (double)(WiiSim_NowUs64() - start) / (double)WII_BENCH_POLLS / 1000.0;
+	printf( "  %-32s %7.2f ms/poll  (bus %.2f ms, delay %.2f ms)  %6.1f Hz  %u/%u frames\n", 
+			name, perPoll, (double)stats.busUs / WII_BENCH_POLLS / 1000.0, (double)stats.delayUs / WII_BENCH_POLLS / 1000.0, 
+			1000.0 / perPoll, (unsigned)frames, (unsigned)WII_BENCH_POLLS );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Measures frames per second achieved by the non-blocking service.
+//!	
+//!	@details		Models a main loop that spends 'WII_BENCH_LOOP_US' on other work between calls 
+//!					to 'WiiLib_Service()'. Reports the share of the virtual time that the CPU was 
+//!					executing transfers (blocked inside the backend) and the number of I2C 
+//!					interrupts taken per frame.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		target				Target type to simulate and service.
+//!	@param[in]		queued				Flag indicating if transfers are routed through the interrupt 
+//!										driven transaction queue.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Service( const char *name, WII_LIB_TARGET_DEVICE target, BOOL queued )
+{
+	static WiiLib_Device	device;
+	static WiiAsync_Queue	queue;
+	WiiSim_Stats		stats;
+	uint64_t			start;
+	uint32_t			frames		= 0;
+	uint32_t			calls		= 0;
+	
+	WiiSim_Reset();
+	WiiSim_AddExtension( I2C1, target );
+	
+	memset( &device, 0, sizeof(device) );
+	if( WiiLib_InitNonBlocking( I2C1, 80000000UL, target, TRUE, &device ) != WII_LIB_RC_SUCCESS )
+	{
+		printf( "  %-32s init failed\n", name );
+		return;
+	}
+	
+	if( queued )
+	{
+		WiiAsync_Init( &queue );
+		WiiAsync_Attach( &queue, &device );
+		WiiSim_SetInterruptHandler( I2C1, WiiBench_Isr, &queue );
+	}
+	
+	// Let the device connect before measuring.
+	while( device.status != WII_LIB_DEVICE_STATUS_ACTIVE && WiiSim_NowUs64() < WII_BENCH_SERVICE_US )
+	{
+		WiiLib_Service( &device, WiiSim_NowUs() );
+		WiiSim_AdvanceUs( WII_BENCH_LOOP_US );
+	}
+	
+	WiiSim_ClearStats();
+	start = WiiSim_NowUs64();
+	while( WiiSim_NowUs64() - start < WII_BENCH_SERVICE_US )
+	{
+		if( WiiLib_Service( &device, WiiSim_NowUs() ) == WII_LIB_RC_SUCCESS )
+			++frames;
+		++calls;
+		WiiSim_AdvanceUs( WII_BENCH_LOOP_US );
+	}
+	WiiSim_GetStats( &stats );
+	
+	printf( "  %-32s %7.1f frames/s  cpu blocked %5.2f%%  delay slept %.0f us  %u calls  %.1f irq/frame\n", 
+			name, (double)frames * 1e6 / (double)(WiiSim_NowUs64() - start), 
+			100.0 * (double)stats.blockedUs / (double)(WiiSim_NowUs64() - start), (double)stats.delayUs, (unsigned)calls, 
+			( frames ? (double)stats.interrupts / (double)frames : 0.0 ) );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Measures aggregate frames per second per bus achieved by the scheduler.
+//!	
+//!	@details		Every bus carries a multiplexer at 'WII_BENCH_MUX_ADDR' with one nunchuck per 
+//!					channel. Rates are taken from 'WiiScheduler_GetFramesPerSecond()' after the 
+//!					devices connect and a full measurement window completes. The simulated targets 
+//!					never move, so in adaptive mode every device backs off to its maximum interval.
+//!	
+//!	@param[in]		buses				Number of buses (modules) used.
+//!	@param[in]		perBus				Number of targets per bus.
+//!	@param[in]		queued				Flag indicating if each bus uses an interrupt driven 
+//!										transaction queue.
+//!	@param[in]		mode				Pacing applied by the scheduler.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Scheduler( uint32_t buses, uint32_t perBus, BOOL queued, WII_SCHEDULER_MODE mode )
+{
+	static WiiLib_Device	devices[WII_BENCH_MAX_BUSES][WII_BENCH_MAX_PER_BUS];
+	static WiiAsync_Queue	queues[WII_BENCH_MAX_BUSES];
+	static WiiScheduler		scheduler;
+	WiiSim_Stats			stats;
+	WiiSim_Target			*mux;
+	WiiSim_Target			*target;
+	uint64_t				start;
+	uint32_t				bus;
+	uint32_t				index;
+	uint32_t				total		= 0;
+	uint32_t				active;
+	
+	WiiSim_Reset();
+	WiiScheduler_Init( &scheduler, WiiSim_NowUs );
+	WiiScheduler_SetMode( &scheduler, mode );
+	
+	for( bus = 0; bus < buses; ++bus )
+	{
+		mux = WiiSim_AddMux( (I2C_MODULE)bus, WII_BENCH_MUX_ADDR );
+		
+		if( queued )
+		{
+			WiiAsync_Init( &queues[bus] );
+			WiiSim_SetInterruptHandler( (I2C_MODULE)bus, WiiBench_Isr, &queues[bus] );
+		}
+		
+		for( index = 0; index < perBus; ++index )
+		{
+			WiiLib_Device	*device		= &devices[bus][index];
+			
+			target = WiiSim_AddExtension( (I2C_MODULE)bus, WII_LIB_TARGET_DEVICE_NUNCHUCK );
+			WiiSim_PlaceBehindMux( target, mux, (uint8_t)index );
+			
+			memset( device, 0, sizeof(WiiLib_Device) );
+			WiiLib_InitNonBlocking( (I2C_MODULE)bus, 80000000UL, WII_LIB_TARGET_DEVICE_NUNCHUCK, TRUE, device );
+			WiiScheduler_AddDevice( &scheduler, device, WII_BENCH_MUX_ADDR, (uint8_t)index );
+			if( queued )
+				WiiAsync_Attach( &queues[bus], device );
+		}
+	}
+	
+	// Let the devices connect before measuring.
+	do
+	{
+		WiiScheduler_Service( &scheduler );
+		WiiSim_AdvanceUs( WII_BENCH_LOOP_US );
+		
+		for( active = 0, bus = 0; bus < buses; ++bus )
+			for( index = 0; index < perBus; ++index )
+				active += ( devices[bus][index].status == WII_LIB_DEVICE_STATUS_ACTIVE );
+	} while( active < buses * perBus && WiiSim_NowUs64() < WII_BENCH_SERVICE_US );
+	
+	// Run a little over two windows so at least one full window is measured after connecting.
+	WiiSim_ClearStats();
+	start = WiiSim_NowUs64();
+	while( WiiSim_NowUs64() - start < (2 * WII_SCHEDULER_RATE_WINDOW_US) + WII_BENCH_LOOP_US )
+	{
+		WiiScheduler_Service( &scheduler );
+		WiiSim_AdvanceUs( WII_BENCH_LOOP_US );
+	}
+	WiiSim_GetStats( &stats );
+	
+	printf( "  %u bus x %u target%s%-18s%-11s", (unsigned)buses, (unsigned)perBus, ( perBus > 1 ? "s" : " " ), ( queued ? " (interrupt queue)" : "" ), 
+			( mode == WII_SCHEDULER_MODE_ADAPTIVE ? " (adaptive)" : "" ) );
+	for( bus = 0; bus < buses; ++bus )
+	{
+		printf( "  I2C%u %4u fps %3u%% saved", (unsigned)(bus + 1), (unsigned)WiiScheduler_GetFramesPerSecond( &scheduler, (I2C_MODULE)bus ), 
+				(unsigned)WiiScheduler_GetUtilizationSaved( &scheduler, (I2C_MODULE)bus ) );
+		total += WiiScheduler_GetFramesPerSecond( &scheduler, (I2C_MODULE)bus );
+	}
+	printf( "  total %4u fps  (%.1f per target)  cpu blocked %5.2f%%\n", (unsigned)total, (double)total / (double)(buses * perBus), 
+			100.0 * (double)stats.blockedUs / (double)(WiiSim_NowUs64() - start) );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reports the statistics recorded while servicing a target.
+//!	
+//!	@details		Runs the same loop as 'WiiBench_Service()' (blocking transfers) with a statistics 
+//!					block attached and prints the min/avg/max of every timer plus the results and 
+//!					frame verdicts recorded. The loop runs twice (the simulation is deterministic): 
+//!					once counting host CPU time and once counting modelled time (see 
+//!					'WiiSim_SetCounter()'). Each timer is reported for both counters: the CPU time 
+//!					spent in the library and the time the bus and delays would take on a target.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		target				Target type to simulate and service.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Stats( const char *name, WII_LIB_TARGET_DEVICE target )
+{
+	static const char		*timers[WII_STATS_TIMER_COUNT]	= { "bus", "delay", "decode" };
+	static const char		*counters[2]					= { "cpu", "modelled" };
+	static WiiLib_Device	device;
+	static WiiStats_Block	blocks[2];
+	WiiStats_Block			*stats							= &blocks[WII_SIM_COUNTER_CPU];
+	WiiStats_Timer			*timer;
+	uint8_t					index;
+	uint8_t					counter;
+	
+	for( counter = WII_SIM_COUNTER_CPU; counter <= WII_SIM_COUNTER_MODELLED; ++counter )
+	{
+		WiiSim_Reset();
+		WiiSim_SetCounter( (WII_SIM_COUNTER)counter );
+		WiiSim_AddExtension( I2C1, target );
+		
+		memset( &device, 0, sizeof(device) );
+		if( WiiLib_InitNonBlocking( I2C1, 80000000UL, target, TRUE, &device ) != WII_LIB_RC_SUCCESS )
+		{
+			printf( "  %-32s init failed\n", name );
+			return;
+		}
+		
+		WiiStats_Init( &blocks[counter] );
+		WiiStats_Attach( &blocks[counter], &device );
+		
+		while( WiiSim_NowUs64() < WII_BENCH_SERVICE_US )
+		{
+			WiiLib_Service( &device, WiiSim_NowUs() );
+			WiiSim_AdvanceUs( WII_BENCH_LOOP_US );
+		}
+	}
+	
+	printf( "  %-32s %u connect attempts  %u reconfigures  %u ok  %u i2c errors  %u invalid\n", name, 
+			(unsigned)stats->connectAttempts, (unsigned)stats->reconfigures, (unsigned)stats->results[WII_LIB_RC_SUCCESS], 
+			(unsigned)stats->results[WII_LIB_RC_I2C_ERROR], (unsigned)stats->results[WII_LIB_RC_DATA_RECEIVED_IS_INVALID] );
+	printf( "    %-30s %u valid  %u repeated  %u not ready  %u all zero  %u reserved\n", "frames", 
+			(unsigned)stats->frames[WII_LIB_FRAME_VALID], (unsigned)stats->frames[WII_LIB_FRAME_REPEATED], (unsigned)stats->frames[WII_LIB_FRAME_NOT_READY], 
+			(unsigned)stats->frames[WII_LIB_FRAME_ALL_ZERO], (unsigned)stats->frames[WII_LIB_FRAME_RESERVED] );
+	
+	for( index = 0; index < WII_STATS_TIMER_COUNT; ++index )
+	{
+		for( counter = WII_SIM_COUNTER_CPU; counter <= WII_SIM_COUNTER_MODELLED; ++counter )
+		{
+			timer = &blocks[counter].timers[index];
+			printf( "    %-6s %-23s %7u samples  min %9u  avg %9u  max %9u\n", timers[index], counters[counter], (unsigned)timer->count, 
+					(unsigned)( timer->count ? timer->minimum : 0 ), (unsigned)WiiStats_GetAverage( timer ), (unsigned)timer->maximum );
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Records polls of a simulated target and replays the capture.
+//!	
+//!	@details		The joystick of the target moves every 'WII_BENCH_CAPTURE_MOVE_EVERY' polls 
+//!					(other polls repeat the previous frame, as an idle controller would). The 
+//!					capture is written to a temporary file, replayed 'WII_BENCH_REPLAY_PASSES' times 
+//!					through a fresh device, and the final interface of the replay is compared with 
+//!					the one recorded.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		target				Target type to simulate and record.
+//!	
+//!	@returns		TRUE if the replay reproduced the interface recorded.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiBench_Capture( const char *name, WII_LIB_TARGET_DEVICE target )
+{
+	static WiiLib_Device		device;
+	static WiiCapture_Recorder	recorder;
+	char						path[]		= "/tmp/wii_bench_XXXXXX";
+	WiiLib_Interface			recorded;
+	WiiReplay_Log				log;
+	WiiSim_Target				*sim;
+	FILE						*file;
+	uint64_t					records		= 0;
+	uint32_t					polls;
+	uint8_t						stick;
+	int							fd;
+	double						start;
+	double						elapsed;
+	BOOL						matches;
+	
+	fd = mkstemp( path );
+	if( fd < 0 || !(file = fdopen( fd, "wb" )) )
+	{
+		printf( "  %-32s unable to create capture file\n", name );
+		return FALSE;
+	}
+	
+	// Record.
+	WiiSim_Reset();
+	sim = WiiSim_AddExtension( I2C1, target );
+	
+	memset( &device, 0, sizeof(device) );
+	if( WiiLib_Init( I2C1, 80000000UL, target, TRUE, &device ) != WII_LIB_RC_SUCCESS )
+	{
+		printf( "  %-32s init failed\n", name );
+		fclose( file );
+		unlink( path );
+		return FALSE;
+	}
+	
+	WiiCapture_Init( &recorder, WiiBench_Write, file, WiiSim_NowUs );
+	WiiCapture_Attach( &recorder, &device );
+	
+	for( polls = 0; polls < WII_BENCH_CAPTURE_POLLS; ++polls )
+	{
+		if( !(polls % WII_BENCH_CAPTURE_MOVE_EVERY) )
+		{
+			stick = (uint8_t)WiiBench_Random();
+			WiiSim_SetRegisters( sim, WII_LIB_PARAM_STATUS, &stick, 1 );
+		}
+		
+		WiiLib_PollStatus( &device );
+	}
+	
+	WiiCapture_Flush( &recorder );
+	fclose( file );
+	recorded = device.interfaceCurrent;
+	
+	// Replay.
+	if( !WiiReplay_Open( &log, path ) )
+	{
+		printf( "  %-32s unable to open capture\n", name );
+		unlink( path );
+		return FALSE;
+	}
+	
+	WiiSim_Reset();
+	sim = WiiSim_AddExtension( I2C1, log.target );
+	
+	memset( &device, 0, sizeof(device) );
+	WiiLib_Init( I2C1, 80000000UL, log.target, TRUE, &device );
+	
+	start = WiiBench_Seconds();
+	for( polls = 0; polls < WII_BENCH_REPLAY_PASSES; ++polls )
+	{
+		WiiReplay_Rewind( &log );
+		records += WiiReplay_Run( &log, sim, &device, WII_REPLAY_SPEED_MAX );
+	}
+	elapsed = WiiBench_Seconds() - start;
+	matches = !memcmp( &recorded, &device.interfaceCurrent, sizeof(recorded) );
+	
+	printf( "  %-32s %u records  %6.2f bytes/record  %6.2f Mrecords/s  %7.1f MB/s  %s\n", name, 
+			(unsigned)recorder.records, (double)log.size / recorder.records, (double)records / elapsed / 1e6, 
+			(double)log.size * WII_BENCH_REPLAY_PASSES / elapsed / 1e6, 
+			( matches ? "interface matches" : "MISMATCH" ) );
+	
+	WiiReplay_Close( &log );
+	unlink( path );
+	return matches;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Capture sink writing to a file.
+//!	
+//!	@param[in]		*context			File to write to.
+//!	@param[in]		*data				Part of the log to write.
+//!	@param[in]		len					Number of bytes to write.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Write( void *context, const uint8_t *data, uint32_t len )
+{
+	fwrite( data, 1, len, (FILE*)context );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Simulated I2C master interrupt handler.
+//!	
+//!	@param[in]		*context			Transaction queue serviced by the interrupt.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBench_Isr( void *context )
+{
+	WiiAsync_Isr( (WiiAsync_Queue*)context );
+}
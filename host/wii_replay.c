@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements the replay of captured traffic through the simulated I2C bus used by 
+//!					host builds of the "wii" library module.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "i2c.h"
+#include "wii_lib.h"
+#include "wii_sim.h"
+#include "wii_replay.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static BOOL				WiiReplay_GetVarint(		const uint8_t **in,		const uint8_t *end,		uint32_t *value		);
+static void				WiiReplay_Pace(				WiiReplay_Log *log,		uint64_t originUs							);
+
+
+
+
+//==================================================================================================
+// PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Maps a log into memory and checks its magic bytes and version.
+//!	
+//!	@details		On success 'log->target' holds the target type of the first record, so the 
+//!					matching simulated target can be created before replaying (it is kept by 
+//!					'WiiReplay_Rewind()').
+//!	
+//!	@param[out]		*log				Log to open.
+//!	@param[in]		*path				File written from the sink of a 'WiiCapture_Recorder{}'.
+//!	
+//!	@returns		TRUE if the log was opened (FALSE == missing, unreadable, or not a log).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL WiiReplay_Open( WiiReplay_Log *log, const char *path )
+{
+	struct stat		info;
+	void			*base;
+	
+	memset( log, 0, sizeof(WiiReplay_Log) );
+	log->fd		= open( path, O_RDONLY );
+	log->target	= WII_LIB_TARGET_DEVICE_UNKNOWN;
+	
+	if( log->fd < 0 )
+		return FALSE;
+	
+	if( fstat( log->fd, &info ) != 0 || info.st_size < WII_CAPTURE_MAGIC_LEN + 1 )
+	{
+		WiiReplay_Close( log );
+		return FALSE;
+	}
+	
+	base = mmap( NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, log->fd, 0 );
+	if( base == MAP_FAILED )
+	{
+		WiiReplay_Close( log );
+		return FALSE;
+	}
+	
+	log->base	= (const uint8_t *)base;
+	log->size	= (size_t)info.st_size;
+	log->first	= WII_CAPTURE_MAGIC_LEN + 1;
+	
+	// Records are only ever read front to back.
+	madvise( base, log->size, MADV_SEQUENTIAL );
+	
+	if( memcmp( log->base, WII_CAPTURE_MAGIC, WII_CAPTURE_MAGIC_LEN ) != 0 || log->base[WII_CAPTURE_MAGIC_LEN] != WII_CAPTURE_VERSION )
+	{
+		WiiReplay_Close( log );
+		return FALSE;
+	}
+	
+	// Peek at the first record for the target type.
+	WiiReplay_Rewind( log );
+	WiiReplay_Next( log );
+	WiiReplay_Rewind( log );
+	
+	return TRUE;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Unmaps and closes a log.
+//!	
+//!	@param[in]		*log				Log to close.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiReplay_Close( WiiReplay_Log *log )
+{
+	if( log->base )
+		munmap( (void *)log->base, log->size );
+	
+	if( log->fd >= 0 )
+		close( log->fd );
+	
+	log->base	= NULL;
+	log->size	= 0;
+	log->fd		= -1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Moves back to the first record of a log.
+//!	
+//!	@param[in]		*log				Log opened with 'WiiReplay_Open()'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiReplay_Rewind( WiiReplay_Log *log )
+{
+	log->offset		= log->first;
+	log->truncated	= FALSE;
+	log->records	= 0;
+	log->timeUs		= 0;
+	log->len		= 0;
+	memset( &log->frame[0], 0, sizeof(log->frame) );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Decodes the next record of a log.
+//!	
+//!	@param[in]		*log				Log opened with 'WiiReplay_Open()'.
+//!	
+//!	@returns		TRUE if a record was decoded (FALSE == end of the log, or 'log->truncated' set).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL WiiReplay_Next( WiiReplay_Log *log )
+{
+	const uint8_t		*in			= &log->base[log->offset];
+	const uint8_t		*end		= &log->base[log->size];
+	const uint8_t		*bitmap;
+	uint32_t			deltaUs;
+	uint32_t			bitmapLen;
+	uint32_t			index;
+	uint8_t				tag;
+	
+	if( in >= end || log->truncated )
+		return FALSE;
+	
+	tag = *in++;
+	if( !WiiReplay_GetVarint( &in, end, &deltaUs ) )
+		goto truncated;
+	
+	if( tag & WII_CAPTURE_TAG_HEADER )
+	{
+		if( end - in < 4 || in[3] == 0 || in[3] > WII_LIB_MAX_PAYLOAD_SIZE )
+			goto truncated;
+		
+		log->target	= (WII_LIB_TARGET_DEVICE)(int8_t)in[0];
+		log->param	= (WII_LIB_PARAM)in[1];
+		log->reg	= in[2];
+		log->len	= in[3];
+		in += 4;
+	}
+	else if( !log->len )
+	{
+		goto truncated;
+	}
+	
+	if( tag & WII_CAPTURE_TAG_RAW )
+	{
+		if( end - in < log->len )
+			goto truncated;
+		
+		memcpy( &log->frame[0], in, log->len );
+		in += log->len;
+	}
+	else
+	{
+		bitmapLen = ( (uint32_t)log->len + 7 ) >> 3;
+		if( (uint32_t)(end - in) < bitmapLen )
+			goto truncated;
+		
+		bitmap	= in;
+		in		+= bitmapLen;
+		
+		for( index = 0; index < log->len; ++index )
+		{
+			if( !(bitmap[index >> 3] & (1 << (index & 7))) )
+				continue;
+			
+			if( in >= end )
+				goto truncated;
+			
+			log->frame[index] = *in++;
+		}
+	}
+	
+	log->timeUs += deltaUs;
+	++log->records;
+	
+	log->offset = (size_t)( in - log->base );
+	return TRUE;
+	
+truncated:
+	log->truncated = TRUE;
+	return FALSE;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Replays every remaining record of a log through a device.
+//!	
+//!	@details		For each record the bytes are stored in the registers of the simulated target 
+//!					(starting at the register recorded) and the recorded parameter is queried with 
+//!					'WiiLib_QueryParameter()'. The target is marked as configured and its status 
+//!					frames are no longer interleaved (pass-through captures already alternate).
+//!	
+//!	@param[in]		*log				Log opened with 'WiiReplay_Open()'.
+//!	@param[in]		*target				Simulated target answering the device.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}' initialized against 'target'.
+//!	@param[in]		speed				Pace at which records are fed.
+//!	
+//!	@returns		Number of records replayed.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint64_t WiiReplay_Run( WiiReplay_Log *log, WiiSim_Target *target, WiiLib_Device *device, WII_REPLAY_SPEED speed )
+{
+	uint64_t		records		= 0;
+	uint64_t		originUs	= 0;
+	
+	target->interleave	= FALSE;
+	target->configured	= TRUE;
+	
+	while( WiiReplay_Next( log ) )
+	{
+		// Recorded times are kept relative to the first record fed by this call.
+		if( !records )
+			originUs = WiiSim_NowUs64() - log->timeUs;
+		
+		if( speed == WII_REPLAY_SPEED_RECORDED )
+			WiiReplay_Pace( log, originUs );
+		
+		WiiSim_SetRegisters( target, log->reg, &log->frame[0], log->len );
+		WiiLib_QueryParameter( device, log->param );
+		++records;
+	}
+	
+	return records;
+	
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reads a LEB128 value (seven bits per byte, least significant first).
+//!	
+//!	@param[in,out]	**in				Position to read from. Moved past the value.
+//!	@param[in]		*end				End of the log.
+//!	@param[out]		*value				Value read.
+//!	
+//!	@returns		TRUE if a complete value was read.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiReplay_GetVarint( const uint8_t **in, const uint8_t *end, uint32_t *value )
+{
+	const uint8_t		*next		= *in;
+	uint32_t			result		= 0;
+	uint32_t			shift;
+	
+	for( shift = 0; shift < 35 && next < end; shift += 7 )
+	{
+		result |= (uint32_t)( *next & 0x7F ) << shift;
+		if( !(*next++ & 0x80) )
+		{
+			*in		= next;
+			*value	= result;
+			return TRUE;
+		}
+	}
+	
+	return FALSE;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Advances the virtual clock to the time the current record was captured.
+//!	
+//!	@details		Never moves the clock back: records that fall behind (the replayed queries took 
+//!					longer than the originals) are fed straight away.
+//!	
+//!	@param[in]		*log				Log holding the current record.
+//!	@param[in]		originUs			Virtual time matching a record timestamp of zero.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiReplay_Pace( WiiReplay_Log *log, uint64_t originUs )
+{
+	uint64_t		dueUs		= originUs + log->timeUs;
+	uint64_t		nowUs;
+	
+	for( nowUs = WiiSim_NowUs64(); nowUs < dueUs; nowUs = WiiSim_NowUs64() )
+		WiiSim_AdvanceUs( (dueUs - nowUs > UINT32_MAX) ? UINT32_MAX : (uint32_t)(dueUs - nowUs) );
+}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines the replay of captured traffic (see "wii_capture.h") through the 
+//!					simulated I2C bus used by host builds of the "wii" library module.
+//!	
+//!	@details		The log is memory mapped and decoded in place, one record at a time, so 
+//!					captures of any size replay without being loaded. 'WiiReplay_Run()' stores the 
+//!					bytes of each record in the registers of a simulated target and queries the 
+//!					recorded parameter through the device, so the full library path (validation, 
+//!					decoding, events, etc.) runs over the capture. Replays run either at the 
+//!					recorded pace (the virtual clock is advanced to the time of each record) or as 
+//!					fast as the host CPU allows.
+//!	
+//!	@note			Records hold the bytes after decryption. Replay through a device initialized 
+//!					without encryption (or through a simulated target that does not encrypt) to 
+//!					read back exactly the bytes recorded.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_REPLAY__
+#define	__WII_REPLAY__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stddef.h>
+#include <stdint.h>
+#include "wii_lib.h"
+#include "wii_sim.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the pace at which records are replayed.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _WII_REPLAY_SPEED
+{
+	WII_REPLAY_SPEED_RECORDED						= 0,											//!< Virtual clock is advanced so each record is fed no earlier than it was recorded.
+	WII_REPLAY_SPEED_MAX							= 1												//!< Records are fed back to back (virtual clock only advances by the modelled bus time).
+} WII_REPLAY_SPEED;
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			State of a log being replayed.
+//!	
+//!	@details		After each successful 'WiiReplay_Next()' the members from 'target' down 
+//!					describe the record just decoded.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiReplay_Log
+{
+	int												fd;												//!< Descriptor of the log file (-1 == closed).
+	const uint8_t									*base;											//!< Start of the mapped log.
+	size_t											size;											//!< Size of the mapped log in bytes.
+	size_t											offset;											//!< Position of the next record.
+	size_t											first;											//!< Position of the first record (after the magic bytes and version).
+	uint8_t											truncated;										//!< Flag indicating decoding stopped at a malformed or incomplete record.
+	uint64_t										records;										//!< Number of records decoded since opened (or rewound).
+	uint64_t										timeUs;											//!< Timestamp of the current record (sum of the deltas recorded, so it does not wrap).
+	WII_LIB_TARGET_DEVICE							target;											//!< Target type the current record was read from.
+	WII_LIB_PARAM									param;											//!< Parameter queried.
+	uint8_t											reg;											//!< Register the response was read from.
+	uint8_t											len;											//!< Number of bytes in 'frame[]'.
+	uint8_t											frame[WII_LIB_MAX_PAYLOAD_SIZE];				//!< Bytes of the current record.
+} WiiReplay_Log;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+BOOL			WiiReplay_Open(			WiiReplay_Log *log,		const char *path															);
+void			WiiReplay_Close(		WiiReplay_Log *log																					);
+void			WiiReplay_Rewind(		WiiReplay_Log *log																					);
+BOOL			WiiReplay_Next(			WiiReplay_Log *log																					);
+uint64_t		WiiReplay_Run(			WiiReplay_Log *log,		WiiSim_Target *target,	WiiLib_Device *device,	WII_REPLAY_SPEED speed	);
+
+
+#endif	// __WII_REPLAY__
@@ -0,0 +1,931 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements the simulated I2C bus, simulated Wii targets, and virtual clock used 
+//!					by host builds of the "wii" library module.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+#include <time.h>
+#include "i2c.h"
+#include "wii_lib.h"
+#include "wii_sim.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static I2C_RC			WiiSim_Init(			I2C_Device *i2c,	uint32_t pbClk																);
+static I2C_RC			WiiSim_Transmit(		I2C_Device *i2c,	uint8_t *data,		uint32_t len,		BOOL sendStop							);
+static I2C_RC			WiiSim_Receive(			I2C_Device *i2c,	uint8_t *data,		uint32_t len,		BOOL sendStop							);
+static I2C_RC			WiiSim_TxRx(			I2C_Device *i2c,	uint8_t *dataOut,	uint32_t lenOut,	uint8_t *dataIn,	uint32_t lenIn,	BOOL sendStop,	BOOL repeatedStart	);
+static void				WiiSim_DelayMs(			uint32_t ms																						);
+static uint32_t			WiiSim_Cycles(			void																							);
+static WiiSim_Target *	WiiSim_FindTarget(		I2C_Device *i2c																					);
+static void				WiiSim_ChargeBus(		I2C_Device *i2c,	uint32_t len																);
+static void				WiiSim_Write(			WiiSim_Target *target,	uint8_t *data,	uint32_t len											);
+static void				WiiSim_WriteByte(		WiiSim_Target *target,	uint8_t data,	uint32_t index											);
+static void				WiiSim_SwapFrames(		WiiSim_Target *target																			);
+static void				WiiSim_WidenClassic(	WiiSim_Target *target																			);
+static void				WiiSim_Read(			WiiSim_Target *target,	uint8_t *data,	uint32_t len											);
+static uint8_t			WiiSim_ReadByte(		WiiSim_Target *target																			);
+static WiiSim_Target *	WiiSim_FindTargetAt(	I2C_MODULE module,	uint8_t addr																);
+static void				WiiSim_Raise(			I2C_Device *i2c,	uint32_t bits																);
+static void				WiiSim_BusStart(		I2C_Device *i2c																					);
+static void				WiiSim_BusStop(			I2C_Device *i2c																					);
+static void				WiiSim_BusWrite(		I2C_Device *i2c,	uint8_t data																);
+static void				WiiSim_BusReceive(		I2C_Device *i2c																					);
+static uint8_t			WiiSim_BusReadByte(		I2C_Device *i2c																					);
+static void				WiiSim_BusAck(			I2C_Device *i2c,	BOOL ack																	);
+static BOOL				WiiSim_BusAcked(		I2C_Device *i2c																					);
+
+
+
+
+//==================================================================================================
+//	PRIVATE TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			State of a simulated I2C module driven through the non-blocking primitives.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiSim_Bus
+{
+	WiiSim_Target									*target;										//!< Target addressed by the active transfer (NULL if none acknowledged).
+	uint8_t											addressNext;									//!< Flag indicating the next byte written is an address.
+	uint8_t											acked;											//!< Flag indicating the last byte written was acknowledged.
+	uint8_t											rx;												//!< Byte captured by the last receive.
+	uint32_t										count;											//!< Number of data bytes written during the active transfer.
+	uint8_t											interruptPending;								//!< Flag indicating a bus phase is in progress.
+	uint64_t										interruptDueUs;									//!< Virtual time at which the pending interrupt fires.
+	WiiSim_Isr										isr;											//!< Interrupt handler (NULL == interrupt disabled).
+	void											*context;										//!< Value passed to 'isr'.
+} WiiSim_Bus;
+
+
+
+
+//==================================================================================================
+//	PRIVATE VARIABLES
+//--------------------------------------------------------------------------------------------------
+static const WiiLib_BusOps	WiiSim_BusOps	=
+{
+	WiiSim_BusStart,
+	WiiSim_BusStop,
+	WiiSim_BusWrite,
+	WiiSim_BusReceive,
+	WiiSim_BusReadByte,
+	WiiSim_BusAck,
+	WiiSim_BusAcked
+};
+
+
+
+
+//==================================================================================================
+//	PUBLIC VARIABLES
+//--------------------------------------------------------------------------------------------------
+const WiiLib_Backend	WiiLib_BackendDefault	=
+{
+	WiiSim_Init,
+	WiiSim_Transmit,
+	WiiSim_Receive,
+	WiiSim_TxRx,
+	WiiSim_DelayMs,
+	&WiiSim_BusOps,
+	WiiSim_Cycles
+};
+
+
+
+
+//==================================================================================================
+//	PRIVATE VARIABLES
+//--------------------------------------------------------------------------------------------------
+static WiiSim_Bus		WiiSim_Buses[I2C_NUMBER_OF_MODULES];										//!< Simulated modules (non-blocking primitives).
+static WiiSim_Target	WiiSim_Targets[WII_SIM_MAX_TARGETS];										//!< Simulated targets.
+static uint32_t			WiiSim_TargetCount;															//!< Number of entries used in 'WiiSim_Targets[]'.
+static uint64_t			WiiSim_ClockUs;																//!< Virtual clock (us).
+static WiiSim_Stats		WiiSim_StatsCurrent;														//!< Accumulated bus activity.
+static WII_SIM_COUNTER	WiiSim_Counter;																//!< Time counted by 'WiiSim_Cycles()'.
+
+
+
+
+//==================================================================================================
+// PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Removes all simulated targets and resets the virtual clock and statistics (the 
+//!					statistics counter counts host CPU time again).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiSim_Reset( void )
+{
+	memset( &WiiSim_Targets[0], 0, sizeof(WiiSim_Targets) );
+	memset( &WiiSim_Buses[0], 0, sizeof(WiiSim_Buses) );
+	WiiSim_TargetCount	= 0;
+	WiiSim_ClockUs		= 0;
+	WiiSim_Counter		= WII_SIM_COUNTER_CPU;
+	WiiSim_ClearStats();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Attaches a new simulated target to the bus.
+//!	
+//!	@param[in]		module				Module (bus) the target is attached to.
+//!	@param[in]		addr				Address the target responds to.
+//!	@param[in]		*id					'WII_LIB_ID_LENGTH' byte identifier stored at 
+//!										'WII_LIB_PARAM_DEVICE_TYPE'.
+//!	
+//!	@returns		Pointer to the new target or NULL if no more targets are available.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WiiSim_Target * WiiSim_AddTarget( I2C_MODULE module, uint8_t addr, const uint8_t *id )
+{
+	WiiSim_Target		*target;
+	
+	if( WiiSim_TargetCount >= WII_SIM_MAX_TARGETS )
+		return NULL;
+	
+	target				= &WiiSim_Targets[ WiiSim_TargetCount++ ];
+	memset( target, 0, sizeof(WiiSim_Target) );
+	target->module		= module;
+	target->addr		= addr;
+	target->present		= TRUE;
+	WiiSim_SetRegisters( target, WII_LIB_PARAM_DEVICE_TYPE, id, WII_LIB_ID_LENGTH );
+	
+	return target;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Attaches a simulated Wii extension of the requested type to the bus.
+//!	
+//!	@details		Populates the identifier, a status frame with all controls at rest, and (for 
+//!					nunchucks and classic controllers) a calibration block matching the rest values.
+//!	
+//!	@param[in]		module				Module (bus) the target is attached to.
+//!	@param[in]		type				Type of extension to simulate.
+//!	
+//!	@returns		Pointer to the new target or NULL if the type is not supported or no more 
+//!					targets are available.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WiiSim_Target * WiiSim_AddExtension( I2C_MODULE module, WII_LIB_TARGET_DEVICE type )
+{
+	static const uint8_t	idNunchuck[]		= WII_LIB_ID_NUNCHUCK;
+	static const uint8_t	idClassic[]			= WII_LIB_ID_CLASSIC_CONTROLLER;
+	static const uint8_t	idMotionPlus[]		= { 0x00, 0x00, 0xA6, 0x20, 0x00, 0x05 };	// Inactive.
+	static const uint8_t	restNunchuck[]		= { 0x80, 0x80, 0x80, 0x80, 0x80, 0x03 };
+	static const uint8_t	restClassic[]		= { 0xA0, 0x20, 0x10, 0x00, 0xFF, 0xFF };
+	static const uint8_t	restMotionPlus[]	= { 0x00, 0x00, 0x00, 0x83, 0x82, 0x82 };
+	static const uint8_t	restMotionPlusExt[]	= { 0x00, 0x00, 0x00, 0x83, 0x83, 0x82 };		// Extension connected.
+	static const uint8_t	restPassNunchuck[]	= { 0x80, 0x80, 0x80, 0x80, 0x80, 0x0C };
+	static const uint8_t	restPassClassic[]	= { 0xA1, 0x21, 0x10, 0x00, 0xFF, 0xFC };
+	static const uint8_t	calNunchuck[]		= { 0x80, 0x80, 0x80, 0x00, 0xB4, 0xB3, 0xB2, 0x00, 0xE0, 0x20, 0x80, 0xE0, 0x20, 0x80, 0xEE, 0x43 };
+	static const uint8_t	calClassic[]		= { 0xFC, 0x04, 0x80, 0xFC, 0x04, 0x80, 0xF8, 0x08, 0x80, 0xF8, 0x08, 0x80, 0x00, 0x00, 0x55, 0xAA };
+	static const uint8_t	idGuitar[]			= WII_GUITAR_HERO_ID_GUITAR;
+	static const uint8_t	idDrums[]			= WII_GUITAR_HERO_ID_DRUMS;
+	static const uint8_t	idTurntable[]		= WII_GUITAR_HERO_ID_TURNTABLE;
+	static const uint8_t	restGuitar[]		= { 0x20, 0x20, 0x0F, 0x10, 0xFF, 0xFF };
+	static const uint8_t	restDrums[]			= { 0x20, 0x20, 0x7E, 0xE0, 0xFF, 0xFF };		// No hit.
+	static const uint8_t	restTurntable[]		= { 0x20, 0x20, 0x10, 0x00, 0xFE, 0xFF };		// Turntables still, fader centered.
+	WiiSim_Target			*target;
+	
+	switch( type )
+	{
+		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
+			target = WiiSim_AddTarget( module, WII_LIB_I2C_ADDR_STANDARD, &idNunchuck[0] );
+			if( target )
+			{
+				WiiSim_SetRegisters( target, WII_LIB_PARAM_STATUS, &restNunchuck[0], sizeof(restNunchuck) );
+				WiiSim_SetRegisters( target, WII_LIB_PARAM_RAW_DATA, &calNunchuck[0], sizeof(calNunchuck) );
+			}
+			return target;
+		
+		case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
+			target = WiiSim_AddTarget( module, WII_LIB_I2C_ADDR_STANDARD, &idClassic[0] );
+			if( target )
+			{
+				target->isClassic = TRUE;
+				WiiSim_SetRegisters( target, WII_LIB_PARAM_STATUS, &restClassic[0], sizeof(restClassic) );
+				WiiSim_SetRegisters( target, WII_LIB_PARAM_RAW_DATA, &calClassic[0], sizeof(calClassic) );
+			}
+			return target;
+		
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS:
+			target = WiiSim_AddTarget( module, WII_LIB_I2C_ADDR_WII_MOTION_PLUS, &idMotionPlus[0] );
+			if( target )
+			{
+				target->isMotionPlus = TRUE;
+				WiiSim_SetRegisters( target, WII_LIB_PARAM_STATUS, &restMotionPlus[0], sizeof(restMotionPlus) );
+			}
+			return target;
+		
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
+			target = WiiSim_AddTarget( module, WII_LIB_I2C_ADDR_WII_MOTION_PLUS, &idMotionPlus[0] );
+			if( target )
+			{
+				target->isMotionPlus = TRUE;
+				WiiSim_SetRegisters( target, WII_LIB_PARAM_STATUS, &restMotionPlusExt[0], sizeof(restMotionPlusExt) );
+				if( type == WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK )
+					memcpy( &target->frameOther[0], &restPassNunchuck[0], sizeof(target->frameOther) );
+				else
+					memcpy( &target->frameOther[0], &restPassClassic[0], sizeof(target->frameOther) );
+			}
+			return target;
+		
+		case WII_LIB_TARGET_DEVICE_GUITAR:
+			target = WiiSim_AddTarget( module, WII_LIB_I2C_ADDR_STANDARD, &idGuitar[0] );
+			if( target )
+				WiiSim_SetRegisters( target, WII_LIB_PARAM_STATUS, &restGuitar[0], sizeof(restGuitar) );
+			return target;
+		
+		case WII_LIB_TARGET_DEVICE_DRUMS:
+			target = WiiSim_AddTarget( module, WII_LIB_I2C_ADDR_STANDARD, &idDrums[0] );
+			if( target )
+				WiiSim_SetRegisters( target, WII_LIB_PARAM_STATUS, &restDrums[0], sizeof(restDrums) );
+			return target;
+		
+		case WII_LIB_TARGET_DEVICE_TURNTABLE:
+			target = WiiSim_AddTarget( module, WII_LIB_I2C_ADDR_STANDARD, &idTurntable[0] );
+			if( target )
+				WiiSim_SetRegisters( target, WII_LIB_PARAM_STATUS, &restTurntable[0], sizeof(restTurntable) );
+			return target;
+		
+		default:
+			return NULL;
+		
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Attaches a simulated TCA9548A style multiplexer to the bus (all channels closed).
+//!	
+//!	@param[in]		module				Module (bus) the multiplexer is attached to.
+//!	@param[in]		addr				Address the multiplexer responds to.
+//!	
+//!	@returns		Pointer to the new multiplexer or NULL if no more targets are available.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WiiSim_Target * WiiSim_AddMux( I2C_MODULE module, uint8_t addr )
+{
+	static const uint8_t	id[WII_LIB_ID_LENGTH]	= {0};
+	WiiSim_Target			*target;
+	
+	target = WiiSim_AddTarget( module, addr, &id[0] );
+	if( target )
+		target->isMux = TRUE;
+	
+	return target;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Wires a target to a channel of a simulated multiplexer.
+//!	
+//!	@param[in]		*target				Target to move behind the multiplexer.
+//!	@param[in]		*mux				Multiplexer (see 'WiiSim_AddMux()').
+//!	@param[in]		channel				Channel of the multiplexer the target is wired to.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiSim_PlaceBehindMux( WiiSim_Target *target, WiiSim_Target *mux, uint8_t channel )
+{
+	target->mux			= mux;
+	target->muxChannel	= channel;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Stores values in the register space of a simulated target.
+//!	
+//!	@param[in]		*target				Target to update.
+//!	@param[in]		reg					First register to write.
+//!	@param[in]		*data				Values to store (unencrypted).
+//!	@param[in]		len					Number of values to store. Wraps at the end of the register 
+//!										space.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiSim_SetRegisters( WiiSim_Target *target, uint8_t reg, const uint8_t *data, uint32_t len )
+{
+	for( ; len > 0; --len, ++data, ++reg )
+		target->registers[reg] = *data;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Returns the lower 32 bits of the virtual clock (format used by 
+//!					'WiiLib_Service()').
+//!	
+//!	@returns		Current virtual time in microseconds.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t WiiSim_NowUs( void )
+{
+	return (uint32_t)WiiSim_ClockUs;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Returns the full virtual clock.
+//!	
+//!	@returns		Current virtual time in microseconds.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint64_t WiiSim_NowUs64( void )
+{
+	return WiiSim_ClockUs;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Advances the virtual clock (e.g. to model time spent by the application).
+//!	
+//!	@details		Fires every simulated interrupt that comes due along the way (in time order). 
+//!					Handlers may kick off further bus phases which fire within the same call if 
+//!					they complete in time.
+//!	
+//!	@param[in]		us					Time to advance in microseconds.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiSim_AdvanceUs( uint32_t us )
+{
+	uint64_t		endUs		= WiiSim_ClockUs + us;
+	WiiSim_Bus		*next;
+	uint32_t		index;
+	
+	for(;;)
+	{
+		next = NULL;
+		for( index = 0; index < I2C_NUMBER_OF_MODULES; ++index )
+		{
+			WiiSim_Bus	*bus	= &WiiSim_Buses[index];
+			
+			if( bus->interruptPending && bus->isr && bus->interruptDueUs <= endUs && (!next || bus->interruptDueUs < next->interruptDueUs) )
+				next = bus;
+		}
+		
+		if( !next )
+			break;
+		
+		if( next->interruptDueUs > WiiSim_ClockUs )
+			WiiSim_ClockUs = next->interruptDueUs;
+		
+		next->interruptPending = FALSE;
+		++WiiSim_StatsCurrent.interrupts;
+		next->isr( next->context );
+	}
+	
+	WiiSim_ClockUs = endUs;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Registers the handler for the simulated I2C master interrupt of a module.
+//!	
+//!	@param[in]		module				Module whose interrupt is handled.
+//!	@param[in]		isr					Handler (NULL disables the interrupt).
+//!	@param[in]		*context			Value passed to the handler.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiSim_SetInterruptHandler( I2C_MODULE module, WiiSim_Isr isr, void *context )
+{
+	WiiSim_Buses[module].isr		= isr;
+	WiiSim_Buses[module].context	= context;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Copies out the accumulated bus activity.
+//!	
+//!	@param[out]		*stats				Destination for the statistics.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiSim_GetStats( WiiSim_Stats *stats )
+{
+	*stats = WiiSim_StatsCurrent;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Clears the accumulated bus activity.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiSim_ClearStats( void )
+{
+	memset( &WiiSim_StatsCurrent, 0, sizeof(WiiSim_Stats) );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Selects the time counted by the statistics counter of the backend.
+//!	
+//!	@details		Durations recorded while a counter is selected are only comparable with other 
+//!					durations of the same counter. Select it before attaching a statistics block.
+//!	
+//!	@param[in]		counter				Time to count.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiSim_SetCounter( WII_SIM_COUNTER counter )
+{
+	WiiSim_Counter = counter;
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Backend hook for initializing a port. Nothing to do in simulation.
+//!	
+//!	@param[in]		*i2c				I2C device whose port should be initialized.
+//!	@param[in]		pbClk				Current peripheral bus clock (unused).
+//!	
+//!	@returns		Always 'I2C_RC_SUCCESS'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static I2C_RC WiiSim_Init( I2C_Device *i2c, uint32_t pbClk )
+{
+	(void)i2c;
+	(void)pbClk;
+	return I2C_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Backend hook for writing to a target.
+//!	
+//!	@param[in]		*i2c				I2C device to write to.
+//!	@param[in]		*data				Data to write.
+//!	@param[in]		len					Number of bytes to write.
+//!	@param[in]		sendStop			Flag indicating if a stop condition follows (unused).
+//!	
+//!	@returns		'I2C_RC_SUCCESS' or 'I2C_RC_NO_ACK' if no target acknowledged its address.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static I2C_RC WiiSim_Transmit( I2C_Device *i2c, uint8_t *data, uint32_t len, BOOL sendStop )
+{
+	WiiSim_Target		*target		= WiiSim_FindTarget( i2c );
+	
+	(void)sendStop;
+	
+	if( !target )
+	{
+		WiiSim_ChargeBus( i2c, 0 );
+		++WiiSim_StatsCurrent.naks;
+		return I2C_RC_NO_ACK;
+	}
+	
+	WiiSim_ChargeBus( i2c, len );
+	WiiSim_Write( target, data, len );
+	WiiSim_DelayMs( i2c->delayAfterSend_Ms );
+	return I2C_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Backend hook for reading from a target.
+//!	
+//!	@param[in]		*i2c				I2C device to read from.
+//!	@param[out]		*data				Destination for data read.
+//!	@param[in]		len					Number of bytes to read.
+//!	@param[in]		sendStop			Flag indicating if a stop condition follows (unused).
+//!	
+//!	@returns		'I2C_RC_SUCCESS' or 'I2C_RC_NO_ACK' if no target acknowledged its address.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static I2C_RC WiiSim_Receive( I2C_Device *i2c, uint8_t *data, uint32_t len, BOOL sendStop )
+{
+	WiiSim_Target		*target		= WiiSim_FindTarget( i2c );
+	
+	(void)sendStop;
+	
+	if( !target )
+	{
+		WiiSim_ChargeBus( i2c, 0 );
+		++WiiSim_StatsCurrent.naks;
+		return I2C_RC_NO_ACK;
+	}
+	
+	WiiSim_ChargeBus( i2c, len );
+	WiiSim_Read( target, data, len );
+	WiiSim_DelayMs( i2c->delayAfterReceive_Ms );
+	return I2C_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Backend hook for writing to and then reading from a target.
+//!	
+//!	@param[in]		*i2c				I2C device to communicate with.
+//!	@param[in]		*dataOut			Data to write.
+//!	@param[in]		lenOut				Number of bytes to write.
+//!	@param[out]		*dataIn				Destination for data read.
+//!	@param[in]		lenIn				Number of bytes to read.
+//!	@param[in]		sendStop			Flag indicating if a stop condition follows (unused).
+//!	@param[in]		repeatedStart		Flag indicating if a repeated start is used (unused).
+//!	
+//!	@returns		'I2C_RC_SUCCESS' or 'I2C_RC_NO_ACK' if no target acknowledged its address.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static I2C_RC WiiSim_TxRx( I2C_Device *i2c, uint8_t *dataOut, uint32_t lenOut, uint8_t *dataIn, uint32_t lenIn, BOOL sendStop, BOOL repeatedStart )
+{
+	WiiSim_Target		*target		= WiiSim_FindTarget( i2c );
+	
+	(void)sendStop;
+	(void)repeatedStart;
+	
+	if( !target )
+	{
+		WiiSim_ChargeBus( i2c, 0 );
+		++WiiSim_StatsCurrent.naks;
+		return I2C_RC_NO_ACK;
+	}
+	
+	WiiSim_ChargeBus( i2c, lenOut );
+	WiiSim_Write( target, dataOut, lenOut );
+	WiiSim_DelayMs( i2c->delayBetweenTxRx_Ms );
+	WiiSim_ChargeBus( i2c, lenIn );
+	WiiSim_Read( target, dataIn, lenIn );
+	WiiSim_DelayMs( i2c->delayAfterReceive_Ms );
+	return I2C_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Backend hook for blocking delays. Advances the virtual clock.
+//!	
+//!	@param[in]		ms					Time to delay in milliseconds.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_DelayMs( uint32_t ms )
+{
+	WiiSim_StatsCurrent.delayUs		+= WII_LIB_MS_TO_US(ms);
+	WiiSim_AdvanceUs( WII_LIB_MS_TO_US(ms) );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Backend hook for the statistics cycle counter.
+//!	
+//!	@details		Counts nanoseconds of the time selected with 'WiiSim_SetCounter()': host CPU 
+//!					time ('clock_gettime()') or the bus and delay time modelled on the virtual clock.
+//!	
+//!	@returns		Current count (wraps).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint32_t WiiSim_Cycles( void )
+{
+	struct timespec		now;
+	
+	if( WiiSim_Counter == WII_SIM_COUNTER_MODELLED )
+		return (uint32_t)( WiiSim_ClockUs * 1000ULL );
+	
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return (uint32_t)( (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Locates the present target addressed by the provided I2C device.
+//!	
+//!	@param[in]		*i2c				I2C device being addressed.
+//!	
+//!	@returns		Pointer to the target or NULL if no target acknowledges the address.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WiiSim_Target * WiiSim_FindTarget( I2C_Device *i2c )
+{
+	return WiiSim_FindTargetAt( i2c->port.module, i2c->addr );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Locates the present target at the provided module and address.
+//!	
+//!	@param[in]		module				Module (bus) being addressed.
+//!	@param[in]		addr				Address being addressed.
+//!	
+//!	@returns		Pointer to the target or NULL if no target acknowledges the address.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WiiSim_Target * WiiSim_FindTargetAt( I2C_MODULE module, uint8_t addr )
+{
+	uint32_t			index;
+	
+	for( index = 0; index < WiiSim_TargetCount; ++index )
+	{
+		WiiSim_Target	*target		= &WiiSim_Targets[index];
+		
+		if( !target->present || target->module != module || target->addr != addr )
+			continue;
+		
+		if( target->mux && !(target->mux->muxChannels & (1 << target->muxChannel)) )
+			continue;
+		
+		return target;
+	}
+	
+	return NULL;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Advances the virtual clock by the time a single transfer occupies the bus.
+//!	
+//!	@details		Models a start bit, 9 bits (8 + ack) for the address and each data byte, and a 
+//!					stop bit at the port clock rate.
+//!	
+//!	@param[in]		*i2c				I2C device executing the transfer.
+//!	@param[in]		len					Number of data bytes in the transfer.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_ChargeBus( I2C_Device *i2c, uint32_t len )
+{
+	uint32_t		clkFreq		= ( i2c->port.clkFreq ? i2c->port.clkFreq : I2C_CLOCK_RATE_STANDARD );
+	uint64_t		bits		= 1 + (9 * (1 + len)) + 1;
+	uint64_t		us			= ( (bits * 1000000ULL) + clkFreq - 1 ) / clkFreq;
+	
+	WiiSim_StatsCurrent.busUs		+= us;
+	WiiSim_StatsCurrent.blockedUs	+= us;
+	WiiSim_StatsCurrent.bytes		+= len;
+	++WiiSim_StatsCurrent.transfers;
+	WiiSim_AdvanceUs( (uint32_t)us );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Applies a write to the register space of a target.
+//!	
+//!	@param[in]		*target				Target written to.
+//!	@param[in]		*data				Data written (first byte is the register pointer).
+//!	@param[in]		len					Number of bytes written.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_Write( WiiSim_Target *target, uint8_t *data, uint32_t len )
+{
+	uint32_t		index;
+	
+	for( index = 0; index < len; ++index )
+		WiiSim_WriteByte( target, data[index], index );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Applies a single byte of a write to the register space of a target.
+//!	
+//!	@param[in]		*target				Target written to.
+//!	@param[in]		data				Byte written.
+//!	@param[in]		index				Position of the byte within the write (zero == register 
+//!										pointer).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_WriteByte( WiiSim_Target *target, uint8_t data, uint32_t index )
+{
+	if( target->isMux )
+	{
+		target->muxChannels = data;
+		return;
+	}
+	
+	if( index == 0 )
+	{
+		target->pointer = data;
+		if( target->interleave && data == WII_LIB_PARAM_STATUS )
+			WiiSim_SwapFrames( target );
+		return;
+	}
+	
+	if( target->pointer == 0xF0 && data == 0x55 )
+	{
+		target->configured	= TRUE;
+		target->encrypted	= FALSE;
+	}
+	else if( target->pointer == 0x40 )
+	{
+		target->configured	= TRUE;
+		target->encrypted	= TRUE;
+	}
+	else if( target->pointer == 0xFE && target->isMotionPlus )
+	{
+		target->addr			= WII_LIB_I2C_ADDR_STANDARD;
+		target->registers[0xFC]	= 0xA4;
+		target->configured		= TRUE;
+		target->encrypted		= FALSE;
+		target->interleave		= ( data != WII_MOTION_PLUS_MODE_STANDALONE );
+	}
+	else if(	target->pointer == WII_CLASSIC_CONTROLLER_REG_DATA_FORMAT && target->isClassic && 
+				data == WII_CLASSIC_CONTROLLER_DATA_FORMAT_HIGH_RES && target->registers[target->pointer] != data )
+	{
+		WiiSim_WidenClassic( target );
+	}
+	
+	target->registers[ target->pointer++ ] = data;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Swaps the status registers of an interleaving target with its other frame.
+//!	
+//!	@param[in]		*target				Target to update.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_SwapFrames( WiiSim_Target *target )
+{
+	uint8_t			swap;
+	uint32_t		index;
+	
+	for( index = 0; index < sizeof(target->frameOther); ++index )
+	{
+		swap												= target->registers[WII_LIB_PARAM_STATUS + index];
+		target->registers[WII_LIB_PARAM_STATUS + index]	= target->frameOther[index];
+		target->frameOther[index]							= swap;
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Rewrites the status registers of a classic controller in the high-resolution 
+//!					data format.
+//!	
+//!	@details		Joysticks and triggers are scaled up to 8 bits and the buttons move to bytes 
+//!					6 - 7 (see 'WII_CLASSIC_CONTROLLER_FIELDS_HIGH_RES()').
+//!	
+//!	@param[in]		*target				Target to update.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_WidenClassic( WiiSim_Target *target )
+{
+	uint8_t			*frame		= &target->registers[WII_LIB_PARAM_STATUS];
+	uint8_t			wide[WII_CLASSIC_CONTROLLER_HIGH_RES_LEN];
+	
+	wide[0]	= (uint8_t)( (frame[0] & 0x3F) << 2 );
+	wide[1]	= (uint8_t)( (((frame[0] >> 6) << 3) | ((frame[1] >> 6) << 1) | (frame[2] >> 7)) << 3 );
+	wide[2]	= (uint8_t)( (frame[1] & 0x3F) << 2 );
+	wide[3]	= (uint8_t)( (frame[2] & 0x1F) << 3 );
+	wide[4]	= (uint8_t)( ((((frame[2] >> 5) & 0x03) << 3) | (frame[3] >> 5)) << 3 );
+	wide[5]	= (uint8_t)( (frame[3] & 0x1F) << 3 );
+	wide[6]	= frame[4];
+	wide[7]	= frame[5];
+	
+	memcpy( frame, &wide[0], sizeof(wide) );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reads from the register space of a target.
+//!	
+//!	@details		Unconfigured targets respond with 0xFF bytes ('not ready'). Encrypted targets 
+//!					apply the inverse of the transform used by the library to decrypt.
+//!	
+//!	@param[in]		*target				Target read from.
+//!	@param[out]		*data				Destination for data read.
+//!	@param[in]		len					Number of bytes to read.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_Read( WiiSim_Target *target, uint8_t *data, uint32_t len )
+{
+	for( ; len > 0; --len, ++data )
+		*data = WiiSim_ReadByte( target );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reads a single byte from the register space of a target.
+//!	
+//!	@param[in]		*target				Target read from.
+//!	
+//!	@returns		Byte read (as it would appear on the bus).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint8_t WiiSim_ReadByte( WiiSim_Target *target )
+{
+	uint8_t			data;
+	
+	if( target->isMux )
+		return target->muxChannels;
+	
+	if( !target->configured )
+		return 0xFF;
+	
+	data = target->registers[ target->pointer++ ];
+	if( target->encrypted )
+		data = (uint8_t)( (uint8_t)(data - 0x17) ^ 0x17 );
+	
+	return data;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Schedules the simulated interrupt for a bus phase of the provided length.
+//!	
+//!	@details		The bus is charged for the phase but the virtual clock is not advanced (the CPU 
+//!					is free while the phase completes).
+//!	
+//!	@param[in]		*i2c				I2C device executing the phase.
+//!	@param[in]		bits				Number of bit times the phase occupies the bus.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_Raise( I2C_Device *i2c, uint32_t bits )
+{
+	WiiSim_Bus		*bus		= &WiiSim_Buses[i2c->port.module];
+	uint32_t		clkFreq		= ( i2c->port.clkFreq ? i2c->port.clkFreq : I2C_CLOCK_RATE_STANDARD );
+	uint64_t		us			= ( ((uint64_t)bits * 1000000ULL) + clkFreq - 1 ) / clkFreq;
+	
+	WiiSim_StatsCurrent.busUs	+= us;
+	bus->interruptDueUs			= WiiSim_ClockUs + us;
+	bus->interruptPending		= TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Non-blocking primitive: start condition.
+//!	
+//!	@param[in]		*i2c				I2C device executing the transfer.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_BusStart( I2C_Device *i2c )
+{
+	WiiSim_Bus		*bus		= &WiiSim_Buses[i2c->port.module];
+	
+	bus->target			= NULL;
+	bus->addressNext	= TRUE;
+	bus->count			= 0;
+	++WiiSim_StatsCurrent.transfers;
+	WiiSim_Raise( i2c, 1 );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Non-blocking primitive: stop condition.
+//!	
+//!	@param[in]		*i2c				I2C device executing the transfer.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_BusStop( I2C_Device *i2c )
+{
+	WiiSim_Buses[i2c->port.module].target = NULL;
+	WiiSim_Raise( i2c, 1 );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Non-blocking primitive: send a single (address or data) byte.
+//!	
+//!	@param[in]		*i2c				I2C device executing the transfer.
+//!	@param[in]		data				Byte sent.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_BusWrite( I2C_Device *i2c, uint8_t data )
+{
+	WiiSim_Bus		*bus		= &WiiSim_Buses[i2c->port.module];
+	
+	if( bus->addressNext )
+	{
+		bus->addressNext	= FALSE;
+		bus->target			= WiiSim_FindTargetAt( i2c->port.module, (uint8_t)(data >> 1) );
+		bus->acked			= ( bus->target != NULL );
+		if( !bus->acked )
+			++WiiSim_StatsCurrent.naks;
+	}
+	else if( bus->target )
+	{
+		WiiSim_WriteByte( bus->target, data, bus->count++ );
+		++WiiSim_StatsCurrent.bytes;
+	}
+	
+	WiiSim_Raise( i2c, 9 );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Non-blocking primitive: receive a single byte.
+//!	
+//!	@param[in]		*i2c				I2C device executing the transfer.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_BusReceive( I2C_Device *i2c )
+{
+	WiiSim_Bus		*bus		= &WiiSim_Buses[i2c->port.module];
+	
+	bus->rx = ( bus->target ? WiiSim_ReadByte( bus->target ) : 0xFF );
+	++WiiSim_StatsCurrent.bytes;
+	WiiSim_Raise( i2c, 8 );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Non-blocking primitive: byte captured by the last receive.
+//!	
+//!	@param[in]		*i2c				I2C device executing the transfer.
+//!	
+//!	@returns		Byte received.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint8_t WiiSim_BusReadByte( I2C_Device *i2c )
+{
+	return WiiSim_Buses[i2c->port.module].rx;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Non-blocking primitive: ack or nack the byte received.
+//!	
+//!	@param[in]		*i2c				I2C device executing the transfer.
+//!	@param[in]		ack					TRUE to ack or FALSE to nack (unused).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiSim_BusAck( I2C_Device *i2c, BOOL ack )
+{
+	(void)ack;
+	WiiSim_Raise( i2c, 1 );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Non-blocking primitive: reports if the last byte written was acknowledged.
+//!	
+//!	@param[in]		*i2c				I2C device executing the transfer.
+//!	
+//!	@returns		TRUE if acknowledged.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiSim_BusAcked( I2C_Device *i2c )
+{
+	return WiiSim_Buses[i2c->port.module].acked;
+}
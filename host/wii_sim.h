@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines the simulated I2C bus, simulated Wii targets, and virtual clock used by 
+//!					host builds of the "wii" library module.
+//!	
+//!	@details		Linking "wii_sim.c" provides 'WiiLib_BackendDefault'. Every transfer advances 
+//!					the virtual clock by the time the transfer would occupy a real bus (start, 
+//!					address, data + ack bits, and stop at the port clock rate) and every delay 
+//!					advances it by the requested time. No real time passes.
+//!	
+//!					The non-blocking bus primitives ('WiiLib_BusOps') are also simulated. Each 
+//!					primitive schedules a simulated I2C master interrupt for when the bus phase 
+//!					would complete. Interrupts fire (invoking the handler registered with 
+//!					'WiiSim_SetInterruptHandler()') as the virtual clock advances past them.
+//!	
+//!					The statistics counter of the backend counts either host CPU time or modelled 
+//!					time, never a sum of both (see 'WiiSim_SetCounter()').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_SIM__
+#define	__WII_SIM__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_SIM_MAX_TARGETS							16												//!< Maximum number of simulated targets across all modules.
+#define	WII_SIM_REGISTER_COUNT						256												//!< Size of the register space of a simulated target.
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the time counted by the statistics counter of the simulated backend 
+//!					('WiiLib_Backend{}.cycles', see 'WiiSim_SetCounter()').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _WII_SIM_COUNTER
+{
+	WII_SIM_COUNTER_CPU								= 0,											//!< Host CPU time measured with 'clock_gettime()' (ns). The virtual clock is ignored.
+	WII_SIM_COUNTER_MODELLED						= 1												//!< Modelled time on the virtual clock (ns). Host CPU time is ignored.
+} WII_SIM_COUNTER;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			State of a single simulated target on the bus.
+//!	
+//!	@details		Behaves like a Wii extension:
+//!						-	Writing one byte sets the register pointer.
+//!						-	Writing more bytes stores them starting at the register pointer.
+//!						-	Reads return registers starting at the register pointer (auto 
+//!							increments) or 0xFF bytes until the target has been configured.
+//!						-	Writing 0x55 to 0xF0 disables encryption. Writing 0x40 enables it.
+//!	
+//!					Targets created as a Wii Motion Plus start at 'WII_LIB_I2C_ADDR_WII_MOTION_PLUS' 
+//!					with the inactive identifier. Writing the mode to 0xFE activates them: they move 
+//!					to 'WII_LIB_I2C_ADDR_STANDARD' and report the mode in their identifier. In a 
+//!					pass-through mode every write of the status register pointer swaps the status 
+//!					registers with 'frameOther' so status reads alternate between gyroscope and 
+//!					extension frames.
+//!	
+//!					Targets created as a classic controller switch to the high-resolution data 
+//!					format when 0x03 is written to 0xFE: the status registers are rewritten in that 
+//!					layout (and the identifier reports it). Frames stored afterwards must use it.
+//!	
+//!					Targets created with 'WiiSim_AddMux()' behave like a TCA9548A instead: every 
+//!					byte written replaces the channel mask and reads return it. Targets placed 
+//!					behind a multiplexer ('WiiSim_PlaceBehindMux()') only answer while their channel 
+//!					is open.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiSim_Target
+{
+	I2C_MODULE										module;											//!< Module (bus) the target is attached to.
+	uint8_t											addr;											//!< Address the target responds to.
+	uint8_t											present;										//!< Flag indicating if the target acknowledges its address (plugged in).
+	uint8_t											isMux;											//!< Flag indicating if the target is a multiplexer.
+	uint8_t											isMotionPlus;									//!< Flag indicating if the target is a Wii Motion Plus.
+	uint8_t											isClassic;										//!< Flag indicating if the target is a classic controller.
+	uint8_t											interleave;										//!< Flag indicating if status reads alternate with 'frameOther' (Wii Motion Plus pass-through).
+	uint8_t											frameOther[WII_LIB_PARAM_RESPONSE_LEN_DEFAULT];	//!< Status frame returned by the next status read when interleaving.
+	uint8_t											muxChannels;									//!< Open channel mask (multiplexers only).
+	struct _WiiSim_Target							*mux;											//!< Multiplexer the target sits behind (NULL == wired directly).
+	uint8_t											muxChannel;										//!< Channel of 'mux' the target is wired to.
+	uint8_t											configured;										//!< Flag indicating if the target has received a configuration message.
+	uint8_t											encrypted;										//!< Flag indicating if data read from the target is encrypted.
+	uint8_t											pointer;										//!< Register pointer.
+	uint8_t											registers[WII_SIM_REGISTER_COUNT];				//!< Register space of the target.
+} WiiSim_Target;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Accumulated bus activity across all simulated modules.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiSim_Stats
+{
+	uint64_t										busUs;											//!< Modelled time (us) the bus was occupied by transfers.
+	uint64_t										blockedUs;										//!< Portion of 'busUs' the CPU spent blocked inside blocking transfers.
+	uint64_t										delayUs;										//!< Time (us) spent in blocking delays.
+	uint32_t										transfers;										//!< Number of transfers (each start condition) executed.
+	uint32_t										bytes;											//!< Number of data bytes moved (excluding addresses).
+	uint32_t										naks;											//!< Number of transfers not acknowledged by a target.
+	uint32_t										interrupts;										//!< Number of simulated I2C master interrupts fired.
+} WiiSim_Stats;
+
+
+typedef void (*WiiSim_Isr)( void *context );														//!< Simulated I2C master interrupt handler.
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+void			WiiSim_Reset(				void																		);
+WiiSim_Target *	WiiSim_AddTarget(			I2C_MODULE module,		uint8_t addr,		const uint8_t *id				);
+WiiSim_Target *	WiiSim_AddExtension(		I2C_MODULE module,		WII_LIB_TARGET_DEVICE type							);
+WiiSim_Target *	WiiSim_AddMux(				I2C_MODULE module,		uint8_t addr										);
+void			WiiSim_PlaceBehindMux(		WiiSim_Target *target,	WiiSim_Target *mux,	uint8_t channel					);
+void			WiiSim_SetRegisters(		WiiSim_Target *target,	uint8_t reg,		const uint8_t *data,	uint32_t len	);
+uint32_t		WiiSim_NowUs(				void																		);
+uint64_t		WiiSim_NowUs64(				void																		);
+void			WiiSim_AdvanceUs(			uint32_t us																	);
+void			WiiSim_SetInterruptHandler(	I2C_MODULE module,		WiiSim_Isr isr,		void *context					);
+void			WiiSim_GetStats(			WiiSim_Stats *stats															);
+void			WiiSim_ClearStats(			void																		);
+void			WiiSim_SetCounter(			WII_SIM_COUNTER counter														);
+
+
+#endif	// __WII_SIM__
@@ -0,0 +1,474 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Host checks for the "wii" library module.
+//!	
+//!	@details		Checks:
+//!						-	Status decoders ('WII_LIB_DECODE_FIELD' tables) match a reference 
+//!							decoder written with plain shifts over random frames.
+//!						-	'WiiBatch_Decode()' matches the per-frame decoders over a large capture 
+//!							of random frames.
+//!						-	Replaying a capture ("wii_capture.h") through the simulated bus 
+//!							("wii_replay.h") reproduces the interface recorded.
+//!	
+//!	@returns		Exit code zero when every check passes (non-zero otherwise).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "wii_lib.h"
+#include "wii_sim.h"
+#include "wii_replay.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_TEST_DECODE_FRAMES						200000UL										//!< Number of random frames decoded per target by the decoder check.
+#define	WII_TEST_BATCH_FRAMES						((1UL << 18) + 37)								//!< Number of random frames batch decoded per target (ends on a partial block).
+#define	WII_TEST_CAPTURE_POLLS						20000UL											//!< Number of blocking polls recorded by the replay check.
+#define	WII_TEST_CAPTURE_MOVE_EVERY					8												//!< Polls between joystick movements while recording.
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static uint32_t		WiiTest_Random(				void																					);
+static BOOL			WiiTest_Decode(				const char *name,				WII_LIB_TARGET_DEVICE target							);
+static BOOL			WiiTest_Batch(				const char *name,				WII_LIB_TARGET_DEVICE target							);
+static void			WiiTest_ProcessStatus(		WiiLib_Device *device																	);
+static BOOL			WiiTest_Replay(				const char *name,				WII_LIB_TARGET_DEVICE target							);
+static void			WiiTest_Write(				void *context,					const uint8_t *data,	uint32_t len					);
+static void			WiiTest_Reference(			WII_LIB_TARGET_DEVICE target,	const uint8_t *data,	WiiLib_Interface *iface			);
+static BOOL			WiiTest_Report(				const char *name,				uint32_t checked,		uint32_t failures				);
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Runs all checks and prints the results.
+//!	
+//!	@returns		Zero when every check passes.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int main( void )
+{
+	uint32_t		failed		= 0;
+	
+	printf( "== decoder tables vs reference decoder (%lu random frames per target) ==\n", (unsigned long)WII_TEST_DECODE_FRAMES );
+	failed += !WiiTest_Decode( "nunchuck",				WII_LIB_TARGET_DEVICE_NUNCHUCK						);
+	failed += !WiiTest_Decode( "nunchuck pass-through",	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK		);
+	failed += !WiiTest_Decode( "classic",				WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER			);
+	failed += !WiiTest_Decode( "classic pass-through",	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC		);
+	failed += !WiiTest_Decode( "guitar",				WII_LIB_TARGET_DEVICE_GUITAR						);
+	failed += !WiiTest_Decode( "drums",					WII_LIB_TARGET_DEVICE_DRUMS							);
+	failed += !WiiTest_Decode( "turntable",				WII_LIB_TARGET_DEVICE_TURNTABLE						);
+	
+	printf( "\n== batch decoder vs per-frame decoders (%lu random frames per target) ==\n", (unsigned long)WII_TEST_BATCH_FRAMES );
+	failed += !WiiTest_Batch( "nunchuck",				WII_LIB_TARGET_DEVICE_NUNCHUCK						);
+	failed += !WiiTest_Batch( "nunchuck pass-through",	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK		);
+	failed += !WiiTest_Batch( "classic",				WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER			);
+	failed += !WiiTest_Batch( "classic pass-through",	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC		);
+	
+	printf( "\n== capture replay (%lu blocking polls recorded) ==\n", (unsigned long)WII_TEST_CAPTURE_POLLS );
+	failed += !WiiTest_Replay( "nunchuck",				WII_LIB_TARGET_DEVICE_NUNCHUCK						);
+	failed += !WiiTest_Replay( "classic",				WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER			);
+	
+	printf( "\n%s (%u check%s failed)\n", ( failed ? "FAILED" : "PASSED" ), (unsigned)failed, ( failed == 1 ? "" : "s" ) );
+	return ( failed ? 1 : 0 );
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Small deterministic pseudo-random generator (xorshift32).
+//!	
+//!	@returns		Next pseudo-random value.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint32_t WiiTest_Random( void )
+{
+	static uint32_t		state		= 0x12345678;
+	
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Decodes random frames with the status processing function of a target and with 
+//!					'WiiTest_Reference()' and compares the resulting interfaces.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		target				Target type to decode as.
+//!	
+//!	@returns		TRUE if every frame decoded the same.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiTest_Decode( const char *name, WII_LIB_TARGET_DEVICE target )
+{
+	static WiiLib_Device	device;
+	WiiLib_Interface		expected;
+	uint32_t				frame;
+	uint32_t				index;
+	uint32_t				failures	= 0;
+	
+	for( frame = 0; frame < WII_TEST_DECODE_FRAMES; ++frame )
+	{
+		memset( &device, 0, sizeof(device) );
+		memset( &expected, 0, sizeof(expected) );
+		device.target = target;
+		
+		for( index = 0; index < WII_LIB_PARAM_RESPONSE_LEN_DEFAULT; ++index )
+			device.dataCurrent[index] = (uint8_t)WiiTest_Random();
+		
+		WiiTest_ProcessStatus( &device );
+		WiiTest_Reference( target, &device.dataCurrent[0], &expected );
+		if( memcmp( &expected, &device.interfaceCurrent, sizeof(expected) ) && ++failures == 1 )
+		{
+			printf( "  %-32s first mismatch on frame %02X %02X %02X %02X %02X %02X\n", name, device.dataCurrent[0], device.dataCurrent[1],
+					device.dataCurrent[2], device.dataCurrent[3], device.dataCurrent[4], device.dataCurrent[5] );
+		}
+	}
+	
+	return WiiTest_Report( name, WII_TEST_DECODE_FRAMES, failures );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Decodes a capture of random frames with 'WiiBatch_Decode()' and compares every 
+//!					output with the interface produced by the per-frame decoder of the target.
+//!	
+//!	@details		Outputs the target does not report are left untouched by the batch decoder and 
+//!					by the per-frame decoder, so they compare as zero.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		target				Target type to decode as.
+//!	
+//!	@returns		TRUE if every frame decoded the same.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiTest_Batch( const char *name, WII_LIB_TARGET_DEVICE target )
+{
+	static uint8_t			frames[WII_TEST_BATCH_FRAMES * WII_BATCH_FRAME_LEN];
+	static uint32_t			buttons[WII_TEST_BATCH_FRAMES];
+	static int8_t			triggers[2][WII_TEST_BATCH_FRAMES];
+	static int16_t			axes[7][WII_TEST_BATCH_FRAMES];
+	static WiiLib_Device	device;
+	WiiLib_Interface		*current	= &device.interfaceCurrent;
+	WiiBatch_Output			output;
+	uint32_t				frame;
+	uint32_t				failures	= 0;
+	
+	for( frame = 0; frame < sizeof(frames); ++frame )
+		frames[frame] = (uint8_t)WiiTest_Random();
+	
+	memset( buttons, 0, sizeof(buttons) );
+	memset( triggers, 0, sizeof(triggers) );
+	memset( axes, 0, sizeof(axes) );
+	
+	output.buttons			= buttons;
+	output.triggerLeft		= triggers[0];
+	output.triggerRight		= triggers[1];
+	output.analogLeftX		= axes[0];
+	output.analogLeftY		= axes[1];
+	output.analogRightX		= axes[2];
+	output.analogRightY		= axes[3];
+	output.accelX			= axes[4];
+	output.accelY			= axes[5];
+	output.accelZ			= axes[6];
+	
+	if( WiiBatch_Decode( target, frames, WII_TEST_BATCH_FRAMES, &output ) != WII_LIB_RC_SUCCESS )
+		return WiiTest_Report( name, 0, 1 );
+	
+	for( frame = 0; frame < WII_TEST_BATCH_FRAMES; ++frame )
+	{
+		memset( &device, 0, sizeof(device) );
+		device.target = target;
+		memcpy( &device.dataCurrent[0], &frames[frame * WII_BATCH_FRAME_LEN], WII_BATCH_FRAME_LEN );
+		WiiTest_ProcessStatus( &device );
+		
+		if( buttons[frame] != current->buttons || triggers[0][frame] != current->triggerLeft || triggers[1][frame] != current->triggerRight || 
+			axes[0][frame] != current->analogLeftX || axes[1][frame] != current->analogLeftY || axes[2][frame] != current->analogRightX || 
+			axes[3][frame] != current->analogRightY || axes[4][frame] != current->accelX || axes[5][frame] != current->accelY || 
+			axes[6][frame] != current->accelZ )
+		{
+			if( ++failures == 1 )
+				printf( "  %-32s first mismatch on frame %u\n", name, (unsigned)frame );
+		}
+	}
+	
+	return WiiTest_Report( name, WII_TEST_BATCH_FRAMES, failures );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Decodes 'device->dataCurrent' with the per-frame decoder of the target.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}' ('target' set).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiTest_ProcessStatus( WiiLib_Device *device )
+{
+	switch( device->target )
+	{
+		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
+			WiiNunchuck_ProcessStatusParam( device );
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_GUITAR:
+			WiiGuitarHero_ProcessGuitar( device );
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_DRUMS:
+			WiiGuitarHero_ProcessDrums( device );
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_TURNTABLE:
+			WiiGuitarHero_ProcessTurntable( device );
+			break;
+		
+		default:
+			WiiClassic_ProcessStatusParam( device );
+			break;
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Records polls of a simulated target, replays the capture through a fresh device, 
+//!					and compares the final interfaces.
+//!	
+//!	@details		The joystick of the target moves every 'WII_TEST_CAPTURE_MOVE_EVERY' polls (other 
+//!					polls repeat the previous frame) so the log holds both full and empty records.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		target				Target type to simulate and record.
+//!	
+//!	@returns		TRUE if the replay reproduced the interface recorded.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiTest_Replay( const char *name, WII_LIB_TARGET_DEVICE target )
+{
+	static WiiLib_Device		device;
+	static WiiCapture_Recorder	recorder;
+	char						path[]		= "/tmp/wii_test_XXXXXX";
+	WiiLib_Interface			recorded;
+	WiiReplay_Log				log;
+	WiiSim_Target				*sim;
+	FILE						*file;
+	uint64_t					records;
+	uint32_t					polls;
+	uint8_t						stick;
+	int							fd;
+	BOOL						matches;
+	
+	fd = mkstemp( path );
+	if( fd < 0 || !(file = fdopen( fd, "wb" )) )
+		return WiiTest_Report( name, 0, 1 );
+	
+	// Record.
+	WiiSim_Reset();
+	sim = WiiSim_AddExtension( I2C1, target );
+	
+	memset( &device, 0, sizeof(device) );
+	if( WiiLib_Init( I2C1, 80000000UL, target, TRUE, &device ) != WII_LIB_RC_SUCCESS )
+	{
+		fclose( file );
+		unlink( path );
+		return WiiTest_Report( name, 0, 1 );
+	}
+	
+	WiiCapture_Init( &recorder, WiiTest_Write, file, WiiSim_NowUs );
+	WiiCapture_Attach( &recorder, &device );
+	
+	for( polls = 0; polls < WII_TEST_CAPTURE_POLLS; ++polls )
+	{
+		if( !(polls % WII_TEST_CAPTURE_MOVE_EVERY) )
+		{
+			stick = (uint8_t)WiiTest_Random();
+			WiiSim_SetRegisters( sim, WII_LIB_PARAM_STATUS, &stick, 1 );
+		}
+		
+		WiiLib_PollStatus( &device );
+	}
+	
+	WiiCapture_Flush( &recorder );
+	fclose( file );
+	recorded = device.interfaceCurrent;
+	
+	// Replay.
+	if( !WiiReplay_Open( &log, path ) )
+	{
+		unlink( path );
+		return WiiTest_Report( name, 0, 1 );
+	}
+	
+	WiiSim_Reset();
+	sim = WiiSim_AddExtension( I2C1, log.target );
+	
+	memset( &device, 0, sizeof(device) );
+	WiiLib_Init( I2C1, 80000000UL, log.target, TRUE, &device );
+	
+	records = WiiReplay_Run( &log, sim, &device, WII_REPLAY_SPEED_MAX );
+	matches = ( records == recorder.records && !memcmp( &recorded, &device.interfaceCurrent, sizeof(recorded) ) );
+	
+	WiiReplay_Close( &log );
+	unlink( path );
+	return WiiTest_Report( name, (uint32_t)records, !matches );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Capture sink writing to a file.
+//!	
+//!	@param[in]		*context			File to write to.
+//!	@param[in]		*data				Part of the log to write.
+//!	@param[in]		len					Number of bytes to write.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiTest_Write( void *context, const uint8_t *data, uint32_t len )
+{
+	fwrite( data, 1, len, (FILE*)context );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reference status decoder (plain shifts and masks per byte).
+//!	
+//!	@details		Follows the layout of the bitfield overlays the table decoders replaced, 
+//!					including the fixes made along with them (pass-through nunchuck z-axis 
+//!					accelerometer and pass-through classic controller left joystick). Guitar Hero 
+//!					and DJ Hero targets follow the mapping documented in "wii_guitar_hero.h".
+//!	
+//!	@param[in]		target				Target type to decode as.
+//!	@param[in]		*data				Status frame ('WII_LIB_PARAM_RESPONSE_LEN_DEFAULT' bytes).
+//!	@param[out]		*iface				Destination for the values decoded (other values untouched).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiTest_Reference( WII_LIB_TARGET_DEVICE target, const uint8_t *data, WiiLib_Interface *iface )
+{
+	uint32_t		pressed;
+	int32_t			speed;
+	
+	switch( target )
+	{
+		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
+			// Byte 6: Z and C (active low) at bits 0 - 1, or bits 2 - 3 when passed through.
+			pressed					= (uint32_t)~data[5] >> ( target == WII_LIB_TARGET_DEVICE_NUNCHUCK ? 0 : 2 );
+			iface->buttons			= ( ((pressed >> 1) & 0x01) * WII_LIB_BUTTON_C ) | ( (pressed & 0x01) * (WII_LIB_BUTTON_ZL | WII_LIB_BUTTON_ZR) );
+			iface->analogLeftX		= data[0];
+			iface->analogLeftY		= data[1];
+			
+			if( target == WII_LIB_TARGET_DEVICE_NUNCHUCK )
+			{
+				iface->accelX		= (int16_t)( (data[2] << 2) | ((data[5] >> 2) & 0x03) );
+				iface->accelY		= (int16_t)( (data[3] << 2) | ((data[5] >> 4) & 0x03) );
+				iface->accelZ		= (int16_t)( (data[4] << 2) | ((data[5] >> 6) & 0x03) );
+			}
+			else
+			{
+				iface->accelX		= (int16_t)( (data[2] << 2) | (((data[5] >> 4) & 0x01) << 1) );
+				iface->accelY		= (int16_t)( (data[3] << 2) | (((data[5] >> 5) & 0x01) << 1) );
+				iface->accelZ		= (int16_t)( ((data[4] >> 1) << 3) | (((data[5] >> 6) & 0x03) << 1) );
+			}
+			
+			iface->analogRightX		= iface->analogLeftX;
+			iface->analogRightY		= iface->analogLeftY;
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
+			// Bytes 5 - 6: buttons (active low) at bits 1 - 15. When passed through, bit 0 holds the 
+			// extension flag and d-pad up/left move to bit 0 of bytes 1 - 2.
+			if( target == WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER )
+			{
+				pressed				= ~( data[4] | (data[5] << 8) ) & 0xFFFE;
+				iface->analogLeftX	= data[0] & 0x3F;
+				iface->analogLeftY	= data[1] & 0x3F;
+			}
+			else
+			{
+				pressed				= ~( (data[4] | (data[5] << 8)) & 0xFCFE ) & 0xFFFE;
+				pressed				&= ~( ((uint32_t)(data[0] & 0x01) << 8) | ((uint32_t)(data[1] & 0x01) << 9) );
+				iface->analogLeftX	= data[0] & 0x3E;
+				iface->analogLeftY	= data[1] & 0x3E;
+			}
+			
+			iface->buttons			= pressed;
+			iface->triggerLeft		= (int16_t)( (((data[2] >> 5) & 0x03) << 3) | ((data[3] >> 5) & 0x07) );
+			iface->triggerRight		= data[3] & 0x1F;
+			iface->analogRightX		= (int16_t)( (((data[0] >> 6) & 0x03) << 3) | (((data[1] >> 6) & 0x03) << 1) | ((data[2] >> 7) & 0x01) );
+			iface->analogRightY		= data[2] & 0x1F;
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_GUITAR:
+			// Bytes 0 - 3: joystick (6-bit), touch bar and whammy (5-bit). Buttons as the classic 
+			// controller.
+			iface->buttons			= ~( data[4] | (data[5] << 8) ) & 0xFFFE;
+			iface->analogLeftX		= data[0] & 0x3F;
+			iface->analogLeftY		= data[1] & 0x3F;
+			iface->analogRightX		= data[2] & 0x1F;
+			iface->triggerRight		= data[3] & 0x1F;
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_DRUMS:
+			// Byte 2: pad hit at bits 1 - 5, bit 6 set when no velocity is sent. Byte 3: softness 
+			// at bits 5 - 7 (7 == softest).
+			iface->buttons			= ~( data[4] | (data[5] << 8) ) & 0xFFFE;
+			iface->analogLeftX		= data[0] & 0x3F;
+			iface->analogLeftY		= data[1] & 0x3F;
+			iface->triggerLeft		= (data[2] >> 1) & 0x1F;
+			iface->triggerRight		= ( data[2] & 0x40 ) ? 0 : 7 - ((data[3] >> 5) & 0x07);
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_TURNTABLE:
+			// Left turntable: bits 0 - 4 of byte 3, sign at bit 0 of byte 4. Right turntable: bit 7 
+			// of byte 2, bits 6 - 7 of bytes 1 and 0, sign at bit 0 of byte 2. Fader: bits 1 - 4 of 
+			// byte 2. Effect dial: bits 5 - 7 of byte 3 and bits 5 - 6 of byte 2.
+			speed					= (data[3] & 0x1F) | ((data[4] & 0x01) << 5);
+			iface->analogRightX		= (int16_t)( speed >= 32 ? speed - 64 : speed );
+			speed					= ((data[2] >> 7) & 0x01) | (((data[1] >> 6) & 0x03) << 1) | (((data[0] >> 6) & 0x03) << 3) | ((data[2] & 0x01) << 5);
+			iface->analogRightY		= (int16_t)( speed >= 32 ? speed - 64 : speed );
+			iface->analogLeftX		= data[0] & 0x3F;
+			iface->analogLeftY		= data[1] & 0x3F;
+			iface->triggerLeft		= (data[2] >> 1) & 0x0F;
+			iface->triggerRight		= ((data[3] >> 5) & 0x07) | (((data[2] >> 5) & 0x03) << 3);
+			iface->buttons			= ~( data[4] | (data[5] << 8) ) & ( WII_GUITAR_HERO_TURNTABLE_LEFT_GREEN | WII_GUITAR_HERO_TURNTABLE_LEFT_RED | WII_GUITAR_HERO_TURNTABLE_LEFT_BLUE |
+												WII_GUITAR_HERO_TURNTABLE_RIGHT_GREEN | WII_GUITAR_HERO_TURNTABLE_RIGHT_RED | WII_GUITAR_HERO_TURNTABLE_RIGHT_BLUE |
+												WII_GUITAR_HERO_TURNTABLE_EUPHORIA | WII_LIB_BUTTON_PLUS | WII_LIB_BUTTON_MINUS );
+			break;
+		
+		default:
+			break;
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Prints the outcome of a check.
+//!	
+//!	@param[in]		*name				Label to print.
+//!	@param[in]		checked				Number of cases checked.
+//!	@param[in]		failures			Number of cases that failed.
+//!	
+//!	@returns		TRUE if no case failed.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiTest_Report( const char *name, uint32_t checked, uint32_t failures )
+{
+	printf( "  %-32s %8u checked  %8u failed  %s\n", name, (unsigned)checked, (unsigned)failures, ( failures ? "FAIL" : "ok" ) );
+	return ( failures == 0 );
+}
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, types, and functions for the interrupt driven I2C 
+//!					transaction queue used by the "wii" library module.
+//!	
+//!	@details		Transfers (writes and reads of N bytes) are queued from the main loop and then 
+//!					executed one bus phase at a time from the I2C master interrupt using the 
+//!					non-blocking primitives of the backend ('WiiLib_BusOps'). A completion callback 
+//!					is invoked (from the interrupt) once each transfer finishes. No CPU cycles are 
+//!					spent waiting on the bus.
+//!	
+//!	@note			One queue should be used per I2C module. The application is responsible for 
+//!					enabling the master interrupt for the module and invoking 'WiiAsync_Isr()' 
+//!					from the interrupt handler (after clearing the interrupt flag).
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_ASYNC__
+#define	__WII_ASYNC__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_ASYNC_QUEUE_DEPTH						8												//!< Number of transfers a queue can hold. Must be a power of two no greater than 128.
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the bus phase the queue is waiting on to complete (next interrupt).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _WII_ASYNC_PHASE
+{
+	WII_ASYNC_PHASE_IDLE							= 0,											//!< No transfer in progress.
+	WII_ASYNC_PHASE_START							= 1,											//!< Start condition issued.
+	WII_ASYNC_PHASE_ADDRESS							= 2,											//!< Address byte sent.
+	WII_ASYNC_PHASE_WRITE							= 3,											//!< Data byte sent.
+	WII_ASYNC_PHASE_READ							= 4,											//!< Receiver enabled for the next data byte.
+	WII_ASYNC_PHASE_ACK								= 5,											//!< Ack (or nack for the final byte) sent for a received byte.
+	WII_ASYNC_PHASE_STOP							= 6												//!< Stop condition issued.
+} WII_ASYNC_PHASE;
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+struct _WiiLib_Device;
+struct _WiiAsync_Transfer;
+
+
+typedef void (*WiiAsync_Callback)( struct _WiiAsync_Transfer *transfer );							//!< Completion callback. Invoked from the I2C interrupt.
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines a single queued transfer.
+//!	
+//!	@note			The data buffer must remain valid until the completion callback is invoked.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiAsync_Transfer
+{
+	struct _WiiLib_Device							*device;										//!< Device (I2C port and backend) the transfer is executed against.
+	uint8_t											addr;											//!< Address of the target (normally 'device->i2c.addr'; differs for multiplexer writes).
+	uint8_t											*data;											//!< Data to write or destination for data read.
+	uint8_t											len;											//!< Number of bytes to write or read.
+	uint8_t											read;											//!< Flag indicating if the transfer reads (TRUE) or writes (FALSE).
+	uint8_t											chained;										//!< Flag indicating the next transfer depends on this one (set by 'WiiAsync_SubmitChain()'). Should this transfer fail, the next one is completed with the same result without touching the bus.
+	WII_LIB_RC										result;											//!< Result of the transfer ('WII_LIB_RC_I2C_ERROR' if the target did not ack). Valid when the callback is invoked.
+	WiiAsync_Callback								callback;										//!< Function invoked once the transfer completes (may be NULL).
+	void											*context;										//!< Caller defined value available to the callback.
+} WiiAsync_Transfer;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines a queue of transfers executed from the I2C interrupt.
+//!	
+//!	@details		Single producer (main loop) / single consumer (interrupt). 'tail' is only 
+//!					modified by the main loop and 'head' only by the interrupt.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiAsync_Queue
+{
+	WiiAsync_Transfer								transfers[WII_ASYNC_QUEUE_DEPTH];				//!< Ring of queued transfers.
+	volatile uint8_t								head;											//!< Index of the transfer in progress (or next to run).
+	volatile uint8_t								tail;											//!< Index at which the next transfer is queued.
+	volatile uint8_t								running;										//!< Flag indicating if the interrupt is working through the queue.
+	WII_ASYNC_PHASE									phase;											//!< Bus phase the interrupt is waiting on.
+	uint8_t											index;											//!< Index of the next byte of the active transfer.
+	uint32_t										interruptCount;									//!< Number of interrupts serviced (diagnostic).
+} WiiAsync_Queue;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+void			WiiAsync_Init(			WiiAsync_Queue *queue																		);
+WII_LIB_RC		WiiAsync_Attach(		WiiAsync_Queue *queue,	struct _WiiLib_Device *device										);
+WII_LIB_RC		WiiAsync_Submit(		WiiAsync_Queue *queue,	const WiiAsync_Transfer *transfer									);
+WII_LIB_RC		WiiAsync_SubmitChain(	WiiAsync_Queue *queue,	const WiiAsync_Transfer *transfers,	uint8_t count					);
+BOOL			WiiAsync_IsIdle(		WiiAsync_Queue *queue																		);
+uint8_t			WiiAsync_GetFree(		WiiAsync_Queue *queue																		);
+void			WiiAsync_Isr(			WiiAsync_Queue *queue																		);
+
+
+#endif	// __WII_ASYNC__
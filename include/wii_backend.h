@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines the interface used by the "wii" library module to reach the I2C bus and 
+//!					delay routines.
+//!	
+//!	@details		All bus traffic and delays executed by the library are routed through a table of 
+//!					function pointers. The default table ('WiiLib_BackendDefault') is resolved at 
+//!					link time:
+//!						-	PIC32:	"wii_backend.c" wraps lib-i2c and lib-timing.
+//!						-	Host:	"host/wii_sim.c" provides an in-memory simulated bus and clock.
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_BACKEND__
+#define	__WII_BACKEND__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "i2c.h"
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Table of non-blocking bus primitives used by the interrupt driven transaction 
+//!					queue (see "wii_async.h").
+//!	
+//!	@details		Each of 'start', 'stop', 'write', 'receive', and 'ack' kicks off a single bus 
+//!					phase and returns immediately. Completion of the phase must raise the I2C master 
+//!					interrupt for the module (which invokes 'WiiAsync_Isr()').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiLib_BusOps
+{
+	void											(*start)(		I2C_Device *i2c								);	//!< Issues a start condition.
+	void											(*stop)(		I2C_Device *i2c								);	//!< Issues a stop condition.
+	void											(*write)(		I2C_Device *i2c,	uint8_t data			);	//!< Sends a single byte (address or data).
+	void											(*receive)(		I2C_Device *i2c								);	//!< Enables the receiver for a single byte.
+	uint8_t											(*readByte)(	I2C_Device *i2c								);	//!< Returns the byte captured by the last 'receive'.
+	void											(*ack)(			I2C_Device *i2c,	BOOL ack				);	//!< Sends an ack (TRUE) or nack (FALSE) for the last byte received.
+	BOOL											(*acked)(		I2C_Device *i2c								);	//!< Returns TRUE if the last byte sent was acknowledged by the target.
+} WiiLib_BusOps;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Table of functions used to communicate with Wii targets.
+//!	
+//!	@note			The transfer functions mirror the lib-i2c API. None of them should sleep beyond 
+//!					the delays configured within the provided 'I2C_Device{}'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiLib_Backend
+{
+	I2C_RC											(*init)(		I2C_Device *i2c,	uint32_t pbClk																);	//!< Initializes the I2C port (and any timing support) used by 'i2c'.
+	I2C_RC											(*transmit)(	I2C_Device *i2c,	uint8_t *data,		uint32_t len,		BOOL sendStop							);	//!< Writes 'len' bytes to the target.
+	I2C_RC											(*receive)(		I2C_Device *i2c,	uint8_t *data,		uint32_t len,		BOOL sendStop							);	//!< Reads 'len' bytes from the target.
+	I2C_RC											(*txrx)(		I2C_Device *i2c,	uint8_t *dataOut,	uint32_t lenOut,	uint8_t *dataIn,	uint32_t lenIn,	BOOL sendStop,	BOOL repeatedStart	);	//!< Writes 'lenOut' bytes and then reads 'lenIn' bytes from the target.
+	void											(*delayMs)(		uint32_t ms																					);	//!< Blocks for the requested number of milliseconds.
+	const WiiLib_BusOps								*bus;																													//!< Non-blocking bus primitives (NULL if the backend cannot drive the transaction queue).
+	uint32_t										(*cycles)(		void																						);	//!< Returns a free-running cycle count used by the optional statistics (NULL if the backend has no counter).
+} WiiLib_Backend;
+
+
+
+
+//==================================================================================================
+//	PUBLIC VARIABLES
+//--------------------------------------------------------------------------------------------------
+extern const WiiLib_Backend		WiiLib_BackendDefault;												//!< Backend assigned to every device by 'WiiLib_InitNonBlocking()'. Provided by exactly one backend source file.
+
+
+#endif	// __WII_BACKEND__
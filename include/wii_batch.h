@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, types, and functions for decoding large sets of 
+//!					captured status frames (offline analysis, replay, etc.).
+//!	
+//!	@details		Frames are decoded straight from a contiguous array of raw (decrypted) status 
+//!					frames into structure-of-arrays outputs without going through a 
+//!					'WiiLib_Device{}'. Decoding is driven by the same field descriptor tables as 
+//!					the per-frame decoders. Each block of frames is transposed into byte planes 
+//!					and every descriptor row becomes a loop over contiguous bytes so the compiler 
+//!					can vectorize it (SSE/NEON on host builds).
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_BATCH__
+#define	__WII_BATCH__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_BATCH_FRAME_LEN							WII_LIB_PARAM_RESPONSE_LEN_DEFAULT				//!< Number of bytes per raw frame in the input array.
+#define	WII_BATCH_BLOCK_FRAMES						128												//!< Frames decoded per block (frames are transposed into 'WII_BATCH_FRAME_LEN' byte planes of this size on the stack).
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Structure-of-arrays destination for 'WiiBatch_Decode()'.
+//!	
+//!	@details		Each member points to an array with (at least) one entry per frame decoded. 
+//!					Members set to NULL are skipped, as are members the target does not report 
+//!					(e.g. triggers for a nunchuck). Values match the corresponding 
+//!					'WiiLib_Interface{}' members produced by the per-frame decoders.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiBatch_Output
+{
+	uint32_t										*buttons;										//!< Buttons pressed ('WII_LIB_BUTTON_*' bitmask).
+	int8_t											*triggerLeft;									//!< Left trigger values.
+	int8_t											*triggerRight;									//!< Right trigger values.
+	int16_t											*analogLeftX;									//!< Left joystick x-axis values.
+	int16_t											*analogLeftY;									//!< Left joystick y-axis values.
+	int16_t											*analogRightX;									//!< Right joystick x-axis values.
+	int16_t											*analogRightY;									//!< Right joystick y-axis values.
+	int16_t											*accelX;										//!< Accelerometer x-axis values.
+	int16_t											*accelY;										//!< Accelerometer y-axis values.
+	int16_t											*accelZ;										//!< Accelerometer z-axis values.
+} WiiBatch_Output;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+WII_LIB_RC		WiiBatch_Decode(	WII_LIB_TARGET_DEVICE target,	const uint8_t *frames,	uint32_t count,	const WiiBatch_Output *output	);
+
+
+#endif	// __WII_BATCH__
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, types, and functions for reading and caching the 
+//!					factory calibration of Wii targets.
+//!	
+//!	@details		Nunchucks and classic controllers store their factory calibration (joystick 
+//!					minimum/center/maximum, trigger rest values, and accelerometer 0g/1g values) in a 
+//!					'WII_CALIBRATION_BLOCK_LEN' byte block at 'WII_LIB_PARAM_RAW_DATA'. Once a cache 
+//!					is attached (see 'WiiCalibration_Attach()'), the block is read and checksummed 
+//!					the first time a target connects, stored in the cache, and used as the home 
+//!					position from then on (no need to hold the controller still while connecting). 
+//!					Later connections only read the two checksum bytes of the block and skip the 
+//!					full read when a cached entry matches.
+//!	
+//!	@note			The cache entries are plain data and can be kept in non-volatile memory by the 
+//!					application (see 'WiiCalibration_Cache{}').
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_CALIBRATION__
+#define	__WII_CALIBRATION__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_CALIBRATION_BLOCK_LEN					16												//!< Length (in bytes) of the calibration block (checksum included).
+#define	WII_CALIBRATION_CHECKSUM_OFFSET				14												//!< Offset of the two checksum bytes within the block.
+#define	WII_CALIBRATION_CHECKSUM_SEED_1				0x55											//!< Added to the sum of the data bytes to form the first checksum byte.
+#define	WII_CALIBRATION_CHECKSUM_SEED_2				0xAA											//!< Added to the sum of the data bytes to form the second checksum byte.
+#define	WII_CALIBRATION_CHECKSUM_LEN				2												//!< Length (in bytes) of the checksum (read on its own on every connection, see 'WII_LIB_PARAM_CALIBRATION_CHECKSUM').
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+struct _WiiLib_Device;
+struct _WiiCalibration_Cache;
+
+typedef void (*WiiCalibration_Persist)( struct _WiiCalibration_Cache *cache, uint8_t index );		//!< Invoked after entry 'index' of the cache changed (e.g. to write it to non-volatile memory).
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Calibration values of a single target.
+//!	
+//!	@details		Values are scaled to match the 'WiiLib_Interface{}' values reported by the 
+//!					decoders. Accelerometer values use 'center' for 0g and 'maximum' for 1g ('minimum' 
+//!					mirrors 1g around 0g).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiCalibration_Data
+{
+	WiiLib_Interface								minimum;										//!< Lowest value reported per axis.
+	WiiLib_Interface								center;											//!< Value reported per axis at rest.
+	WiiLib_Interface								maximum;										//!< Highest value reported per axis.
+} WiiCalibration_Data;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Cached calibration of a single target.
+//!	
+//!	@details		Entries are keyed by the ID read from the target, by where the target is wired 
+//!					(module and multiplexer channel), and by the checksum of its calibration block 
+//!					(re-read on every connection). The ID only identifies the type of target, so 
+//!					the checksum is what tells apart two units swapped on the same port.
+//!	
+//!	@note			Two units whose blocks share the same checksum are not told apart (the checksum 
+//!					bytes only differ by a fixed seed, so about 1 in 256 pairs of units). The 
+//!					values of the unit cached first are then used for both.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiCalibration_Entry
+{
+	uint8_t											id[WII_LIB_ID_LENGTH];							//!< ID read from the target.
+	uint8_t											module;											//!< I2C module the target is attached to.
+	uint8_t											muxAddr;										//!< Address of the multiplexer the target sits behind ('WII_LIB_MUX_NONE' == wired directly).
+	uint8_t											muxSelect;										//!< Channel mask written to 'muxAddr' to reach the target.
+	uint8_t											checksum[WII_CALIBRATION_CHECKSUM_LEN];			//!< Checksum bytes of the calibration block.
+	uint8_t											valid;											//!< Flag indicating if the entry holds calibration values.
+	WiiCalibration_Data								data;											//!< Calibration values.
+} WiiCalibration_Entry;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Calibration cache shared by any number of devices.
+//!	
+//!	@details		'entries[]' is supplied by the application. It may be loaded from non-volatile 
+//!					memory before 'WiiCalibration_Init()' is invoked with 'keep' set, and written 
+//!					back from 'persist'. When full, the oldest entry is replaced.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiCalibration_Cache
+{
+	WiiCalibration_Entry							*entries;										//!< Storage for the cached values (application supplied).
+	uint8_t											count;											//!< Number of entries in 'entries[]'.
+	uint8_t											next;											//!< Entry replaced by the next target read.
+	WiiCalibration_Persist							persist;										//!< Invoked whenever an entry is stored (NULL == RAM only).
+	void											*context;										//!< Application defined value available to 'persist'.
+} WiiCalibration_Cache;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+void			WiiCalibration_Init(		WiiCalibration_Cache *cache,	WiiCalibration_Entry *entries,	uint8_t count,	BOOL keep,	WiiCalibration_Persist persist	);
+WII_LIB_RC		WiiCalibration_Attach(		WiiCalibration_Cache *cache,	struct _WiiLib_Device *device															);
+WII_LIB_RC		WiiCalibration_Parse(		WII_LIB_TARGET_DEVICE target,	WII_LIB_REPORT report,			const uint8_t *block,	WiiCalibration_Data *calibration			);
+BOOL			WiiCalibration_IsSupported(	struct _WiiLib_Device *device																							);
+WII_LIB_RC		WiiCalibration_Find(		struct _WiiLib_Device *device,	const uint8_t *checksum																	);
+WII_LIB_RC		WiiCalibration_Store(		struct _WiiLib_Device *device,	const uint8_t *block																	);
+WII_LIB_RC		WiiCalibration_Load(		struct _WiiLib_Device *device																							);
+void			WiiCalibration_ApplyHome(	struct _WiiLib_Device *device																							);
+
+
+#endif	// __WII_CALIBRATION__
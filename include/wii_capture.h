@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, types, and functions for the optional traffic 
+//!					recorder of the "wii" library module.
+//!	
+//!	@details		Once a recorder is attached (see 'WiiCapture_Attach()') every response 
+//!					processed for the device (blocking queries and 'WiiLib_Service()' alike) is 
+//!					appended to a compact log: the bytes read (decrypted when the target encrypts, 
+//!					before validation, so rejected frames are kept as well), the target type, the 
+//!					parameter and register queried, and a microsecond timestamp. Records are 
+//!					collected in 'buffer[]' and handed to the caller's sink whenever it fills (and 
+//!					by 'WiiCapture_Flush()').
+//!	
+//!					The log starts with 'WII_CAPTURE_MAGIC' followed by 'WII_CAPTURE_VERSION'. Each 
+//!					record then holds:
+//!						1.	A tag byte ('WII_CAPTURE_TAG_*').
+//!						2.	The time elapsed since the previous record in microseconds (LEB128: seven 
+//!							bits per byte, least significant first, top bit set on every byte but 
+//!							the last). The first record holds the clock value itself.
+//!						3.	When 'WII_CAPTURE_TAG_HEADER' is set: target type, parameter, register, 
+//!							and length (one byte each). Only written when one of them differs from 
+//!							the previous record.
+//!						4.	When 'WII_CAPTURE_TAG_RAW' is set: 'length' bytes as read. Otherwise a 
+//!							bitmap of the bytes that differ from the previous record (one bit per 
+//!							byte, least significant bit first) followed by the new value of each 
+//!							byte flagged.
+//!	
+//!					An idle status frame polled every few milliseconds takes four bytes.
+//!	
+//!	@note			When transfers complete from the I2C interrupt (see "wii_async.h") records are 
+//!					appended, and the sink invoked, from the interrupt.
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_CAPTURE__
+#define	__WII_CAPTURE__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_CAPTURE_MAGIC							"WIIC"											//!< Bytes the log starts with.
+#define	WII_CAPTURE_MAGIC_LEN						4												//!< Number of bytes in 'WII_CAPTURE_MAGIC'.
+#define	WII_CAPTURE_VERSION							1												//!< Format version written after the magic bytes.
+
+#define	WII_CAPTURE_TAG_HEADER						0x80											//!< Record tag flag: target type, parameter, register, and length follow the timestamp.
+#define	WII_CAPTURE_TAG_RAW							0x40											//!< Record tag flag: bytes are stored as read (no bitmap).
+
+#define	WII_CAPTURE_BITMAP_LEN						((WII_LIB_MAX_PAYLOAD_SIZE + 7) / 8)			//!< Largest changed byte bitmap.
+#define	WII_CAPTURE_RECORD_MAX_LEN					(1 + 5 + 4 + WII_LIB_MAX_PAYLOAD_SIZE)			//!< Largest record (tag, timestamp, header, raw bytes).
+#define	WII_CAPTURE_BUFFER_SIZE						128												//!< Bytes collected before the sink is invoked. Must be at least 'WII_CAPTURE_RECORD_MAX_LEN'.
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+struct _WiiLib_Device;
+
+typedef void (*WiiCapture_Sink)( void *context, const uint8_t *data, uint32_t len );				//!< Receives the next part of the log (file, UART, RAM buffer, etc.). Data is only valid for the duration of the call.
+typedef uint32_t (*WiiCapture_Clock)( void );														//!< Returns the current time in microseconds (free-running counter) used to timestamp records.
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Tracks the log written for a single device.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiCapture_Recorder
+{
+	WiiCapture_Sink									sink;											//!< Destination of the log.
+	void											*context;										//!< Value passed to 'sink'.
+	WiiCapture_Clock								clock;											//!< Source of record timestamps (NULL == timestamps are zero).
+	uint8_t											started;										//!< Flag indicating if the magic bytes and version have been written.
+	uint8_t											target;											//!< Target type of the previous record.
+	uint8_t											param;											//!< Parameter of the previous record.
+	uint8_t											reg;											//!< Register of the previous record.
+	uint8_t											len;											//!< Length of the previous record (zero == no record yet).
+	uint8_t											previous[WII_LIB_MAX_PAYLOAD_SIZE];				//!< Bytes of the previous record.
+	uint32_t										timeUs;											//!< Timestamp of the previous record.
+	uint32_t										records;										//!< Number of records appended.
+	uint32_t										used;											//!< Bytes waiting in 'buffer[]'.
+	uint8_t											buffer[WII_CAPTURE_BUFFER_SIZE];				//!< Records not yet handed to 'sink'.
+} WiiCapture_Recorder;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+void			WiiCapture_Init(		WiiCapture_Recorder *recorder,	WiiCapture_Sink sink,		void *context,		WiiCapture_Clock clock	);
+WII_LIB_RC		WiiCapture_Attach(		WiiCapture_Recorder *recorder,	struct _WiiLib_Device *device											);
+void			WiiCapture_Record(		struct _WiiLib_Device *device,	WII_LIB_PARAM param,		uint8_t reg,		const uint8_t *data,	uint32_t len	);
+void			WiiCapture_Flush(		WiiCapture_Recorder *recorder																			);
+
+
+#endif	// __WII_CAPTURE__
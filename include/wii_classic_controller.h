@@ -22,105 +22,197 @@
 //==================================================================================================
 //	CONSTANTS => THRESHOLDS
 //--------------------------------------------------------------------------------------------------
-// NOTE:	The following threshold values are not used in the library but are good reference values 
-//			for the amount of noise to ignore off of a relative zero position in an application.
+// NOTE:	The following threshold values are good reference values for the amount of noise to ignore 
+//			off of a relative zero position in an application (see "wii_output.h" for a deadzone 
+//			applied by the library). The adaptive scheduler uses them to tell activity from noise 
+//			between frames (see "wii_scheduler.h").
 #define	WII_CLASSIC_CONTROLLER_THRESHOLD_ANALOG_LEFT		15					//!< Threshold off of relative position to consider accelerometer data to be active. Has a range of ~60 (15 ~= 25% of range of movement).
 #define	WII_CLASSIC_CONTROLLER_THRESHOLD_ANALOG_RIGHT		8					//!< Threshold off of relative position to consider left analog joystick to be active. Has a range of ~30 (8 ~= 25% of range of movement).
 #define	WII_CLASSIC_CONTROLLER_THRESHOLD_TRIGGERS			8					//!< Threshold off of relative position to conider and left or right trigger button to be active. Has a range of ~30 (8 ~25% of range of movement).
 
+// Same travel in counts of the high-resolution data format ('WII_LIB_REPORT_HIGH_RESOLUTION').
+#define	WII_CLASSIC_CONTROLLER_HIGH_RES_THRESHOLD_ANALOG	60					//!< Threshold off of relative position to consider either analog joystick to be active (8-bit readings).
+#define	WII_CLASSIC_CONTROLLER_HIGH_RES_THRESHOLD_TRIGGERS	64					//!< Threshold off of relative position to consider the left or right trigger to be active (8-bit readings).
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => RANGES
+//--------------------------------------------------------------------------------------------------
+#define	WII_CLASSIC_CONTROLLER_ANALOG_LEFT_HALF_RANGE		32					//!< Nominal travel (in counts) of the left analog joystick either side of its center (6-bit axis).
+#define	WII_CLASSIC_CONTROLLER_ANALOG_RIGHT_HALF_RANGE		16					//!< Nominal travel (in counts) of the right analog joystick either side of its center (5-bit axis).
+#define	WII_CLASSIC_CONTROLLER_HIGH_RES_ANALOG_HALF_RANGE	128					//!< Nominal travel (in counts) of either analog joystick either side of its center in the high-resolution data format (8-bit).
+
 
 
 
 //==================================================================================================
-//	TYPEDEFS
+//	CONSTANTS => REPORT WINDOWS
 //--------------------------------------------------------------------------------------------------
+// Part of the status frame read by a buttons-only report ('WII_LIB_REPORT_BUTTONS').
+#define	WII_CLASSIC_CONTROLLER_REPORT_BUTTONS_OFFSET		4					//!< Offset of the first status frame byte read.
+#define	WII_CLASSIC_CONTROLLER_REPORT_BUTTONS_LEN			2					//!< Number of status frame bytes read.
+
+// Status frame read by a high-resolution report ('WII_LIB_REPORT_HIGH_RESOLUTION'). Starts at the 
+// first byte of the status frame.
+#define	WII_CLASSIC_CONTROLLER_HIGH_RES_LEN					8					//!< Number of status frame bytes read.
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => DATA FORMAT
+//--------------------------------------------------------------------------------------------------
+// Register selecting the layout of the status frame. Written while configuring the target (see 
+// 'WiiLib_ConfigureDevice()'). The value is also reported in byte 4 of the identifier.
+#define	WII_CLASSIC_CONTROLLER_REG_DATA_FORMAT				0xFE				//!< Register holding the data format.
+#define	WII_CLASSIC_CONTROLLER_DATA_FORMAT_STANDARD			0x01				//!< Default data format (6-byte frame, 6/5-bit joysticks and triggers).
+#define	WII_CLASSIC_CONTROLLER_DATA_FORMAT_HIGH_RES			0x03				//!< High-resolution data format (8-byte frame, 8-bit joysticks and triggers).
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => FIXED BITS
+//--------------------------------------------------------------------------------------------------
+// Bits of the status frame that never change when directly connected. Frames holding any other 
+// value are rejected ('WII_LIB_FRAME_RESERVED'). Pass-through frames are checked against the 
+// Wii Motion Plus constants instead.
+#define	WII_CLASSIC_CONTROLLER_FIXED_BYTE					4					//!< Byte holding the fixed bits (within the buttons-only report window too).
+#define	WII_CLASSIC_CONTROLLER_FIXED_MASK					0x01				//!< Mask of the fixed bits (unused bit below the first button).
+#define	WII_CLASSIC_CONTROLLER_FIXED_VALUE					0x01				//!< Value of the fixed bits (reads as an idle, active low button).
+#define	WII_CLASSIC_CONTROLLER_HIGH_RES_FIXED_BYTE			6					//!< Byte holding the fixed bits in the high-resolution frame (same mask and value).
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => STATUS FIELD DESCRIPTORS
+//--------------------------------------------------------------------------------------------------
+// Layout of the status frame expressed as a table of field descriptors. Expanded with 
+// 'WII_LIB_DECODE_FIELD()' into straight-line shift/mask code (see "wii_lib.h" for column details). 
+// Buttons are active low (inverted); bytes 5 - 6 share the layout of 'WII_LIB_BUTTON_*'.
+//
+//		X(	destination,	op,	byte,	shift,	width,	destShift,	invert	)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-//!	@brief			Defines bitfield interaction for status field queries from classic controllers.
-//!	
-//!	@note			The definitions below are for use when directly connected to a classic 
-//!					controller.
+//!	@brief			Status frame fields when directly connected to a classic controller.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_CLASSIC_CONTROLLER_FIELDS_NORMAL(X)															\
+	X(	analogLeftX,		=,		0,		0,		6,		0,		0x00	)							\
+	X(	analogLeftY,		=,		1,		0,		6,		0,		0x00	)							\
+	X(	analogRightX,		=,		0,		6,		2,		3,		0x00	)							\
+	X(	analogRightX,		|=,		1,		6,		2,		1,		0x00	)							\
+	X(	analogRightX,		|=,		2,		7,		1,		0,		0x00	)							\
+	X(	analogRightY,		=,		2,		0,		5,		0,		0x00	)							\
+	X(	triggerLeft,		=,		2,		5,		2,		3,		0x00	)							\
+	X(	triggerLeft,		|=,		3,		5,		3,		0,		0x00	)							\
+	X(	triggerRight,		=,		3,		0,		5,		0,		0x00	)							\
+	WII_CLASSIC_CONTROLLER_FIELDS_BUTTONS(X)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Button fields when directly connected to a classic controller (all within the 
+//!					buttons-only report window).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_CLASSIC_CONTROLLER_FIELDS_BUTTONS(X)														\
+	X(	buttons,			=,		4,		1,		7,		1,		0xFF	)							\
+	X(	buttons,			|=,		5,		0,		8,		8,		0xFF	)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Status frame fields when connected to a classic controller in pass-through mode 
+//!					(e.g. when using Wii Motion Plus + classic controller).
 //!	
-//!	@warning		The following is in little-endian format.
+//!	@note			The least significant bit of the left joystick is dropped (always zero) to make 
+//!					room for the d-pad up/left buttons. Bits 0 - 1 of byte 6 are pass-through flags.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-typedef struct _WiiClassic_StatusNormal
-{
-	// Byte-01:
-	uint8_t								analogLeftX:		6;					//!< Bits <5:0> for the left analog joystic along the x-axis.
-	uint8_t								analogRightXHigh:	2;					//!< Bits <4:3> for the right analog joystic along the x-axis.
-	// Byte-02:
-	uint8_t								analogLeftY:		6;					//!< Bits <5:0> for the left analog joystic along the y-axis.
-	uint8_t								analogRightXMid:	2;					//!< Bits <2:1> for the right analog joystic along the x-axis.
-	// Byte-03:
-	uint8_t								analogRightY:		5;					//!< Bits <4:0> for the right analog joystic along the y-axis.
-	uint8_t								leftTriggerHigh:	2;					//!< Bits <4:3> for the left trigger.
-	uint8_t								analogRightXLow:	1;					//!< Bit  <0>   for the right analog joystick along the x-axis.
-	// Byte-04:
-	uint8_t								rightTrigger:		5;					//!< Bits <4:0> for the right trigger.
-	uint8_t								leftTriggerLow:		3;					//!< Bits <2:0> for the left trigger.
-	// Byte-05:
-	uint8_t								RESERVED:			1;					//!< Reserved bit used when passing through the Wii Motion Plus (should be high == 1).
-	uint8_t								buttonTriggerRight:	1;					//!< Bit indicating status of button->-trigger-right.
-	uint8_t								buttonPlus:			1;					//!< Bit indicating status of button->+.
-	uint8_t								buttonHome:			1;					//!< Bit indicating status of button->home.
-	uint8_t								buttonMinus:		1;					//!< Bit indicating status of button->-.
-	uint8_t								buttonTriggerLeft:	1;					//!< Bit indicating status of button->-trigger-left.
-	uint8_t								dpadDown:			1;					//!< Bit indicating status of d-pad->down.
-	uint8_t								dpadRight:			1;					//!< Bit indicating status of d-pad->right.
-	// Byte-06:
-	uint8_t								dpadUp:				1;					//!< Bit indicating status of d-pad->up.
-	uint8_t								dpadLeft:			1;					//!< Bit indicating status of d-pad->left.
-	uint8_t								buttonZRight:		1;					//!< Bit indicating status of button->z-right.
-	uint8_t								buttonX:			1;					//!< Bit indicating status of button->x.
-	uint8_t								buttonA:			1;					//!< Bit indicating status of button->a.
-	uint8_t								buttonY:			1;					//!< Bit indicating status of button->y.
-	uint8_t								buttonB:			1;					//!< Bit indicating status of button->b.
-	uint8_t								buttonZLeft:		1;					//!< Bit indicating status of button->z-left.
-} WiiClassic_StatusNormal;
+#define	WII_CLASSIC_CONTROLLER_FIELDS_PASS_THROUGH(X)													\
+	X(	analogLeftX,		=,		0,		1,		5,		1,		0x00	)							\
+	X(	analogLeftY,		=,		1,		1,		5,		1,		0x00	)							\
+	X(	analogRightX,		=,		0,		6,		2,		3,		0x00	)							\
+	X(	analogRightX,		|=,		1,		6,		2,		1,		0x00	)							\
+	X(	analogRightX,		|=,		2,		7,		1,		0,		0x00	)							\
+	X(	analogRightY,		=,		2,		0,		5,		0,		0x00	)							\
+	X(	triggerLeft,		=,		2,		5,		2,		3,		0x00	)							\
+	X(	triggerLeft,		|=,		3,		5,		3,		0,		0x00	)							\
+	X(	triggerRight,		=,		3,		0,		5,		0,		0x00	)							\
+	X(	buttons,			=,		4,		1,		7,		1,		0xFF	)							\
+	X(	buttons,			|=,		5,		2,		6,		10,		0xFF	)							\
+	X(	buttons,			|=,		0,		0,		1,		8,		0xFF	)		/* d-pad up   */	\
+	X(	buttons,			|=,		1,		0,		1,		9,		0xFF	)		/* d-pad left */
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-//!	@brief			Defines bitfield interaction for status field queries from classic controllers.
+//!	@brief			Status frame fields when directly connected to a classic controller using the 
+//!					high-resolution data format ('WII_LIB_REPORT_HIGH_RESOLUTION').
 //!	
-//!	@note			The definitions below are for use when connected to a classic controller in 
-//!					pass-through mode (e.g. when using Wii Motion Plus + classic controller).
+//!	@note			Every analog value takes a whole byte, so each is a plain load. Bytes 6 - 7 hold 
+//!					the buttons with the same layout as bytes 4 - 5 of the standard frame.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_CLASSIC_CONTROLLER_FIELDS_HIGH_RES(X)														\
+	X(	analogLeftX,		=,		0,		0,		8,		0,		0x00	)							\
+	X(	analogRightX,		=,		1,		0,		8,		0,		0x00	)							\
+	X(	analogLeftY,		=,		2,		0,		8,		0,		0x00	)							\
+	X(	analogRightY,		=,		3,		0,		8,		0,		0x00	)							\
+	X(	triggerLeft,		=,		4,		0,		8,		0,		0x00	)							\
+	X(	triggerRight,		=,		5,		0,		8,		0,		0x00	)							\
+	X(	buttons,			=,		6,		1,		7,		1,		0xFF	)							\
+	X(	buttons,			|=,		7,		0,		8,		8,		0xFF	)
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => CALIBRATION FIELD DESCRIPTORS
+//--------------------------------------------------------------------------------------------------
+#define	WII_CLASSIC_CONTROLLER_TRIGGER_MAX					31					//!< Largest trigger value (5-bit readings).
+#define	WII_CLASSIC_CONTROLLER_HIGH_RES_TRIGGER_MAX			255					//!< Largest trigger value in the high-resolution data format (8-bit readings).
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Calibration block fields (see "wii_calibration.h"). Destinations are members of 
+//!					'WiiCalibration_Data{}'.
 //!	
-//!	@warning		The following is in little-endian format.
+//!	@note			The block holds full 8-bit values. They are reduced to the resolution of the 
+//!					status frame (6 bits for the left joystick, 5 bits for the right joystick and the 
+//!					triggers).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_CLASSIC_CONTROLLER_FIELDS_CALIBRATION(X)													\
+	X(	maximum.analogLeftX,	=,		0,		2,		6,		0,		0x00	)						\
+	X(	minimum.analogLeftX,	=,		1,		2,		6,		0,		0x00	)						\
+	X(	center.analogLeftX,		=,		2,		2,		6,		0,		0x00	)						\
+	X(	maximum.analogLeftY,	=,		3,		2,		6,		0,		0x00	)						\
+	X(	minimum.analogLeftY,	=,		4,		2,		6,		0,		0x00	)						\
+	X(	center.analogLeftY,		=,		5,		2,		6,		0,		0x00	)						\
+	X(	maximum.analogRightX,	=,		6,		3,		5,		0,		0x00	)						\
+	X(	minimum.analogRightX,	=,		7,		3,		5,		0,		0x00	)						\
+	X(	center.analogRightX,	=,		8,		3,		5,		0,		0x00	)						\
+	X(	maximum.analogRightY,	=,		9,		3,		5,		0,		0x00	)						\
+	X(	minimum.analogRightY,	=,		10,		3,		5,		0,		0x00	)						\
+	X(	center.analogRightY,	=,		11,		3,		5,		0,		0x00	)						\
+	X(	center.triggerLeft,		=,		12,		3,		5,		0,		0x00	)		/* rest */		\
+	X(	center.triggerRight,	=,		13,		3,		5,		0,		0x00	)		/* rest */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Calibration block fields for the high-resolution data format (full 8-bit values).
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-typedef struct _WiiClassic_StatusPassThrough
-{
-	// Byte-01:
-	uint8_t								dpadUp:				1;					//!< Bit indicating status of d-pad->up.
-	uint8_t								analogLeftX:		5;					//!< Bits <5:1> for the left analog joystic along the x-axis.
-	uint8_t								analogRightXHigh:	2;					//!< Bits <4:3> for the right analog joystic along the x-axis.
-	// Byte-02:
-	uint8_t								dpadLeft:			1;					//!< Bit indicating status of d-pad->left.
-	uint8_t								analogLeftY:		5;					//!< Bits <5:1> for the left analog joystic along the y-axis.
-	uint8_t								analogRightXMid:	2;					//!< Bits <2:1> for the right analog joystic along the x-axis.
-	// Byte-03:
-	uint8_t								analogRightY:		5;					//!< Bits <4:0> for the right analog joystic along the y-axis.
-	uint8_t								leftTriggerHigh:	2;					//!< Bits <4:3> for the left trigger.
-	uint8_t								analogRightXLow:	1;					//!< Bit  <0>   for the right analog joystick along the x-axis.
-	// Byte-04:
-	uint8_t								rightTrigger:		5;					//!< Bits <4:0> for the right trigger.
-	uint8_t								leftTriggerLow:		3;					//!< Bits <2:0> for the left trigger.
-	// Byte-05:
-	uint8_t								extensionConnected:	1;					//!< Pass through bit used when passing through the Wii Motion Plus (should be high == 1).
-	uint8_t								buttonTriggerRight:	1;					//!< Bit indicating status of button->-trigger-right.
-	uint8_t								buttonPlus:			1;					//!< Bit indicating status of button->+.
-	uint8_t								buttonHome:			1;					//!< Bit indicating status of button->home.
-	uint8_t								buttonMinus:		1;					//!< Bit indicating status of button->-.
-	uint8_t								buttonTriggerLeft:	1;					//!< Bit indicating status of button->-trigger-left.
-	uint8_t								dpadDown:			1;					//!< Bit indicating status of d-pad->down.
-	uint8_t								dpadRight:			1;					//!< Bit indicating status of d-pad->right.
-	// Byte-06:
-	uint8_t								RESERVED:			2;					//!< Rserved bits (should be == 0b00).
-	uint8_t								buttonZRight:		1;					//!< Bit indicating status of button->z-right.
-	uint8_t								buttonX:			1;					//!< Bit indicating status of button->x.
-	uint8_t								buttonA:			1;					//!< Bit indicating status of button->a.
-	uint8_t								buttonY:			1;					//!< Bit indicating status of button->y.
-	uint8_t								buttonB:			1;					//!< Bit indicating status of button->b.
-	uint8_t								buttonZLeft:		1;					//!< Bit indicating status of button->z-left.
-} WiiClassic_StatusPassThrough;
+#define	WII_CLASSIC_CONTROLLER_FIELDS_CALIBRATION_HIGH_RES(X)											\
+	X(	maximum.analogLeftX,	=,		0,		0,		8,		0,		0x00	)						\
+	X(	minimum.analogLeftX,	=,		1,		0,		8,		0,		0x00	)						\
+	X(	center.analogLeftX,		=,		2,		0,		8,		0,		0x00	)						\
+	X(	maximum.analogLeftY,	=,		3,		0,		8,		0,		0x00	)						\
+	X(	minimum.analogLeftY,	=,		4,		0,		8,		0,		0x00	)						\
+	X(	center.analogLeftY,		=,		5,		0,		8,		0,		0x00	)						\
+	X(	maximum.analogRightX,	=,		6,		0,		8,		0,		0x00	)						\
+	X(	minimum.analogRightX,	=,		7,		0,		8,		0,		0x00	)						\
+	X(	center.analogRightX,	=,		8,		0,		8,		0,		0x00	)						\
+	X(	maximum.analogRightY,	=,		9,		0,		8,		0,		0x00	)						\
+	X(	minimum.analogRightY,	=,		10,		0,		8,		0,		0x00	)						\
+	X(	center.analogRightY,	=,		11,		0,		8,		0,		0x00	)						\
+	X(	center.triggerLeft,		=,		12,		0,		8,		0,		0x00	)		/* rest */		\
+	X(	center.triggerRight,	=,		13,		0,		8,		0,		0x00	)		/* rest */
 
 
 
@@ -128,7 +220,10 @@ typedef struct _WiiClassic_StatusPassThrough
 //==================================================================================================
 //	PUBLIC FUNCTION PROTOTYPES
 //--------------------------------------------------------------------------------------------------
-WII_LIB_RC		WiiClassic_ProcessStatusParam(	WiiLib_Device *device	);
+WII_LIB_RC			WiiClassic_ProcessStatusParam(	WiiLib_Device *device	);
+const uint8_t *		WiiClassic_GetConfigSequence(	WiiLib_Device *device,	uint8_t *count	);
+uint8_t				WiiClassic_GetFrameLength(		WII_LIB_REPORT report	);
+const uint16_t *	WiiClassic_GetThresholds(		WiiLib_Device *device	);
 
 
 #endif	// __WII_CLASSIC_CONTROLLER__
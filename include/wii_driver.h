@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, types, and functions for the extension driver 
+//!					registry of the "wii" library module.
+//!	
+//!	@details		Everything the core needs to know about a type of target lives in a driver 
+//!					entry: the identifier it reports, the address it answers at, the configuration 
+//!					messages it takes, the length of its status frame, the function decoding that 
+//!					frame, and the change of each control that counts as activity. 'WiiLib_Init()' 
+//!					and the identification done while connecting look the driver up once and keep 
+//!					it in 'device->driver'; every status frame is then decoded through that pointer. 
+//!					Supporting new hardware therefore only takes a new driver (see 
+//!					'WiiDriver_Register()') and leaves the hot path and the scheduler untouched.
+//!	
+//!					Identifiers are packed into a 64-bit key and looked up in a small open 
+//!					addressing hash table (multiplicative hash, linear probing, kept at most half 
+//!					full), so identifying a target costs a multiply and (nearly always) a single 
+//!					compare however many drivers are registered. Drivers are also indexed by 
+//!					target type for 'WiiLib_Init()'.
+//!	
+//!					The drivers shipped with the library (nunchuck, classic controller, Wii Motion 
+//!					Plus modes, Guitar Hero guitar and drums, and DJ Hero turntable) are registered 
+//!					automatically the first time the registry is used.
+//!	
+//!	@note			The registry is shared by every device. Register application drivers before 
+//!					initializing devices (it is not protected against concurrent use).
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_DRIVER__
+#define	__WII_DRIVER__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_DRIVER_TABLE_BITS						5												//!< Size of the identifier hash table (2^bits slots).
+#define	WII_DRIVER_TABLE_SIZE						(1 << WII_DRIVER_TABLE_BITS)					//!< Number of slots in the identifier hash table.
+#define	WII_DRIVER_MAX_DRIVERS						(WII_DRIVER_TABLE_SIZE / 2)						//!< Most drivers registered (built-in ones included). Keeps probe sequences short.
+#define	WII_DRIVER_MAX_TARGETS						32												//!< Target types that can be indexed (0 - 31).
+
+#define	WII_DRIVER_FLAG_DECODE_REPEATED				0x01											//!< Decode frames repeating the previous one as well (see 'WII_LIB_FRAME_REPEATED').
+#define	WII_DRIVER_FLAG_RECONFIGURE_ON_INVALID		0x02											//!< Reconfigure the target and retry once when a status query returns 'not ready' data.
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+struct _WiiLib_Device;
+
+typedef const uint8_t * (*WiiDriver_Configure)( struct _WiiLib_Device *device, uint8_t *count );	//!< Returns the configuration messages (register address followed by value) to push out and their number. NULL == standard messages.
+typedef WII_LIB_RC (*WiiDriver_Decode)( struct _WiiLib_Device *device );							//!< Decodes 'device->dataCurrent[]' into 'device->interfaceCurrent'.
+typedef uint8_t (*WiiDriver_FrameLength)( WII_LIB_REPORT report );									//!< Returns the number of bytes read by a full frame report profile (zero == profile not supported).
+typedef const uint16_t * (*WiiDriver_Thresholds)( struct _WiiLib_Device *device );					//!< Returns the change each analog control must exceed to count as activity, indexed by control - 'WII_LIB_BUTTON_COUNT' (NULL == any change counts).
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Describes how to identify, configure, and decode a type of target.
+//!	
+//!	@details		Only 'decode' is required. Entries are referenced (not copied) by the registry, 
+//!					so they must outlive it (typically 'static const').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiDriver
+{
+	WII_LIB_TARGET_DEVICE							target;											//!< Target type handled (below 'WII_DRIVER_MAX_TARGETS').
+	uint8_t											id[WII_LIB_ID_LENGTH];							//!< Identifier reported by the target.
+	uint8_t											addr;											//!< Address the target answers at once configured.
+	uint8_t											flags;											//!< Combination of 'WII_DRIVER_FLAG_*'.
+	WiiDriver_Configure								configure;										//!< Selects the configuration messages (NULL == standard messages).
+	WiiDriver_Decode								decode;											//!< Decodes a status frame.
+	WiiDriver_FrameLength							frameLength;									//!< Length of the status frame per report profile (NULL == 'WII_LIB_PARAM_RESPONSE_LEN_DEFAULT' for 'WII_LIB_REPORT_STANDARD' only).
+	WiiDriver_Thresholds							thresholds;										//!< Activity thresholds used by the adaptive scheduler (NULL == any change counts as activity).
+} WiiDriver;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+WII_LIB_RC			WiiDriver_Register(			const WiiDriver *driver			);
+const WiiDriver *	WiiDriver_FindById(			const uint8_t *id				);
+const WiiDriver *	WiiDriver_FindByTarget(		WII_LIB_TARGET_DEVICE target	);
+
+
+#endif	// __WII_DRIVER__
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, types, and functions for the optional input event 
+//!					queue of the "wii" library module.
+//!	
+//!	@details		Instead of polling 'interfaceCurrent' and comparing frames, an application can 
+//!					attach an event source to each device (see 'WiiEvents_Attach()'). Every status 
+//!					frame published is compared against the values last reported by the source and 
+//!					an event (device, control, previous/new value, and timestamp) is queued for each 
+//!					button that changed and each analog control that moved beyond its threshold. 
+//!					Only the controls flagged in 'WiiLib_Device{}.changedMask' (plus any still 
+//!					pending) are compared, so a frame where nothing changed costs a single test.
+//!	
+//!					The queue is a fixed size ring with a single producer (the context decoding 
+//!					status frames: main loop or I2C interrupt) and a single consumer (normally the 
+//!					main loop). 'tail' is only modified by the producer and 'head' only by the 
+//!					consumer, so no critical sections are needed. Any number of sources may share 
+//!					a queue as long as their devices are all serviced from the same context.
+//!	
+//!	@note			When the queue is full the event is counted in 'overflowCount' and the change 
+//!					is kept pending (the value last reported is left as is), so it is queued again 
+//!					by the next frame once the consumer catches up (and counted again by every 
+//!					frame that finds the queue still full).
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_EVENTS__
+#define	__WII_EVENTS__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_EVENTS_QUEUE_DEPTH						32												//!< Number of events a queue can hold. Must be a power of two no greater than 128.
+#define	WII_EVENTS_DEFAULT_THRESHOLD				0												//!< Default threshold of every analog control (any change is reported).
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+struct _WiiLib_Device;
+
+typedef uint32_t (*WiiEvents_Clock)( void );														//!< Returns the current time in microseconds (free-running counter) used to timestamp events.
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines a single input event.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiEvents_Event
+{
+	uint32_t										timestampUs;									//!< Time the frame holding the change was decoded (see 'WiiEvents_Clock').
+	int16_t											previous;										//!< Value last reported for the control (0 or 1 for buttons).
+	int16_t											value;											//!< New value of the control (0 or 1 for buttons).
+	uint8_t											device;											//!< Identifier of the device given to 'WiiEvents_Attach()'.
+	uint8_t											control;										//!< Control that changed (button bit position or 'WII_LIB_CONTROL').
+} WiiEvents_Event;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines a queue of input events.
+//!	
+//!	@details		Single producer (decode path) / single consumer (application). 'tail' is only 
+//!					modified by the producer and 'head' only by the consumer.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiEvents_Queue
+{
+	WiiEvents_Event									events[WII_EVENTS_QUEUE_DEPTH];					//!< Ring of queued events.
+	volatile uint8_t								head;											//!< Index of the next event to consume.
+	volatile uint8_t								tail;											//!< Index at which the next event is queued.
+	volatile uint32_t								overflowCount;									//!< Number of events that could not be queued (queue full).
+	WiiEvents_Clock									clock;											//!< Source of event timestamps (NULL == timestamps are zero).
+} WiiEvents_Queue;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Tracks the values last reported for a single device.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiEvents_Source
+{
+	WiiEvents_Queue									*queue;											//!< Queue events are pushed to.
+	uint8_t											device;											//!< Identifier copied into every event.
+	uint8_t											primed;											//!< Flag indicating if 'reported' holds values from a frame (first frame only primes the source).
+	uint32_t										pending;										//!< Controls whose event could not be queued (queue full). Checked again by every frame until queued.
+	uint16_t										thresholds[WII_LIB_CONTROL_ANALOG_COUNT];		//!< Change (in counts) an analog control must exceed before an event is queued. Indexed by control - 'WII_LIB_BUTTON_COUNT'.
+	WiiLib_Interface								reported;										//!< Values last reported per control.
+} WiiEvents_Source;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+void			WiiEvents_Init(				WiiEvents_Queue *queue,		WiiEvents_Clock clock													);
+WII_LIB_RC		WiiEvents_Attach(			WiiEvents_Source *source,	WiiEvents_Queue *queue,		struct _WiiLib_Device *device,	uint8_t id	);
+WII_LIB_RC		WiiEvents_SetThreshold(		WiiEvents_Source *source,	WII_LIB_CONTROL control,	uint16_t threshold						);
+BOOL			WiiEvents_Pop(				WiiEvents_Queue *queue,		WiiEvents_Event *event												);
+uint8_t			WiiEvents_GetCount(			WiiEvents_Queue *queue																			);
+void			WiiEvents_ProcessDevice(	struct _WiiLib_Device *device																	);
+
+
+#endif	// __WII_EVENTS__
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, types, and functions for the optional orientation 
+//!					fusion stage of the "wii" library module.
+//!	
+//!	@details		Fuses accelerometer and gyroscope values into an orientation quaternion (and 
+//!					pitch/roll/yaw angles) using a complementary filter (Mahony style proportional 
+//!					correction) in fixed point. The filter is updated incrementally with each status 
+//!					frame published for an attached device (see 'WiiFusion_Attach()'):
+//!						-	Gyroscope data (Wii Motion Plus targets) is integrated every update.
+//!						-	Accelerometer data (nunchuck targets) pulls pitch and roll towards 
+//!							gravity. Without a gyroscope a much larger gain is used so the filter 
+//!							tracks the accelerometer (yaw is then not observable and should be 
+//!							ignored).
+//!	
+//!					Axes follow the right-handed convention of the nunchuck accelerometer (x right, 
+//!					y forward, z up). Pitch, roll, and yaw are rotations about x, y, and z (matching 
+//!					'gyroX', 'gyroY', and 'gyroZ').
+//!	
+//!	@note			No floating point is used. Products are formed in 64 bits which the PIC32 
+//!					multiplier produces in a single instruction.
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_FUSION__
+#define	__WII_FUSION__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_FUSION_Q_BITS							30												//!< Fractional bits of quaternion components.
+#define	WII_FUSION_Q_ONE							((int32_t)1 << WII_FUSION_Q_BITS)				//!< Quaternion component value representing 1.0.
+#define	WII_FUSION_ANGLE_FRACTION_BITS				6												//!< Fractional bits of pitch/roll/yaw (degrees).
+#define	WII_FUSION_MAX_PERIOD_US					50000											//!< Longest update period supported (longer periods overflow the gyroscope step).
+
+#define	WII_FUSION_ACCEL_ZERO						512												//!< Accelerometer reading at 0 g (10-bit readings).
+#define	WII_FUSION_GAIN_SHIFT_GYRO					7												//!< Accelerometer correction per update is the error / 2^shift when a gyroscope is present.
+#define	WII_FUSION_GAIN_SHIFT_ACCEL_ONLY			2												//!< Accelerometer correction per update is the error / 2^shift without a gyroscope.
+
+// Half-angle (radians, 'WII_FUSION_Q_BITS' fractional bits) turned per gyroscope count 
+// ('WII_MOTION_PLUS_GYRO_FRACTION_BITS' deg/s) per microsecond, multiplied by 2^16. Scaled by the 
+// update period in 'WiiFusion_SetPeriod()'.
+#define	WII_FUSION_GYRO_SCALE						76760L											//!< (pi / 180) / 2^3 / 2 / 10^6 * 2^30 * 2^16.
+
+// Sources of data fused by an update ('WiiFusion_Update()').
+#define	WII_FUSION_SOURCE_ACCEL						0x01											//!< Accelerometer values ('accelX/Y/Z') are valid.
+#define	WII_FUSION_SOURCE_GYRO						0x02											//!< Gyroscope values ('gyroX/Y/Z') are valid.
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+struct _WiiLib_Device;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Orientation estimate maintained by the fusion stage.
+//!	
+//!	@details		'q0' is the scalar part of the quaternion. The quaternion rotates vectors from 
+//!					the device frame into the world frame (identity == device held level).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiFusion_State
+{
+	int32_t											q0;												//!< Quaternion scalar component ('WII_FUSION_Q_BITS' fractional bits).
+	int32_t											q1;												//!< Quaternion x component ('WII_FUSION_Q_BITS' fractional bits).
+	int32_t											q2;												//!< Quaternion y component ('WII_FUSION_Q_BITS' fractional bits).
+	int32_t											q3;												//!< Quaternion z component ('WII_FUSION_Q_BITS' fractional bits).
+	int16_t											pitch;											//!< Rotation about the x-axis in degrees ('WII_FUSION_ANGLE_FRACTION_BITS' fractional bits).
+	int16_t											roll;											//!< Rotation about the y-axis in degrees ('WII_FUSION_ANGLE_FRACTION_BITS' fractional bits).
+	int16_t											yaw;											//!< Rotation about the z-axis in degrees ('WII_FUSION_ANGLE_FRACTION_BITS' fractional bits).
+	int32_t											gyroStep;										//!< Half-angle turned per gyroscope count per update (see 'WiiFusion_SetPeriod()').
+	uint8_t											sources;										//!< Sources fused by the most recent update ('WII_FUSION_SOURCE_*').
+	uint32_t										periodUs;										//!< Nominal update period in microseconds (see 'WiiFusion_Init()').
+	uint32_t										lastUs;											//!< Timestamp of the most recent timed update (see 'WiiFusion_ProcessDevice()').
+	uint8_t											timed;											//!< Flag indicating if 'lastUs' holds the timestamp of the previous update.
+	uint32_t										updates;										//!< Number of updates applied (diagnostic).
+} WiiFusion_State;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+void			WiiFusion_Init(				WiiFusion_State *fusion,	uint32_t periodUs													);
+void			WiiFusion_SetPeriod(		WiiFusion_State *fusion,	uint32_t periodUs													);
+WII_LIB_RC		WiiFusion_Attach(			WiiFusion_State *fusion,	struct _WiiLib_Device *device										);
+void			WiiFusion_Update(			WiiFusion_State *fusion,	const WiiLib_Interface *interface,	uint8_t sources					);
+void			WiiFusion_ProcessDevice(	struct _WiiLib_Device *device,	BOOL timed,						uint32_t timestampUs			);
+
+
+#endif	// __WII_FUSION__
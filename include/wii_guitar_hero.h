@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, macros, and constant functions available for the 
+//!					"Guitar Hero" (guitar and drums) and "DJ Hero" (turntable) support.
+//!	
+//!	@details		These extensions share the frame layout of the classic controller: a left 
+//!					joystick in bytes 0 - 1 and active low buttons in bytes 4 - 5 (see 
+//!					'WII_LIB_BUTTON_*'). Their other analog controls are mapped onto the members of 
+//!					'WiiLib_Interface{}' left free:
+//!	
+//!					| Target	| analogRightX		| analogRightY		| triggerLeft	| triggerRight	| 
+//!					|-----------|-------------------|-------------------|---------------|---------------| 
+//!					| Guitar	| Touch bar (5-bit)	| -					| -				| Whammy (5-bit)| 
+//!					| Drums		| -					| -					| Pad hit		| Hit velocity	| 
+//!					| Turntable	| Left turntable	| Right turntable	| Cross fader	| Effect dial	|
+//!	
+//!					Turntable speeds are signed (-32 - 31, positive == clockwise). A drum hit 
+//!					reports the pad (see 'WII_GUITAR_HERO_DRUMS_PAD_*') and its velocity (0 - 7, 
+//!					7 == hardest); the velocity reads zero when the frame carries none.
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically. The targets are handled 
+//!					through the driver registry (see "wii_driver.h").
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_GUITAR_HERO__
+#define	__WII_GUITAR_HERO__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => IDENTIFIERS
+//--------------------------------------------------------------------------------------------------
+#define	WII_GUITAR_HERO_ID_GUITAR					{ 0x00, 0x00, 0xA4, 0x20, 0x01, 0x03 }			//!< Identifier read when device is a Guitar Hero guitar.
+#define	WII_GUITAR_HERO_ID_DRUMS					{ 0x01, 0x00, 0xA4, 0x20, 0x01, 0x03 }			//!< Identifier read when device is a Guitar Hero (World Tour) drum kit.
+#define	WII_GUITAR_HERO_ID_TURNTABLE				{ 0x03, 0x00, 0xA4, 0x20, 0x01, 0x03 }			//!< Identifier read when device is a DJ Hero turntable.
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => THRESHOLDS
+//--------------------------------------------------------------------------------------------------
+// NOTE:	Used by the adaptive scheduler to tell activity from noise between frames (see 
+//			"wii_scheduler.h"). Any change of the drum pad counts (it names the pad hit).
+#define	WII_GUITAR_HERO_THRESHOLD_ANALOG			15												//!< Change of the joystick (either axis) to consider it active. Has a range of ~60 (15 ~= 25% of range of movement).
+#define	WII_GUITAR_HERO_THRESHOLD_TOUCH_BAR			8												//!< Change of the guitar touch bar to consider it active. Has a range of ~30 (8 ~= 25% of range of movement).
+#define	WII_GUITAR_HERO_THRESHOLD_WHAMMY			8												//!< Change of the guitar whammy bar to consider it active. Has a range of ~30 (8 ~= 25% of range of movement).
+#define	WII_GUITAR_HERO_THRESHOLD_VELOCITY			2												//!< Change of the drum hit velocity to consider it active. Has a range of 8 (2 == 25% of range).
+#define	WII_GUITAR_HERO_THRESHOLD_TURNTABLE			8												//!< Change of either turntable speed to consider it active. Has a range of -32 - 31 (8 == 25% of the speed in either direction).
+#define	WII_GUITAR_HERO_THRESHOLD_FADER				4												//!< Change of the turntable cross fader to consider it active. Has a range of 16 (4 == 25% of range of movement).
+#define	WII_GUITAR_HERO_THRESHOLD_DIAL				8												//!< Change of the turntable effect dial to consider it active. Has a range of 32 (8 == 25% of range of movement).
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => BUTTONS
+//--------------------------------------------------------------------------------------------------
+// Names of the buttons of each target in terms of 'WII_LIB_BUTTON_*' (same bit in the frame).
+#define	WII_GUITAR_HERO_GUITAR_STRUM_UP				WII_LIB_BUTTON_DPAD_UP							//!< Strum bar up.
+#define	WII_GUITAR_HERO_GUITAR_STRUM_DOWN			WII_LIB_BUTTON_DPAD_DOWN						//!< Strum bar down.
+#define	WII_GUITAR_HERO_GUITAR_GREEN				WII_LIB_BUTTON_A								//!< Green fret.
+#define	WII_GUITAR_HERO_GUITAR_RED					WII_LIB_BUTTON_B								//!< Red fret.
+#define	WII_GUITAR_HERO_GUITAR_YELLOW				WII_LIB_BUTTON_X								//!< Yellow fret.
+#define	WII_GUITAR_HERO_GUITAR_BLUE					WII_LIB_BUTTON_Y								//!< Blue fret.
+#define	WII_GUITAR_HERO_GUITAR_ORANGE				WII_LIB_BUTTON_ZL								//!< Orange fret.
+
+#define	WII_GUITAR_HERO_DRUMS_GREEN					WII_LIB_BUTTON_A								//!< Green pad.
+#define	WII_GUITAR_HERO_DRUMS_RED					WII_LIB_BUTTON_B								//!< Red pad.
+#define	WII_GUITAR_HERO_DRUMS_YELLOW				WII_LIB_BUTTON_Y								//!< Yellow cymbal.
+#define	WII_GUITAR_HERO_DRUMS_BLUE					WII_LIB_BUTTON_X								//!< Blue pad.
+#define	WII_GUITAR_HERO_DRUMS_ORANGE				WII_LIB_BUTTON_ZL								//!< Orange cymbal.
+#define	WII_GUITAR_HERO_DRUMS_BASS					WII_LIB_BUTTON_ZR								//!< Bass pedal.
+
+#define	WII_GUITAR_HERO_TURNTABLE_LEFT_GREEN		WII_LIB_BUTTON_X								//!< Green button of the left turntable.
+#define	WII_GUITAR_HERO_TURNTABLE_LEFT_RED			WII_LIB_BUTTON_LEFT_TRIGGER						//!< Red button of the left turntable.
+#define	WII_GUITAR_HERO_TURNTABLE_LEFT_BLUE			WII_LIB_BUTTON_ZL								//!< Blue button of the left turntable.
+#define	WII_GUITAR_HERO_TURNTABLE_RIGHT_GREEN		WII_LIB_BUTTON_Y								//!< Green button of the right turntable.
+#define	WII_GUITAR_HERO_TURNTABLE_RIGHT_RED			WII_LIB_BUTTON_RIGHT_TRIGGER					//!< Red button of the right turntable.
+#define	WII_GUITAR_HERO_TURNTABLE_RIGHT_BLUE		WII_LIB_BUTTON_ZR								//!< Blue button of the right turntable.
+#define	WII_GUITAR_HERO_TURNTABLE_EUPHORIA			WII_LIB_BUTTON_A								//!< Euphoria button.
+#define	WII_GUITAR_HERO_TURNTABLE_BUTTONS			0xBC36											//!< Mask of the bits holding turntable buttons (others are analog bits).
+
+// Pad reported by a drum hit ('triggerLeft').
+#define	WII_GUITAR_HERO_DRUMS_PAD_BASS				0x1B											//!< Bass pedal.
+#define	WII_GUITAR_HERO_DRUMS_PAD_RED				0x19											//!< Red pad.
+#define	WII_GUITAR_HERO_DRUMS_PAD_YELLOW			0x11											//!< Yellow cymbal.
+#define	WII_GUITAR_HERO_DRUMS_PAD_BLUE				0x0F											//!< Blue pad.
+#define	WII_GUITAR_HERO_DRUMS_PAD_ORANGE			0x0E											//!< Orange cymbal.
+#define	WII_GUITAR_HERO_DRUMS_PAD_GREEN				0x12											//!< Green pad.
+#define	WII_GUITAR_HERO_DRUMS_PAD_NONE				0x1F											//!< No hit reported.
+
+// Byte and mask of the flag set when a drum frame carries no hit velocity.
+#define	WII_GUITAR_HERO_DRUMS_NO_VELOCITY_BYTE		2												//!< Byte holding the flag.
+#define	WII_GUITAR_HERO_DRUMS_NO_VELOCITY_MASK		0x40											//!< Mask of the flag.
+
+// Turntable speeds are 6-bit two's complement values.
+#define	WII_GUITAR_HERO_TURNTABLE_SIGN				0x20											//!< Sign bit of a turntable speed.
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => STATUS FIELD DESCRIPTORS
+//--------------------------------------------------------------------------------------------------
+// Layout of the status frames expressed as tables of field descriptors (see "wii_lib.h" for column 
+// details). Buttons share the rows of the classic controller.
+//
+//		X(	destination,	op,	byte,	shift,	width,	destShift,	invert	)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Status frame fields of a Guitar Hero guitar.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_GUITAR_HERO_FIELDS_GUITAR(X)																\
+	X(	analogLeftX,		=,		0,		0,		6,		0,		0x00	)							\
+	X(	analogLeftY,		=,		1,		0,		6,		0,		0x00	)							\
+	X(	analogRightX,		=,		2,		0,		5,		0,		0x00	)		/* touch bar */		\
+	X(	triggerRight,		=,		3,		0,		5,		0,		0x00	)		/* whammy */		\
+	WII_CLASSIC_CONTROLLER_FIELDS_BUTTONS(X)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Status frame fields of a Guitar Hero drum kit.
+//!	
+//!	@note			The velocity is sent as a softness (7 == softest) and inverted while decoding.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_GUITAR_HERO_FIELDS_DRUMS(X)																	\
+	X(	analogLeftX,		=,		0,		0,		6,		0,		0x00	)							\
+	X(	analogLeftY,		=,		1,		0,		6,		0,		0x00	)							\
+	X(	triggerLeft,		=,		2,		1,		5,		0,		0x00	)		/* pad */			\
+	X(	triggerRight,		=,		3,		5,		3,		0,		0xFF	)		/* velocity */		\
+	WII_CLASSIC_CONTROLLER_FIELDS_BUTTONS(X)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Status frame fields of a DJ Hero turntable.
+//!	
+//!	@note			Bit 0 of byte 4 holds the sign of the left turntable instead of a fixed bit. 
+//!					Buttons not fitted are masked off with 'WII_GUITAR_HERO_TURNTABLE_BUTTONS'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_GUITAR_HERO_FIELDS_TURNTABLE(X)																\
+	X(	analogLeftX,		=,		0,		0,		6,		0,		0x00	)							\
+	X(	analogLeftY,		=,		1,		0,		6,		0,		0x00	)							\
+	X(	analogRightX,		=,		3,		0,		5,		0,		0x00	)							\
+	X(	analogRightX,		|=,		4,		0,		1,		5,		0x00	)		/* sign */			\
+	X(	analogRightY,		=,		2,		7,		1,		0,		0x00	)							\
+	X(	analogRightY,		|=,		1,		6,		2,		1,		0x00	)							\
+	X(	analogRightY,		|=,		0,		6,		2,		3,		0x00	)							\
+	X(	analogRightY,		|=,		2,		0,		1,		5,		0x00	)		/* sign */			\
+	X(	triggerLeft,		=,		2,		1,		4,		0,		0x00	)		/* fader */			\
+	X(	triggerRight,		=,		3,		5,		3,		0,		0x00	)		/* dial */			\
+	X(	triggerRight,		|=,		2,		5,		2,		3,		0x00	)		/* dial */			\
+	WII_CLASSIC_CONTROLLER_FIELDS_BUTTONS(X)
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+WII_LIB_RC			WiiGuitarHero_ProcessGuitar(	WiiLib_Device *device	);
+WII_LIB_RC			WiiGuitarHero_ProcessDrums(		WiiLib_Device *device	);
+WII_LIB_RC			WiiGuitarHero_ProcessTurntable(	WiiLib_Device *device	);
+const uint16_t *	WiiGuitarHero_GetThresholds(	WiiLib_Device *device	);
+
+
+#endif	// __WII_GUITAR_HERO__
@@ -6,6 +6,10 @@
 //!	
 //!	@note			This is the core header file for the Wii library support (includes all other 
 //!					"wii_...h" header files).
+//!	
+//!	@note			Only 'WiiLib_InitNonBlocking()' and 'WiiLib_Service()' are non-blocking. Every 
+//!					other function that talks to the target (including 'WiiLib_ConfigureDevice()' 
+//!					and 'WiiLib_ConnectToTarget()') blocks on the bus and sleeps through its delays.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #ifndef __WII_LIB__
 #define	__WII_LIB__
@@ -16,6 +20,7 @@
 //--------------------------------------------------------------------------------------------------
 #include <stdint.h>
 #include "i2c.h"
+#include "wii_backend.h"
 
 
 
@@ -23,6 +28,13 @@
 //==================================================================================================
 //	CONSTANTS => GENERAL
 //--------------------------------------------------------------------------------------------------
+// Library version. Until v1.0.0 the minor version is bumped by every release that breaks source 
+// compatibility (see "Changelog.md" for migration notes).
+#define	WII_LIB_VERSION_MAJOR						0												//!< Major version of the library.
+#define	WII_LIB_VERSION_MINOR						2												//!< Minor version of the library (v0.2.0 replaced the individual button fields of 'WiiLib_Interface').
+#define	WII_LIB_VERSION_PATCH						0												//!< Patch version of the library.
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //!	@brief			Enum of return code values.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -37,18 +49,29 @@ typedef enum _WII_LIB_RC
 	WII_LIB_RC_UNKOWN_PARAMETER						= 6,											//!< Parameter requested is unknown to this library.
 	WII_LIB_RC_DATA_RECEIVED_IS_INVALID				= 7,											//!< Data received from target device but value(s) is(are) invalid.
 	WII_LIB_RC_UNABLE_TO_DECRYPT_DATA_RECEIVED		= 8,											//!< Unable to decrypt data received over I2C.
-	WII_LIB_RC_DEVICE_DISABLED						= 9,											//!< Device instance is disabled (too many errors).
-	WII_LIB_RC_RELATIVE_POSITION_FEATURE_DISABLED	= 10											//!< Relative position feature disabled presently.
+	WII_LIB_RC_DEVICE_DISABLED						= 9,											//!< Device instance is disabled (see 'WII_LIB_DEVICE_STATUS_DISABLED').
+	WII_LIB_RC_RELATIVE_POSITION_FEATURE_DISABLED	= 10,											//!< Relative position feature disabled presently.
+	WII_LIB_RC_PENDING								= 11,											//!< Non-blocking operation still in progress (no new data yet). Invoke 'WiiLib_Service()' again later.
+	WII_LIB_RC_QUEUE_FULL							= 12,											//!< Transaction queue cannot accept another transfer.
+	WII_LIB_RC_TARGET_DISCONNECTED					= 13											//!< Target presumed unplugged. Probed for on a backoff schedule (see 'WII_LIB_DEVICE_STATUS_DISCONNECTED').
 } WII_LIB_RC;
 
-#define	WII_LIB_DEFAULT_CALCULATE_RELATIVE_POSITION	TRUE											//!< Default value for flag controlling whether or not relative position is automatically calculated.
+#define	WII_LIB_RC_COUNT							14												//!< Number of return codes defined above.
 
-#define	WII_LIB_MAX_CONNECTION_ATTEMPTS				1												//!< Maximum number of connection attempts to try during initialization before presuming device not available. Used during initializatoin. May not exceed 255.
+#define	WII_LIB_DEFAULT_CALCULATE_RELATIVE_POSITION	TRUE											//!< Default value for flag controlling whether or not relative position is automatically calculated.
 
 // Limits used when monitoring error counts and determining any graceful recovery attempts that 
 // should be attempted.
 #define	WII_LIB_MAX_FAILURES_BEFORE_RECONFIGURING	3												//!< Number of failed I2C communication attempts before attempting to reconfigure the target device.
-#define	WII_LIB_MAX_FAILURES_BEFORE_DISABLING		100												//!< Number of failed I2C communication attempts before disabling communication with the target device.
+#define	WII_LIB_MAX_FAILURES_BEFORE_DISCONNECTING	8												//!< Number of consecutive failed queries (NAKs or 'not ready' frames) before the target is presumed unplugged and probed for instead (see 'WII_LIB_DEVICE_STATUS_DISCONNECTED').
+#define	WII_LIB_PROBE_MAX_SKIPPED_CALLS				256												//!< Most calls to 'WiiLib_DoMaintenance()' skipped between probes for a disconnected target (it has no time base, so its backoff counts calls).
+#define	WII_LIB_MAX_FRAME_RETRIES					2												//!< Status frames re-read straight away by a non-blocking poll after a frame is rejected (see 'WII_LIB_FRAME').
+
+// Per-device statistics (see "wii_stats.h"). Compiled out entirely unless enabled (e.g. 
+// '-DWII_LIB_STATS=1').
+#ifndef WII_LIB_STATS
+#define	WII_LIB_STATS								0												//!< Set to 1 to compile in the optional statistics block.
+#endif
 
 
 
@@ -66,7 +89,8 @@ typedef enum _WII_LIB_DEVICE_STATUS
 	WII_LIB_DEVICE_STATUS_NOT_INITIALIZED			= 1,											//!< Target device needs to be initialized.
 	WII_LIB_DEVICE_STATUS_CONFIGURING 				= 2,											//!< Target device needs to be (re)configured.
 	WII_LIB_DEVICE_STATUS_ACTIVE 					= 3,											//!< Target device is operating as expected.
-	WII_LIB_DEVICE_STATUS_DISABLED 					= 4												//!< Too many failures have occurred. Target device is disabled (no communication permitted without re-initializing.
+	WII_LIB_DEVICE_STATUS_DISABLED 					= 4,											//!< Communication disabled by the application (no communication permitted without re-initializing). Never entered by the library itself.
+	WII_LIB_DEVICE_STATUS_DISCONNECTED				= 5												//!< Target presumed unplugged (too many consecutive failures or failed connection attempt). Probed for with an exponential backoff and re-identified once it answers.
 } WII_LIB_DEVICE_STATUS;
 
 
@@ -83,14 +107,21 @@ typedef enum _WII_LIB_TARGET_DEVICE
 	WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER		= 2,											//!< Wii target type == Classic Controller.
 	WII_LIB_TARGET_DEVICE_MOTION_PLUS				= 3,											//!< Wii target type == Wii Motion Plus.
 	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK	= 4,											//!< Wii target type == Wii Motion Plus that is passing through the Wii Nunchuck.
-	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC	= 5												//!< Wii target type == Wii Motion Plus that is passing through the Wii Classic Controller.
+	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC	= 5,											//!< Wii target type == Wii Motion Plus that is passing through the Wii Classic Controller.
+	WII_LIB_TARGET_DEVICE_GUITAR					= 6,											//!< Wii target type == Guitar Hero guitar.
+	WII_LIB_TARGET_DEVICE_DRUMS						= 7,											//!< Wii target type == Guitar Hero (World Tour) drums.
+	WII_LIB_TARGET_DEVICE_TURNTABLE					= 8,											//!< Wii target type == DJ Hero turntable.
+	WII_LIB_TARGET_DEVICE_CUSTOM					= 16											//!< First target type available to drivers registered by the application (see 'WiiDriver_Register()').
 } WII_LIB_TARGET_DEVICE;
 
 
-// Define byte identifiers that are associated with each target device type.
+// Define byte identifiers that are associated with each target device type. Identifiers are matched 
+// through the driver registry (see "wii_driver.h"); drivers for other targets keep theirs in their 
+// own header (e.g. "wii_guitar_hero.h").
 #define	WII_LIB_ID_LENGTH							6												//!< Length (in bytes) for a ID read from a target device.
 #define	WII_LIB_ID_NUNCHUCK							{ 0x00, 0x00, 0xA4, 0x20, 0x00, 0x00 }			//!< Identifier read when device is Wii Nunchuck.
 #define	WII_LIB_ID_CLASSIC_CONTROLLER				{ 0x00, 0x00, 0xA4, 0x20, 0x01, 0x01 }			//!< Identifier read when device is Wii Classic Controller.
+#define	WII_LIB_ID_CLASSIC_CONTROLLER_HIGH_RES		{ 0x00, 0x00, 0xA4, 0x20, 0x03, 0x01 }			//!< Identifier read when device is Wii Classic Controller using the high-resolution data format.
 #define	WII_LIB_ID_WII_MOTION_PLUS					{ 0x00, 0x00, 0xA4, 0x20, 0x04, 0x05 }			//!< Identifier read when device is Wii Motion Plus.
 #define	WII_LIB_ID_WII_MOTION_PLUS_PASS_NUNCHUCK	{ 0x00, 0x00, 0xA4, 0x20, 0x05, 0x05 }			//!< Identifier read when device is Wii Motion Plus passing through the Wii Nunchuck.
 #define	WII_LIB_ID_WII_MOTION_PLUS_PASS_CLASSIC		{ 0x00, 0x00, 0xA4, 0x20, 0x07, 0x05 }			//!< Identifier read when device is Wii Motion Plus passing through the Wii Classic Controller.
@@ -105,7 +136,7 @@ typedef enum _WII_LIB_TARGET_DEVICE
 typedef enum _WII_LIB_I2C_ADDR
 {
 	WII_LIB_I2C_ADDR_STANDARD						= 0x52,											//!< Standard I2C address for Wii extension controllers. The same address is used across most devices.
-	WII_LIB_I2C_ADDR_WII_MOTION_PLUS				= 0x53											//!< I2C address for Wii Motion Plus.
+	WII_LIB_I2C_ADDR_WII_MOTION_PLUS				= 0x53											//!< I2C address for an inactive Wii Motion Plus (answers at 'WII_LIB_I2C_ADDR_STANDARD' once activated).
 } WII_LIB_I2C_ADDR;
 
 
@@ -117,6 +148,7 @@ typedef enum _WII_LIB_PARAM
 {
 	WII_LIB_PARAM_STATUS							= 0x00,											//!< Parameter ID (register address) for querying the status flags from a target device.
 	WII_LIB_PARAM_RAW_DATA							= 0x20,											//!< Parameter ID (register address) for querying raw data from a target dvice.
+	WII_LIB_PARAM_CALIBRATION_CHECKSUM				= 0x2E,											//!< Parameter ID (register address) for querying the checksum bytes at the end of the calibration block (see "wii_calibration.h").
 	WII_LIB_PARAM_DEVICE_TYPE						= 0xFA											//!< Parameter ID (register address) for querying the device identifier from a target device.
 } WII_LIB_PARAM;
 
@@ -125,6 +157,58 @@ typedef enum _WII_LIB_PARAM
 #define	WII_LIB_PARAM_RESPONSE_LEN_EXTENDED			20												//!< Number of bytes to read for long parameter queries
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the report profiles selecting the part of the status frame read by 
+//!					status queries (see 'WiiLib_SetReport()').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _WII_LIB_REPORT
+{
+	WII_LIB_REPORT_STANDARD							= 0,											//!< Full status frame ('WII_LIB_PARAM_RESPONSE_LEN_DEFAULT' bytes). All interface values are updated.
+	WII_LIB_REPORT_BUTTONS							= 1,											//!< Only the bytes holding the buttons. Other interface values keep their last value.
+	WII_LIB_REPORT_HIGH_RESOLUTION					= 2												//!< Full status frame in the high-resolution data format (classic controller only). 8-bit joysticks and triggers.
+} WII_LIB_REPORT;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the verdicts given to each response validated (see 
+//!					'WiiLib_Device{}.frame').
+//!	
+//!	@details		'not ready' and 'all zero' are checked on the bytes as read (before decrypting) 
+//!					for every response of at least 'WII_LIB_PARAM_RESPONSE_LEN_DEFAULT' bytes. 
+//!					'reserved' and 'repeated' are checked on decrypted status frames only. Rejected 
+//!					frames (every verdict from 'WII_LIB_FRAME_NOT_READY' on) are not decoded and 
+//!					count as a failed query.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _WII_LIB_FRAME
+{
+	WII_LIB_FRAME_VALID								= 0,											//!< Frame accepted.
+	WII_LIB_FRAME_REPEATED							= 1,											//!< Frame accepted but identical to the previous one (idle controls or a stuck register pointer).
+	WII_LIB_FRAME_NOT_READY							= 2,											//!< Rejected: all bytes read as 0xFF (target not configured or no data ready).
+	WII_LIB_FRAME_ALL_ZERO							= 3,											//!< Rejected: all bytes read as 0x00 (data line held low, e.g. a half inserted connector).
+	WII_LIB_FRAME_RESERVED							= 4												//!< Rejected: bits fixed by the frame layout hold an impossible value (see the '*_FIXED_*' constants of the target).
+} WII_LIB_FRAME;
+
+#define	WII_LIB_FRAME_COUNT							5												//!< Number of verdicts defined above.
+
+// Encrypted data is decrypted as x = (x [xor] xorKey[n]) + addKey[n] where 'n' is the register 
+// address of the byte modulo the period. Both tables hold 'WII_LIB_CIPHER_KEY_DEFAULT' for the key 
+// written by the basic (0x40) initialization.
+#define	WII_LIB_CIPHER_PERIOD						8												//!< Number of register addresses before the decryption tables repeat.
+#define	WII_LIB_CIPHER_KEY_DEFAULT					0x17											//!< Value of every decryption table entry for the default (all zero) key.
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => I2C MULTIPLEXERS
+//--------------------------------------------------------------------------------------------------
+// Every extension answers at 'WII_LIB_I2C_ADDR_STANDARD'. Multiple targets on a single module must 
+// sit behind TCA9548A style multiplexers (single control byte == bitmask of open channels).
+#define	WII_LIB_MUX_NONE							0x00											//!< Multiplexer address indicating the target is wired directly to the bus.
+#define	WII_LIB_MUX_UNKNOWN							0xFF											//!< Multiplexer address indicating the channel open on the bus is unknown (forces a reselect).
+#define	WII_LIB_MUX_CHANNELS						8												//!< Number of channels available on a multiplexer.
+
+
 
 
 //==================================================================================================
@@ -132,8 +216,10 @@ typedef enum _WII_LIB_PARAM
 //--------------------------------------------------------------------------------------------------
 #define	WII_LIB_DELAY_I2C_SETTLE_TIME_MS			10												//!< Time to delay in milliseconds after initializing the I2C bus before sending any traffic.
 #define	WII_LIB_DELAY_AFTER_CONFIRM_ID_MS			10												//!< Time to delay in milliseconds after confirming the target device ID and before determining the home position.
-#define	WII_LIB_DELAY_AFTER_CONNECTION_ATTEMPT_MS	500												//!< Time to delay in milliseconds after a failed connection attempt (before next attempt in the initialization function).
+#define	WII_LIB_DELAY_PROBE_MIN_MS					100												//!< Time to wait in milliseconds after the first failed probe for a disconnected target (doubles with every probe that fails).
+#define	WII_LIB_DELAY_PROBE_MAX_MS					3200											//!< Longest time to wait in milliseconds between probes for a disconnected target.
 #define	WII_LIB_DELAY_AFTER_CONFIG_MESSAGE_MS		20												//!< Time to delay in milliseconds after after sending a configuration message to the target.
+#define	WII_LIB_DELAY_FRAME_RETRY_MS				1												//!< Time to wait in milliseconds before re-reading a rejected status frame (see 'WII_LIB_MAX_FRAME_RETRIES'). Shorter than 'WII_LIB_I2C_DELAY_POST_READ_MS' so a retry costs little of the poll period.
 
 
 // The following delays are executed prior to raising the stop condition on the bus.
@@ -142,6 +228,156 @@ typedef enum _WII_LIB_PARAM
 #define	WII_LIB_I2C_DELAY_BETWEEN_TX_RX_MS			1												//!< Delay in milliseconds between sending a TX request and starting the following RX reqeust to read the reply.
 
 
+#define	WII_LIB_MS_TO_US(ms)						( (uint32_t)(ms) * 1000UL )						//!< Converts one of the millisecond delays above into microseconds (unit used by 'WiiLib_Service()').
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => NON-BLOCKING SERVICE
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the steps of the non-blocking state machine driven by 'WiiLib_Service()'.
+//!	
+//!	@details		Each invocation of 'WiiLib_Service()' executes at most one I2C transaction. All 
+//!					delays required by the target are tracked as deadlines instead of sleeping.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _WII_LIB_SERVICE_STATE
+{
+	WII_LIB_SERVICE_STATE_SETTLE					= 0,											//!< I2C port just initialized. Waiting for the bus to settle before sending any traffic.
+	WII_LIB_SERVICE_STATE_IDLE						= 1,											//!< No job in progress. Next job is selected based on the device status and error count.
+	WII_LIB_SERVICE_STATE_WAIT						= 2,											//!< Waiting for the deadline to pass before advancing to the next step.
+	WII_LIB_SERVICE_STATE_CONFIG_WRITE				= 3,											//!< Pushing out the next configuration message to the target.
+	WII_LIB_SERVICE_STATE_WRITE_POINTER				= 4,											//!< Writing the parameter ID (register address) to read from.
+	WII_LIB_SERVICE_STATE_READ						= 5,											//!< Reading and processing the response for the parameter.
+	WII_LIB_SERVICE_STATE_TRANSFER					= 6												//!< Waiting on the transaction queue to complete the transfer issued by 'step'.
+} WII_LIB_SERVICE_STATE;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the jobs the non-blocking state machine can be executing.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _WII_LIB_SERVICE_JOB
+{
+	WII_LIB_SERVICE_JOB_NONE						= 0,											//!< No job in progress.
+	WII_LIB_SERVICE_JOB_CONNECT						= 1,											//!< Connecting to the target (configure, confirm ID, and measure home position).
+	WII_LIB_SERVICE_JOB_POLL						= 2												//!< Polling the target status (optionally configuring the target first).
+} WII_LIB_SERVICE_JOB;
+
+
+#define	WII_LIB_SERVICE_MAX_TRANSFERS_PER_STEP		3												//!< Most transfers queued by a single step (close other multiplexer, select channel, and the transfer itself).
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => BUTTONS
+//--------------------------------------------------------------------------------------------------
+// Bit positions within 'WiiLib_Interface.buttons'. Bits 1 - 15 mirror the (inverted) layout of 
+// bytes 5 - 6 of a classic controller status frame so the classic decoder is two descriptors. Bit 0 
+// (unused by the classic controller) holds the nunchuck C button. The nunchuck Z button sets both 
+// ZL and ZR.
+#define	WII_LIB_BUTTON_C							( 1UL << 0 )									//!< C button.
+#define	WII_LIB_BUTTON_RIGHT_TRIGGER				( 1UL << 1 )									//!< Right trigger button (trigger fully pressed).
+#define	WII_LIB_BUTTON_PLUS							( 1UL << 2 )									//!< Plus [+] button.
+#define	WII_LIB_BUTTON_HOME							( 1UL << 3 )									//!< Home button.
+#define	WII_LIB_BUTTON_MINUS						( 1UL << 4 )									//!< Minus [-] button.
+#define	WII_LIB_BUTTON_LEFT_TRIGGER					( 1UL << 5 )									//!< Left trigger button (trigger fully pressed).
+#define	WII_LIB_BUTTON_DPAD_DOWN					( 1UL << 6 )									//!< Bottom d-pad button.
+#define	WII_LIB_BUTTON_DPAD_RIGHT					( 1UL << 7 )									//!< Right d-pad button.
+#define	WII_LIB_BUTTON_DPAD_UP						( 1UL << 8 )									//!< Top d-pad button.
+#define	WII_LIB_BUTTON_DPAD_LEFT					( 1UL << 9 )									//!< Left d-pad button.
+#define	WII_LIB_BUTTON_ZR							( 1UL << 10 )									//!< Right z button.
+#define	WII_LIB_BUTTON_X							( 1UL << 11 )									//!< X button.
+#define	WII_LIB_BUTTON_A							( 1UL << 12 )									//!< A button.
+#define	WII_LIB_BUTTON_Y							( 1UL << 13 )									//!< Y button.
+#define	WII_LIB_BUTTON_B							( 1UL << 14 )									//!< B button.
+#define	WII_LIB_BUTTON_ZL							( 1UL << 15 )									//!< Left z button.
+#define	WII_LIB_BUTTON_COUNT						16												//!< Number of button bits defined above.
+
+// Reads a single button as the individual fields removed in v0.2.0 did (1 == pressed). Pass the 
+// name without the prefix, e.g. 'iface.buttonA' becomes 'WII_LIB_BUTTON( &iface, A )' and 
+// 'iface.dpadLeft' becomes 'WII_LIB_BUTTON( &iface, DPAD_LEFT )'.
+#define	WII_LIB_BUTTON( iface, button )				( ((iface)->buttons & WII_LIB_BUTTON_##button) ? 1 : 0 )	//!< Flag indicating if a button is pressed.
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => CONTROLS
+//--------------------------------------------------------------------------------------------------
+// Identifiers of the individual controls within 'WiiLib_Interface'. Buttons are identified by 
+// their bit position (0 - 'WII_LIB_BUTTON_COUNT' - 1); the analog controls follow.
+typedef enum _WII_LIB_CONTROL
+{
+	WII_LIB_CONTROL_TRIGGER_LEFT					= WII_LIB_BUTTON_COUNT + 0,						//!< Left trigger ('triggerLeft').
+	WII_LIB_CONTROL_TRIGGER_RIGHT					= WII_LIB_BUTTON_COUNT + 1,						//!< Right trigger ('triggerRight').
+	WII_LIB_CONTROL_ANALOG_LEFT_X					= WII_LIB_BUTTON_COUNT + 2,						//!< Left analog joystick x-axis ('analogLeftX').
+	WII_LIB_CONTROL_ANALOG_LEFT_Y					= WII_LIB_BUTTON_COUNT + 3,						//!< Left analog joystick y-axis ('analogLeftY').
+	WII_LIB_CONTROL_ANALOG_RIGHT_X					= WII_LIB_BUTTON_COUNT + 4,						//!< Right analog joystick x-axis ('analogRightX').
+	WII_LIB_CONTROL_ANALOG_RIGHT_Y					= WII_LIB_BUTTON_COUNT + 5,						//!< Right analog joystick y-axis ('analogRightY').
+	WII_LIB_CONTROL_ACCEL_X							= WII_LIB_BUTTON_COUNT + 6,						//!< Accelerometer x-axis ('accelX').
+	WII_LIB_CONTROL_ACCEL_Y							= WII_LIB_BUTTON_COUNT + 7,						//!< Accelerometer y-axis ('accelY').
+	WII_LIB_CONTROL_ACCEL_Z							= WII_LIB_BUTTON_COUNT + 8,						//!< Accelerometer z-axis ('accelZ').
+	WII_LIB_CONTROL_GYRO_X							= WII_LIB_BUTTON_COUNT + 9,						//!< Gyroscope x-axis ('gyroX').
+	WII_LIB_CONTROL_GYRO_Y							= WII_LIB_BUTTON_COUNT + 10,					//!< Gyroscope y-axis ('gyroY').
+	WII_LIB_CONTROL_GYRO_Z							= WII_LIB_BUTTON_COUNT + 11						//!< Gyroscope z-axis ('gyroZ').
+} WII_LIB_CONTROL;
+
+#define	WII_LIB_CONTROL_ANALOG_COUNT				12												//!< Number of analog control identifiers.
+#define	WII_LIB_CONTROL_COUNT						(WII_LIB_BUTTON_COUNT + WII_LIB_CONTROL_ANALOG_COUNT)	//!< Number of control identifiers (buttons included).
+
+// Masks holding a bit per control identifier (see 'WiiLib_Device{}.changedMask'). Button bits match 
+// 'WiiLib_Interface.buttons'.
+#define	WII_LIB_CONTROL_BIT( control )				( 1UL << (control) )							//!< Bit of a single control.
+#define	WII_LIB_CONTROL_MASK_BUTTONS				( WII_LIB_CONTROL_BIT(WII_LIB_BUTTON_COUNT) - 1 )	//!< Bits of every button.
+#define	WII_LIB_CONTROL_MASK_ALL					( WII_LIB_CONTROL_BIT(WII_LIB_CONTROL_COUNT) - 1 )	//!< Bits of every control.
+
+// Analog controls paired with their 'WiiLib_Interface' member. Rows take the form X( control, member ).
+#define	WII_LIB_CONTROLS_ANALOG(X)																		\
+	X(	WII_LIB_CONTROL_TRIGGER_LEFT,		triggerLeft		)											\
+	X(	WII_LIB_CONTROL_TRIGGER_RIGHT,		triggerRight	)											\
+	X(	WII_LIB_CONTROL_ANALOG_LEFT_X,		analogLeftX		)											\
+	X(	WII_LIB_CONTROL_ANALOG_LEFT_Y,		analogLeftY		)											\
+	X(	WII_LIB_CONTROL_ANALOG_RIGHT_X,		analogRightX	)											\
+	X(	WII_LIB_CONTROL_ANALOG_RIGHT_Y,		analogRightY	)											\
+	X(	WII_LIB_CONTROL_ACCEL_X,			accelX			)											\
+	X(	WII_LIB_CONTROL_ACCEL_Y,			accelY			)											\
+	X(	WII_LIB_CONTROL_ACCEL_Z,			accelZ			)											\
+	X(	WII_LIB_CONTROL_GYRO_X,				gyroX			)											\
+	X(	WII_LIB_CONTROL_GYRO_Y,				gyroY			)											\
+	X(	WII_LIB_CONTROL_GYRO_Z,				gyroZ			)
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => STATUS FIELD DECODING
+//--------------------------------------------------------------------------------------------------
+// Target headers describe their status frames as X-macro tables of field descriptors rather than 
+// bitfield overlays (bitfield ordering is implementation defined). Each row takes the form:
+//
+//		X(	destination,	op,	byte,	shift,	width,	destShift,	invert	)
+//
+//	destination		Member of 'WiiLib_Interface' receiving the value. 
+//	op				'=' for the first row of a field, '|=' for any rows merged into it. 
+//	byte			Index into the status frame. 
+//	shift			Bit position of the least significant bit within 'byte'. 
+//	width			Number of bits to extract. 
+//	destShift		Bit position of the extracted value within 'destination'. 
+//	invert			Mask XOR'd with 'byte' before extracting (0xFF for active low buttons).
+//
+// Expanding a table with 'WII_LIB_DECODE_FIELD' produces straight-line shift/mask code. The 
+// expansion expects 'data' (status frame) and 'current' (destination 'WiiLib_Interface') in scope. 
+// 'WII_LIB_FIELD_VALUE' extracts a single row from the value of its byte and is shared with the 
+// batch decoder ("wii_batch.h").
+#define	WII_LIB_FIELD_VALUE( value, shift, width, destShift, invert )									\
+	( ( (((uint32_t)((value) ^ (invert))) >> (shift)) & (((uint32_t)1 << (width)) - 1) ) << (destShift) )
+
+#define	WII_LIB_DECODE_FIELD( destination, op, byte, shift, width, destShift, invert )					\
+	current->destination op WII_LIB_FIELD_VALUE( data[(byte)], shift, width, destShift, invert );
+
+
 
 
 //==================================================================================================
@@ -151,7 +387,7 @@ typedef enum _WII_LIB_PARAM
 //!	@brief			Used to track the state of a Wii controller's buttons, accel, etc.
 //!	
 //!	@details		Defines every known type of feature across Wii controllers.
-//! 
+//!	
 //! @note           Wii nunchuck's use a single Z button and have one joystick, however the classic 
 //!                 controller has a left and right version of both. For the purposes of tracking, 
 //!                 a non-sided / generic joystick and z button options are not provided.
@@ -161,27 +397,13 @@ typedef enum _WII_LIB_PARAM
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 typedef struct _WiiLib_Interface
 {
-	// Discrete Buttons:
-	uint8_t											buttonA;										//!< Flag indicating status of A button (pressed == high).
-	uint8_t											buttonB;										//!< Flag indicating status of B button (pressed == high).
-	uint8_t											buttonC;										//!< Flag indicating status of C button (pressed == high).
-	uint8_t											buttonX;										//!< Flag indicating status of X button (pressed == high).
-	uint8_t											buttonY;										//!< Flag indicating status of Y button (pressed == high).
-	uint8_t											buttonZL;										//!< Flag indicating status of the left  z button (pressed == high).
-	uint8_t											buttonZR;										//!< Flag indicating status of the right z button (pressed == high).
-	uint8_t											buttonMinus;									//!< Flag indicating status of minus [-] button.
-	uint8_t											buttonHome;										//!< Flag indicating status of home button.
-	uint8_t											buttonPlus;										//!< Flag indicating status of plus [+] button.
-	// D-Pad Buttons:
-	uint8_t											dpadLeft;										//!< Flag indicating status of the left   d-pad button (pressed == high).
-	uint8_t											dpadUp;											//!< Flag indicating status of the top    d-pad button (pressed == high).
-	uint8_t											dpadRight;										//!< Flag indicating status of the right  d-pad button (pressed == high).
-	uint8_t											dpadDown;										//!< Flag indicating status of the bottom d-pad button (pressed == high).
+	// Buttons:
+	uint32_t										buttons;										//!< Bitmask of the buttons presently pressed (see 'WII_LIB_BUTTON_*').
+	uint32_t										buttonsPressed;									//!< Bitmask of the buttons pressed since the previous frame.
+	uint32_t										buttonsReleased;								//!< Bitmask of the buttons released since the previous frame.
 	// Triggers:
-	uint8_t											buttonLeftTrigger;								//!< Flag indicating status of left trigger button.
-	uint8_t											buttonRightTrigger;								//!< Flag indicating status of right trigger button.
-	int8_t											triggerLeft;									//!< Value of the left [analog] trigger.
-	int8_t											triggerRight;									//!< Value of the right [analog] trigger.
+	int16_t											triggerLeft;									//!< Value of the left [analog] trigger.
+	int16_t											triggerRight;									//!< Value of the right [analog] trigger.
 	// Analog Joysticks:
 	int16_t											analogLeftX;									//!< Value of the left analog joystick along the x-axis.
 	int16_t											analogLeftY;									//!< Value of the left analog joystick along the y-axis.
@@ -192,31 +414,134 @@ typedef struct _WiiLib_Interface
 	int16_t											accelY;											//!< Value of the [10-bit] accelerometer along the y-axis.
 	int16_t											accelZ;											//!< Value of the [10-bit] accelerometer along the z-axis.
 	// Gyroscopes:
-	int16_t											gyroX;											//!< Value of the gyroscope along the x-axis.
-	int16_t											gyroY;											//!< Value of the gyroscope along the y-axis.
-	int16_t											gyroZ;											//!< Value of the gyroscope along the z-axis.
+	int16_t											gyroX;											//!< Angular rate about the x-axis (pitch) in deg/s with 'WII_MOTION_PLUS_GYRO_FRACTION_BITS' fractional bits.
+	int16_t											gyroY;											//!< Angular rate about the y-axis (roll) in deg/s with 'WII_MOTION_PLUS_GYRO_FRACTION_BITS' fractional bits.
+	int16_t											gyroZ;											//!< Angular rate about the z-axis (yaw) in deg/s with 'WII_MOTION_PLUS_GYRO_FRACTION_BITS' fractional bits.
 } WiiLib_Interface;
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Tracks progress of the non-blocking state machine for a single device.
+//!	
+//!	@note			Managed entirely by 'WiiLib_Service()'. Applications should not modify these 
+//!					values directly.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiLib_ServiceTracking
+{
+	WII_LIB_SERVICE_STATE							state;											//!< Current step of the state machine.
+	WII_LIB_SERVICE_STATE							nextState;										//!< Step to advance to once 'deadlineUs' is reached (only used while in the wait state).
+	WII_LIB_SERVICE_JOB								job;											//!< Job the current step(s) belong to.
+	WII_LIB_PARAM									param;											//!< Parameter presently being queried.
+	uint8_t											configIndex;									//!< Index of the next configuration message to push out to the target.
+	uint8_t											configFirst;									//!< Flag indicating if the target should be configured before polling its status.
+	uint8_t											statusReads;									//!< Status reads of the current job that returned half of a pass-through frame.
+	uint8_t											frameRetries;									//!< Status frames of the current job re-read after being rejected (see 'WII_LIB_MAX_FRAME_RETRIES').
+	uint32_t										deadlineUs;										//!< Timestamp (in microseconds) at which the present wait completes.
+	uint32_t										readUs;											//!< Timestamp (in microseconds) at which the most recent read was issued (sample time of the frame read, see 'WiiFusion_ProcessDevice()').
+	WII_LIB_SERVICE_STATE							step;											//!< Step (config write, write pointer, or read) that issued the present transfer.
+	volatile uint8_t								transferDone;									//!< Flag indicating the present transfer completed (set from the I2C interrupt when queued).
+	WII_LIB_RC										transferResult;									//!< Result of the present transfer (including processing of any data read).
+	uint8_t											transferLen;									//!< Number of bytes written or read by the present transfer.
+	uint8_t											buffer[WII_LIB_MAX_PAYLOAD_SIZE];				//!< Data written or read by the present transfer. Must outlive queued transfers.
+#if WII_LIB_STATS
+	uint32_t										transferStart;									//!< Cycle count when the present transfer was issued (see "wii_stats.h").
+	uint32_t										waitStart;										//!< Cycle count when the present wait started (see "wii_stats.h").
+#endif
+} WiiLib_ServiceTracking;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Tracks the multiplexer channel presently open on a single I2C module.
+//!	
+//!	@details		One instance is shared by every device on the module so channel select writes 
+//!					are only issued when the next transfer targets a different channel.
+//!	
+//!	@note			Only the main loop writes 'muxAddr' and 'channels' (once a select write is known 
+//!					to have succeeded). The I2C interrupt only sets 'invalid'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiLib_MuxState
+{
+	uint8_t											muxAddr;										//!< Address of the multiplexer with an open channel ('WII_LIB_MUX_NONE' or 'WII_LIB_MUX_UNKNOWN' if none/unknown).
+	uint8_t											channels;										//!< Channel mask last written to 'muxAddr'.
+	volatile uint8_t								invalid;										//!< Flag set from the I2C interrupt when a transfer fails (channel open is unknown). Consumed by the main loop, which alone writes 'muxAddr' and 'channels'.
+	uint8_t											pending;										//!< Number of channel selects queued whose transfer has not completed yet (see 'WiiLib_SelectMuxChannel()').
+	uint8_t											pendingAddr;									//!< Multiplexer left with an open channel by the last select queued (valid while 'pending').
+	uint8_t											pendingChannels;								//!< Channel mask written by the last select queued (valid while 'pending').
+} WiiLib_MuxState;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Decryption tables applied to data read from an encrypted target.
+//!	
+//!	@details		Each table is stored twice in a row so the entries for any starting register 
+//!					address can be read as contiguous words (see 'WiiLib_SetCipher()').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiLib_Cipher
+{
+	uint8_t											xorKey[2 * WII_LIB_CIPHER_PERIOD];				//!< Value xor'd with each byte (indexed by register address modulo 'WII_LIB_CIPHER_PERIOD').
+	uint8_t											addKey[2 * WII_LIB_CIPHER_PERIOD];				//!< Value added to each byte after the xor (indexed by register address modulo 'WII_LIB_CIPHER_PERIOD').
+} WiiLib_Cipher;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Merges the interleaved frames of a Wii Motion Plus in pass-through mode.
+//!	
+//!	@details		Ages count status frames read since each half was last updated (see 
+//!					'WiiMotionPlus_ProcessPassThrough()'). They describe 'interfaceCurrent' whenever 
+//!					the last status poll returned 'WII_LIB_RC_SUCCESS'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiLib_PassThrough
+{
+	WiiLib_Interface								staged;											//!< Latest values of both halves (published to 'interfaceCurrent' once both are fresh).
+	uint8_t											ageMotionPlus;									//!< Age (in frames) of the gyroscope half ('WII_MOTION_PLUS_AGE_NEVER' == not read yet).
+	uint8_t											ageExtension;									//!< Age (in frames) of the extension half ('WII_MOTION_PLUS_AGE_NEVER' == not read yet).
+} WiiLib_PassThrough;
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //!	@brief			Defines the tracking information used when communicating with Wii targets.
 //!	
-//!	@note			All data presented has been processed and can be easily indexed by treating it 
-//!					as a structure of bitfields where the corresponding bitfield mapping is defined 
-//!					in the target-specific header file.
+//!	@note			All data presented has been processed (decrypted) and is decoded using the field 
+//!					descriptor tables defined in the target-specific header file.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 typedef struct _WiiLib_Device
 {
 	I2C_Device										i2c;											//!< I2C device information. Used when communicating with Wii device over I2C.
+	const WiiLib_Backend							*backend;										//!< Functions used to communicate over I2C and delay (defaults to 'WiiLib_BackendDefault').
+	struct _WiiAsync_Queue							*queue;											//!< Interrupt driven transaction queue used by 'WiiLib_Service()' (NULL == blocking transfers). See 'WiiAsync_Attach()'.
+	WiiLib_MuxState									*muxState;										//!< Multiplexer channel tracking shared across the module (NULL == no multiplexers on the bus). See 'WiiLib_SetMuxChannel()'.
+	uint8_t											muxAddr;										//!< Address of the multiplexer the target sits behind ('WII_LIB_MUX_NONE' == wired directly).
+	uint8_t											muxSelect;										//!< Channel mask written to 'muxAddr' to reach the target.
+	uint8_t											muxPending;										//!< Flag indicating channel select writes were queued ahead of the present transfer (confirmed once it completes).
 	WII_LIB_TARGET_DEVICE							target;											//!< Target device type intended for communication.
+	const struct _WiiDriver							*driver;										//!< Driver of 'target' (NULL == target type not known yet). See "wii_driver.h".
+	uint8_t											id[WII_LIB_ID_LENGTH];							//!< ID most recently read from the target.
 	uint8_t											dataEncrypted;									//!< Flag indicating if data read is encrypted.
+	WiiLib_Cipher									cipher;											//!< Tables used to decrypt data read while 'dataEncrypted' is set (see 'WiiLib_SetCipher()').
 	uint8_t											calculateRelativePosition;						//!< Flag indicating if the relative position values should be calculated (defaults to 'WII_LIB_DEFAULT_CALCULATE_RELATIVE_POSITION').
+	WII_LIB_REPORT									report;											//!< Report profile used by status queries (defaults to 'WII_LIB_REPORT_STANDARD'). See 'WiiLib_SetReport()'.
+	uint8_t											reportOffset;									//!< Register address status queries start reading from (offset within the status frame).
+	uint8_t											reportLen;										//!< Number of bytes read by status queries.
 	uint8_t											dataCurrent[WII_LIB_MAX_PAYLOAD_SIZE];			//!< Payload used when storing the most recently read data in from the target device.
+	uint8_t											dataStatus[WII_LIB_MAX_PAYLOAD_SIZE];			//!< Most recent status frame validated (laid out as 'dataCurrent[]'). Reference for 'WII_LIB_FRAME_REPEATED' that other queries do not overwrite.
+	WII_LIB_FRAME									frame;											//!< Verdict given to the most recent response validated.
 	WiiLib_Interface								interfaceCurrent;								//!< Instance of most recently read-in status values for interface (buttons, accelerometers, etc.) on the target device.
 	WiiLib_Interface								interfaceHome;									//!< Instance of status values associated with the home position for the interface (buttons, accelerometers, etc.) on the target device.
-	WiiLib_Interface								interfaceRelative;								//!< Relative interface values obtained by taking 'interfaceCurrent' and subtracting 'interfaceHome' for all interface values.
+	uint32_t										changedMask;									//!< Controls that changed in the most recent status frame published (bit per 'WII_LIB_CONTROL'; zero == nothing changed).
+	WiiLib_PassThrough								passThrough;									//!< Merge of interleaved frames (Wii Motion Plus pass-through targets only).
+	struct _WiiCalibration_Cache					*calibrationCache;								//!< Cache of factory calibrations used while connecting (NULL == home position is measured). See 'WiiCalibration_Attach()'.
+	const struct _WiiCalibration_Data				*calibration;									//!< Factory calibration of the connected target (NULL == not available).
+	struct _WiiFusion_State							*fusion;										//!< Orientation fusion updated with each status frame published (NULL == disabled). See 'WiiFusion_Attach()'.
+	struct _WiiEvents_Source						*events;										//!< Event source fed with each status frame published (NULL == disabled). See 'WiiEvents_Attach()'.
+	struct _WiiCapture_Recorder						*capture;										//!< Recorder logging every response processed (NULL == disabled). See 'WiiCapture_Attach()'.
+#if WII_LIB_STATS
+	struct _WiiStats_Block							*stats;											//!< Statistics updated by every transfer, delay, and decode (NULL == disabled). See 'WiiStats_Attach()'.
+#endif
 	uint32_t										failedParamQueryCount;							//!< Tracks number of failed queries over I2C and referenced during maintenance tasks. Updated after each parameter query.
+	uint32_t										probeInterval;									//!< Spacing between probes while disconnected: milliseconds with 'WiiLib_Service()', calls with 'WiiLib_DoMaintenance()'.
+	uint32_t										probeCountdown;									//!< Calls to 'WiiLib_DoMaintenance()' left before the next probe.
 	WII_LIB_DEVICE_STATUS							status;											//!< Status for device. Updated throughout the first initialization process and when (and if) maintenance tasks are run.
+	WiiLib_ServiceTracking							service;										//!< Progress of the non-blocking state machine (see 'WiiLib_Service()').
 } WiiLib_Device;
 
 
@@ -224,12 +549,19 @@ typedef struct _WiiLib_Device
 //	PUBLIC FUNCTION PROTOTYPES
 //--------------------------------------------------------------------------------------------------
 WII_LIB_RC		WiiLib_Init(						I2C_MODULE module,		uint32_t pbClk,	WII_LIB_TARGET_DEVICE target,	BOOL decryptData,	WiiLib_Device *device	);
+WII_LIB_RC		WiiLib_InitNonBlocking(				I2C_MODULE module,		uint32_t pbClk,	WII_LIB_TARGET_DEVICE target,	BOOL decryptData,	WiiLib_Device *device	);
+WII_LIB_RC		WiiLib_Service(						WiiLib_Device *device,	uint32_t nowUs																				);
+WII_LIB_RC		WiiLib_SetReport(					WiiLib_Device *device,	WII_LIB_REPORT report																		);
+WII_LIB_RC		WiiLib_SetCipher(					WiiLib_Device *device,	const uint8_t *xorKey,		const uint8_t *addKey										);
+WII_LIB_RC		WiiLib_SetMuxChannel(				WiiLib_Device *device,	WiiLib_MuxState *muxState,	uint8_t muxAddr,	uint8_t channel								);
 WII_LIB_RC		WiiLib_ConnectToTarget(				WiiLib_Device *device 																								);
 WII_LIB_RC		WiiLib_ConfigureDevice(				WiiLib_Device *device																								);
 WII_LIB_RC		WiiLib_DoMaintenance(				WiiLib_Device *device 																								);
 WII_LIB_RC		WiiLib_QueryParameter(				WiiLib_Device *device,	WII_LIB_PARAM param																			);
 WII_LIB_RC		WiiLib_MeasureNewHomePosition(		WiiLib_Device *device																								);
 void			WiiLib_SaveCurrentPositionAsHome(	WiiLib_Device *device																								);
+int32_t			WiiLib_GetRelative(					const WiiLib_Device *device,	WII_LIB_CONTROL control																);
+WII_LIB_RC		WiiLib_GetRelativeInterface(		const WiiLib_Device *device,	WiiLib_Interface *relative															);
 WII_LIB_RC		WiiLib_PollStatus(					WiiLib_Device *device																								);
 WII_LIB_RC		WiiLib_EnableRelativePosition(		WiiLib_Device *device 																								);
 WII_LIB_RC		WiiLib_DisableRelativePosition(		WiiLib_Device *device 																								);
@@ -242,8 +574,20 @@ WII_LIB_RC		WiiLib_DisableRelativePosition(		WiiLib_Device *device
 //--------------------------------------------------------------------------------------------------
 // Additional includes that may be dependent upon items above but allow this file to be both the 
 // core file and single wrapper for the library.
+#include "wii_async.h"
+#include "wii_scheduler.h"
+#include "wii_batch.h"
+#include "wii_calibration.h"
+#include "wii_fusion.h"
+#include "wii_output.h"
+#include "wii_events.h"
+#include "wii_capture.h"
+#include "wii_stats.h"
 #include "wii_nunchuck.h"
 #include "wii_classic_controller.h"
+#include "wii_motion_plus.h"
+#include "wii_guitar_hero.h"
+#include "wii_driver.h"
 
 
 #endif	// __WII_LIB__
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, macros, and constant functions available for the "wii 
+//!					motion plus" support.
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_MOTION_PLUS__
+#define	__WII_MOTION_PLUS__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => ACTIVATION
+//--------------------------------------------------------------------------------------------------
+// An inactive Wii Motion Plus answers at 'WII_LIB_I2C_ADDR_WII_MOTION_PLUS'. Writing 0x55 to 0xF0 
+// initializes it and writing the mode below to 0xFE activates it. Once active it answers at 
+// 'WII_LIB_I2C_ADDR_STANDARD' (with data unencrypted) and the ID reflects the mode selected.
+#define	WII_MOTION_PLUS_REG_INIT					0xF0											//!< Register written with 0x55 to initialize the device.
+#define	WII_MOTION_PLUS_REG_ACTIVATE				0xFE											//!< Register written with the mode to activate the device.
+#define	WII_MOTION_PLUS_MODE_STANDALONE				0x04											//!< Activation mode: no pass-through.
+#define	WII_MOTION_PLUS_MODE_PASS_NUNCHUCK			0x05											//!< Activation mode: pass-through of a nunchuck.
+#define	WII_MOTION_PLUS_MODE_PASS_CLASSIC			0x07											//!< Activation mode: pass-through of a classic controller.
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => GYROSCOPE SCALING
+//--------------------------------------------------------------------------------------------------
+// Gyroscope values are reported as 14-bit readings centered on 'WII_MOTION_PLUS_GYRO_ZERO'. Each 
+// axis runs in slow (high resolution, ~595 deg/s full scale) or fast (~2704 deg/s full scale) 
+// mode as flagged in the frame. Readings are converted to a common fixed-point deg/s scale with 
+// 'WII_MOTION_PLUS_GYRO_FRACTION_BITS' fractional bits by multiplying with the scale for the mode 
+// and dividing by 2^'WII_MOTION_PLUS_GYRO_SCALE_SHIFT' (no floating point).
+#define	WII_MOTION_PLUS_GYRO_ZERO					8192											//!< Reading when the axis is at rest (nominal; varies per device).
+#define	WII_MOTION_PLUS_GYRO_FRACTION_BITS			3												//!< Fractional bits of converted values (1 == 0.125 deg/s).
+#define	WII_MOTION_PLUS_GYRO_SCALE_SHIFT			13												//!< Shift applied after scaling.
+#define	WII_MOTION_PLUS_GYRO_SCALE_SLOW				4760L											//!< Scale for slow mode readings (595 deg/s per 8192 counts, 3 fractional bits, multiplied by 2^13).
+#define	WII_MOTION_PLUS_GYRO_SCALE_FAST				21636L											//!< Scale for fast mode readings (slow mode scale * 2000 / 440).
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => THRESHOLDS
+//--------------------------------------------------------------------------------------------------
+// NOTE:	Used by the adaptive scheduler to tell activity from noise between frames (see 
+//			"wii_scheduler.h").
+#define	WII_MOTION_PLUS_THRESHOLD_GYRO				40												//!< Change in a converted gyroscope value to consider the target to be moving (5 deg/s).
+
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => FIXED BITS
+//--------------------------------------------------------------------------------------------------
+// Bits that never change in any frame delivered by a Wii Motion Plus (both frame types, so 
+// pass-through extension frames included). Frames holding any other value are rejected 
+// ('WII_LIB_FRAME_RESERVED'). When not passing through an extension, the frame type flag must 
+// also be set (see 'WII_MOTION_PLUS_FRAME_TYPE_MASK').
+#define	WII_MOTION_PLUS_FIXED_BYTE					5												//!< Byte holding the fixed bits.
+#define	WII_MOTION_PLUS_FIXED_MASK					0x01											//!< Mask of the fixed bits (below the frame type flag).
+#define	WII_MOTION_PLUS_FIXED_VALUE					0x00											//!< Value of the fixed bits.
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => PASS-THROUGH MERGE
+//--------------------------------------------------------------------------------------------------
+// Ages count status frames read since a half of the pass-through merge was last updated (0 == the 
+// frame just read). The target should alternate halves, so the other half is normally 1 frame old.
+#define	WII_MOTION_PLUS_MERGE_MAX_AGE				3												//!< Oldest a half may be for merged values to be published (tolerates a couple of repeated halves).
+#define	WII_MOTION_PLUS_AGE_NEVER					0xFF											//!< Age of a half not read since the target was configured (or too old to track).
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => STATUS FIELD DESCRIPTORS
+//--------------------------------------------------------------------------------------------------
+// Layout of the status frame expressed as a table of field descriptors. Expanded with 
+// 'WII_LIB_DECODE_FIELD()' into straight-line shift/mask code (see "wii_lib.h" for column details). 
+// The gyroscope rows produce the raw 14-bit readings, which are then converted in place. Pitch, 
+// roll, and yaw are reported as rotation about the x, y, and z axes respectively.
+//
+//		X(	destination,	op,	byte,	shift,	width,	destShift,	invert	)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Status frame fields when directly connected to a Wii Motion Plus.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_MOTION_PLUS_FIELDS_GYRO(X)																	\
+	X(	gyroZ,				=,		0,		0,		8,		0,		0x00	)		/* yaw   */			\
+	X(	gyroZ,				|=,		3,		2,		6,		8,		0x00	)							\
+	X(	gyroY,				=,		1,		0,		8,		0,		0x00	)		/* roll  */			\
+	X(	gyroY,				|=,		4,		2,		6,		8,		0x00	)							\
+	X(	gyroX,				=,		2,		0,		8,		0,		0x00	)		/* pitch */			\
+	X(	gyroX,				|=,		5,		2,		6,		8,		0x00	)
+
+
+// Location of the slow mode flags (set == slow), the frame type flag (set == Wii Motion Plus 
+// data; clear == pass-through extension data) and the extension connected flag of Wii Motion Plus 
+// frames (set == extension plugged into the Wii Motion Plus).
+#define	WII_MOTION_PLUS_SLOW_YAW_BYTE				3												//!< Byte holding the yaw (z-axis) slow mode flag.
+#define	WII_MOTION_PLUS_SLOW_YAW_MASK				0x02											//!< Mask of the yaw (z-axis) slow mode flag.
+#define	WII_MOTION_PLUS_SLOW_PITCH_BYTE				3												//!< Byte holding the pitch (x-axis) slow mode flag.
+#define	WII_MOTION_PLUS_SLOW_PITCH_MASK				0x01											//!< Mask of the pitch (x-axis) slow mode flag.
+#define	WII_MOTION_PLUS_SLOW_ROLL_BYTE				4												//!< Byte holding the roll (y-axis) slow mode flag.
+#define	WII_MOTION_PLUS_SLOW_ROLL_MASK				0x02											//!< Mask of the roll (y-axis) slow mode flag.
+#define	WII_MOTION_PLUS_FRAME_TYPE_BYTE				5												//!< Byte holding the frame type flag.
+#define	WII_MOTION_PLUS_FRAME_TYPE_MASK				0x02											//!< Mask of the frame type flag.
+#define	WII_MOTION_PLUS_EXTENSION_BYTE				4												//!< Byte holding the extension connected flag.
+#define	WII_MOTION_PLUS_EXTENSION_MASK				0x01											//!< Mask of the extension connected flag.
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+WII_LIB_RC			WiiMotionPlus_ProcessStatusParam(	WiiLib_Device *device	);
+WII_LIB_RC			WiiMotionPlus_ProcessPassThrough(	WiiLib_Device *device	);
+void				WiiMotionPlus_ResetPassThrough(		WiiLib_Device *device	);
+int16_t				WiiMotionPlus_ScaleGyro(			int16_t raw,			BOOL slow		);
+const uint8_t *		WiiMotionPlus_GetConfigSequence(	WiiLib_Device *device,	uint8_t *count	);
+const uint16_t *	WiiMotionPlus_GetThresholds(		WiiLib_Device *device	);
+
+
+#endif	// __WII_MOTION_PLUS__
@@ -22,8 +22,10 @@
 //==================================================================================================
 //	CONSTANTS => THRESHOLDS
 //--------------------------------------------------------------------------------------------------
-// NOTE:	The following threshold values are not used in the library but are good reference values 
-//			for the amount of noise to ignore off of a relative zero position in an application.
+// NOTE:	The following threshold values are good reference values for the amount of noise to ignore 
+//			off of a relative zero position in an application (see "wii_output.h" for a deadzone 
+//			applied by the library). The adaptive scheduler uses them to tell activity from noise 
+//			between frames (see "wii_scheduler.h").
 #define	WII_NUNCHUCK_THRESHOLD_ANALOG						20					//!< Threshold off of relative position to consider analog joystick to be active.
 #define	WII_NUNCHUCK_THRESHOLD_ACCELEROMETER				75					//!< Threshold off of relative position to consider accelerometer data to be active.
 
@@ -31,68 +33,120 @@
 
 
 //==================================================================================================
-//	TYPEDEFS
+//	CONSTANTS => RANGES
 //--------------------------------------------------------------------------------------------------
+#define	WII_NUNCHUCK_ANALOG_HALF_RANGE						128					//!< Nominal travel (in counts) of the analog joystick either side of its center (8-bit axis).
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => REPORT WINDOWS
+//--------------------------------------------------------------------------------------------------
+// Part of the status frame read by a buttons-only report ('WII_LIB_REPORT_BUTTONS').
+#define	WII_NUNCHUCK_REPORT_BUTTONS_OFFSET					5					//!< Offset of the first status frame byte read.
+#define	WII_NUNCHUCK_REPORT_BUTTONS_LEN						1					//!< Number of status frame bytes read.
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => STATUS FIELD DESCRIPTORS
+//--------------------------------------------------------------------------------------------------
+// Layout of the status frame expressed as a table of field descriptors. Expanded with 
+// 'WII_LIB_DECODE_FIELD()' into straight-line shift/mask code (see "wii_lib.h" for column details). 
+// Buttons are active low (inverted) and the Z button feeds both ZL and ZR.
+//
+//		X(	destination,	op,	byte,	shift,	width,	destShift,	invert	)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-//!	@brief			Defines bitfield interaction for status field queries from nunchuck controllers.
-//!	
-//!	@note			The definitions below are for use when directly connected to a nunchuck.
-//!	
-//!	@warning		The following is in little-endian format.
+//!	@brief			Status frame fields when directly connected to a nunchuck.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-typedef struct _WiiNunchuck_StatusNormal
-{
-	// Byte-01:
-	uint8_t								analogX:			8;					//!< Bits <7:0> for the analog joystic along the x-axis.
-	// Byte-02:
-	uint8_t								analogY:			8;					//!< Bits <7:0> for the analog joystic along the y-axis.
-	// Byte-03:
-	uint8_t								accelXHigh:			8;					//!< Bits <9:2> for the accelerometer along the x-axis.
-	// Byte-04:
-	uint8_t								accelYHigh:			8;					//!< Bits <9:2> for the accelerometer along the y-axis.
-	// Byte-05:
-	uint8_t								accelZHigh:			8;					//!< Bits <9:2> for the accelerometer along the z-axis.
-	// Byte-06:
-	uint8_t								buttonZ:			1;					//!< Bit indicating status of z button (pressed == low).
-	uint8_t								buttonC:			1;					//!< Bit indicating status of c button (pressed == low).
-	uint8_t								accelXLow:			2;					//!< Bits <1:0> for the accelerometer along the z-axis.
-	uint8_t								accelYLow:			2;					//!< Bits <1:0> for the accelerometer along the y-axis.
-	uint8_t								accelZLow:			2;					//!< Bits <1:0> for the accelerometer along the x-axis.
-} WiiNunchuck_StatusNormal;
+#define	WII_NUNCHUCK_FIELDS_NORMAL(X)																	\
+	X(	analogLeftX,		=,		0,		0,		8,		0,		0x00	)							\
+	X(	analogLeftY,		=,		1,		0,		8,		0,		0x00	)							\
+	X(	accelX,				=,		2,		0,		8,		2,		0x00	)							\
+	X(	accelX,				|=,		5,		2,		2,		0,		0x00	)							\
+	X(	accelY,				=,		3,		0,		8,		2,		0x00	)							\
+	X(	accelY,				|=,		5,		4,		2,		0,		0x00	)							\
+	X(	accelZ,				=,		4,		0,		8,		2,		0x00	)							\
+	X(	accelZ,				|=,		5,		6,		2,		0,		0x00	)							\
+	WII_NUNCHUCK_FIELDS_BUTTONS(X)
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-//!	@brief			Defines bitfield interaction for status field queries from nunchuck controllers.
+//!	@brief			Button fields when directly connected to a nunchuck (all within the buttons-only 
+//!					report window).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_NUNCHUCK_FIELDS_BUTTONS(X)																	\
+	X(	buttons,			=,		5,		1,		1,		0,		0xFF	)		/* C  */			\
+	X(	buttons,			|=,		5,		0,		1,		10,		0xFF	)		/* ZR */			\
+	X(	buttons,			|=,		5,		0,		1,		15,		0xFF	)		/* ZL */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Status frame fields when connected to a nunchuck in pass-through mode (e.g. when 
+//!					using Wii Motion Plus + nunchuck).
 //!	
-//!	@note			The definitions below are for use when connected to a nunchuck in pass-through 
-//!					mode (e.g. when using Wii Motion Plus + nunchuck).
+//!	@note			To accomidate the pass-through flags, the least significant bit of all 
+//!					accelerometer values is dropped (always zero).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_NUNCHUCK_FIELDS_PASS_THROUGH(X)																\
+	X(	analogLeftX,		=,		0,		0,		8,		0,		0x00	)							\
+	X(	analogLeftY,		=,		1,		0,		8,		0,		0x00	)							\
+	X(	accelX,				=,		2,		0,		8,		2,		0x00	)							\
+	X(	accelX,				|=,		5,		4,		1,		1,		0x00	)							\
+	X(	accelY,				=,		3,		0,		8,		2,		0x00	)							\
+	X(	accelY,				|=,		5,		5,		1,		1,		0x00	)							\
+	X(	accelZ,				=,		4,		1,		7,		3,		0x00	)							\
+	X(	accelZ,				|=,		5,		6,		2,		1,		0x00	)							\
+	X(	buttons,			=,		5,		3,		1,		0,		0xFF	)		/* C  */			\
+	X(	buttons,			|=,		5,		2,		1,		10,		0xFF	)		/* ZR */			\
+	X(	buttons,			|=,		5,		2,		1,		15,		0xFF	)		/* ZL */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Right joystick fields (mirror of the left joystick in both modes).
 //!	
-//!	@note			To accomidate the pass-through flag, the least significant bit of all 
-//!					accelerometer values is dropped.
+//!	@note			Only used by the batch decoder. 'WiiNunchuck_ProcessStatusParam()' copies the 
+//!					decoded left joystick values instead.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#define	WII_NUNCHUCK_FIELDS_RIGHT_JOYSTICK(X)															\
+	X(	analogRightX,		=,		0,		0,		8,		0,		0x00	)							\
+	X(	analogRightY,		=,		1,		0,		8,		0,		0x00	)
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => CALIBRATION FIELD DESCRIPTORS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Calibration block fields (see "wii_calibration.h"). Destinations are members of 
+//!					'WiiCalibration_Data{}'.
 //!	
-//!	@warning		The following is in little-endian format.
+//!	@note			Bytes 3 and 7 hold the low bits of the accelerometer values packed the same way 
+//!					as byte 5 of the status frame.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-typedef struct _WiiNunchuck_StatusPassThrough
-{
-	// Byte-01:
-	uint8_t								analogX:			8;					//!< Bits <7:0> for the analog joystic along the x-axis.
-	// Byte-02:
-	uint8_t								analogY:			8;					//!< Bits <7:0> for the analog joystic along the y-axis.
-	// Byte-03:
-	uint8_t								accelXHigh:			8;					//!< Bits <9:2> for the accelerometer along the x-axis.
-	// Byte-04:
-	uint8_t								accelYHigh:			8;					//!< Bits <9:2> for the accelerometer along the y-axis.
-	// Byte-05:
-	uint8_t								extensionConnected:	1;					//!< Bit indicating if extension is connected (1 == active).
-	uint8_t								accelZHigh:			7;					//!< Bits <9:3> for the accelerometer along the z-axis.
-	// Byte-06:
-	uint8_t								RESERVED:			2;					//!< Rserved bits (should be == 0b00).
-	uint8_t								buttonZ:			1;					//!< Bit indicating status of z button (pressed == low).
-	uint8_t								buttonC:			1;					//!< Bit indicating status of c button (pressed == low).
-	uint8_t								accelXLow:			1;					//!< Bit <1> for the accelerometer along the z-axis.
-	uint8_t								accelYLow:			1;					//!< Bit <1> for the accelerometer along the y-axis.
-	uint8_t								accelZLow:			2;					//!< Bits <2:1> for the accelerometer along the x-axis.
-} WiiNunchuck_StatusPassThrough;
+#define	WII_NUNCHUCK_FIELDS_CALIBRATION(X)																\
+	X(	center.accelX,			=,		0,		0,		8,		2,		0x00	)		/* 0g */		\
+	X(	center.accelX,			|=,		3,		2,		2,		0,		0x00	)						\
+	X(	center.accelY,			=,		1,		0,		8,		2,		0x00	)						\
+	X(	center.accelY,			|=,		3,		4,		2,		0,		0x00	)						\
+	X(	center.accelZ,			=,		2,		0,		8,		2,		0x00	)						\
+	X(	center.accelZ,			|=,		3,		6,		2,		0,		0x00	)						\
+	X(	maximum.accelX,			=,		4,		0,		8,		2,		0x00	)		/* 1g */		\
+	X(	maximum.accelX,			|=,		7,		2,		2,		0,		0x00	)						\
+	X(	maximum.accelY,			=,		5,		0,		8,		2,		0x00	)						\
+	X(	maximum.accelY,			|=,		7,		4,		2,		0,		0x00	)						\
+	X(	maximum.accelZ,			=,		6,		0,		8,		2,		0x00	)						\
+	X(	maximum.accelZ,			|=,		7,		6,		2,		0,		0x00	)						\
+	X(	maximum.analogLeftX,	=,		8,		0,		8,		0,		0x00	)						\
+	X(	minimum.analogLeftX,	=,		9,		0,		8,		0,		0x00	)						\
+	X(	center.analogLeftX,		=,		10,		0,		8,		0,		0x00	)						\
+	X(	maximum.analogLeftY,	=,		11,		0,		8,		0,		0x00	)						\
+	X(	minimum.analogLeftY,	=,		12,		0,		8,		0,		0x00	)						\
+	X(	center.analogLeftY,		=,		13,		0,		8,		0,		0x00	)
 
 
 
@@ -100,7 +154,8 @@ typedef struct _WiiNunchuck_StatusPassThrough
 //==================================================================================================
 //	PUBLIC FUNCTION PROTOTYPES
 //--------------------------------------------------------------------------------------------------
-WII_LIB_RC		WiiNunchuck_ProcessStatusParam(	WiiLib_Device *device	);
+WII_LIB_RC			WiiNunchuck_ProcessStatusParam(	WiiLib_Device *device	);
+const uint16_t *	WiiNunchuck_GetThresholds(		WiiLib_Device *device	);
 
 
 #endif	// __WII_NUNCHUCK__
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, types, and functions for the optional joystick output 
+//!					stage of the "wii" library module.
+//!	
+//!	@details		Turns relative joystick values (see 'WiiLib_GetRelativeInterface()') into 
+//!					normalized Q15 axes (-32767 == full left/down, 32767 == full right/up) sharing a 
+//!					single range across the nunchuck (8-bit), classic controller left (6-bit), and 
+//!					classic controller right (5-bit) joysticks (both 8-bit with the high-resolution 
+//!					report). A deadzone (per axis or radial) and an optional response curve are 
+//!					applied on the way out.
+//!	
+//!					All divisions are done once by 'WiiOutput_Init()', which folds the range of 
+//!					every axis into a multiplier and the deadzone plus response curve into a single 
+//!					table. Each frame then only takes multiplies, shifts, an integer square root 
+//!					(radial deadzone), and table lookups.
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_OUTPUT__
+#define	__WII_OUTPUT__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_OUTPUT_Q15_MAX							32767											//!< Largest normalized axis value.
+#define	WII_OUTPUT_SCALE_BITS						16												//!< Fractional bits of the per axis multipliers.
+
+#define	WII_OUTPUT_CURVE_POINTS						17												//!< Number of points of a response curve (inputs 0, 2048, ... 32768 in Q15).
+#define	WII_OUTPUT_CURVE_STEP_BITS					11												//!< Input step between response curve points (2^bits).
+
+#define	WII_OUTPUT_TABLE_STEP_BITS					10												//!< Input step between table entries (2^bits).
+#define	WII_OUTPUT_TABLE_POINTS						65												//!< Number of table entries (covers radial magnitudes up to 2^16).
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the shapes of deadzone supported.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _WII_OUTPUT_DEADZONE
+{
+	WII_OUTPUT_DEADZONE_AXIAL						= 0,											//!< Each axis is handled on its own (square deadzone).
+	WII_OUTPUT_DEADZONE_RADIAL						= 1												//!< Applied to the length of the joystick vector (round deadzone, direction kept).
+} WII_OUTPUT_DEADZONE;
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+struct _WiiLib_Device;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Normalized joystick axes produced by 'WiiOutput_Process()'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiOutput_Axes
+{
+	int16_t											leftX;											//!< Left joystick x-axis (Q15).
+	int16_t											leftY;											//!< Left joystick y-axis (Q15).
+	int16_t											rightX;											//!< Right joystick x-axis (Q15).
+	int16_t											rightY;											//!< Right joystick y-axis (Q15).
+} WiiOutput_Axes;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Precomputed output stage settings (see 'WiiOutput_Init()').
+//!	
+//!	@details		Axes are ordered left x, left y, right x, right y. 'table[]' maps the Q15 length 
+//!					of an axis (axial) or of a joystick vector (radial) in steps of 
+//!					2^'WII_OUTPUT_TABLE_STEP_BITS':
+//!						-	Axial:	Output value (Q15).
+//!						-	Radial:	Gain applied to both axes ('WII_OUTPUT_SCALE_BITS' fractional 
+//!									bits).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiOutput_Config
+{
+	WII_OUTPUT_DEADZONE								deadzoneMode;									//!< Shape of the deadzone.
+	int32_t											scalePositive[4];								//!< Multiplier turning positive relative values into Q15 per axis.
+	int32_t											scaleNegative[4];								//!< Multiplier turning negative relative values into Q15 per axis.
+	int32_t											table[WII_OUTPUT_TABLE_POINTS];					//!< Deadzone and response curve folded together.
+} WiiOutput_Config;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+WII_LIB_RC		WiiOutput_Init(		WiiOutput_Config *config,	struct _WiiLib_Device *device,		WII_OUTPUT_DEADZONE mode,	int16_t deadzone,	const int16_t *curve	);
+void			WiiOutput_Process(	const WiiOutput_Config *config,	const WiiLib_Interface *relative,	WiiOutput_Axes *axes													);
+
+
+#endif	// __WII_OUTPUT__
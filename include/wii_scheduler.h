@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, types, and functions for servicing multiple Wii 
+//!					targets spread across I2C modules and I2C multiplexers.
+//!	
+//!	@details		The scheduler owns a set of devices (initialized with 'WiiLib_InitNonBlocking()') 
+//!					and invokes 'WiiLib_Service()' on each of them in round-robin order. Since every 
+//!					wait required by a target is tracked as a deadline, the transfers of one device 
+//!					execute while the others sit in their post-read/configuration waits.
+//!	
+//!					In 'WII_SCHEDULER_MODE_ADAPTIVE' the poll rate of each device follows its 
+//!					activity. Every frame is compared against the last frame that showed activity 
+//!					(buttons changed or an analog control moved beyond the threshold the driver of 
+//!					the target supplies, see 'WiiDriver_Thresholds'; any change for targets without 
+//!					thresholds). Idle frames double the poll interval up to the maximum of the 
+//!					device; the first active frame drops it back to the minimum. A device held back 
+//!					leaves the bus to the others (see 'WiiScheduler_GetUtilizationSaved()').
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_SCHEDULER__
+#define	__WII_SCHEDULER__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_SCHEDULER_MAX_DEVICES					16												//!< Maximum number of devices owned by a scheduler.
+#define	WII_SCHEDULER_RATE_WINDOW_US				1000000UL										//!< Period (in microseconds) over which frame rates are measured.
+#define	WII_SCHEDULER_DEFAULT_MIN_INTERVAL_US		WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_POST_READ_MS)	//!< Default shortest poll interval in adaptive mode (full rate).
+#define	WII_SCHEDULER_DEFAULT_MAX_INTERVAL_US		200000UL										//!< Default longest poll interval in adaptive mode (5 Hz while idle).
+#define	WII_SCHEDULER_FUSION_MAX_INTERVAL_US		(WII_FUSION_MAX_PERIOD_US / 2)					//!< Longest poll interval in adaptive mode of a device with orientation fusion attached (margin left for the transfers ahead of the read).
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines how the scheduler paces the status polls of its devices.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _WII_SCHEDULER_MODE
+{
+	WII_SCHEDULER_MODE_FIXED						= 0,											//!< Every device is polled as fast as it allows.
+	WII_SCHEDULER_MODE_ADAPTIVE						= 1												//!< Poll interval of each device backs off while idle.
+} WII_SCHEDULER_MODE;
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+typedef uint32_t (*WiiScheduler_Clock)( void );														//!< Returns the current time in microseconds (free-running counter).
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Tracking for a single I2C module serviced by the scheduler.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiScheduler_Bus
+{
+	WiiLib_MuxState									muxState;										//!< Multiplexer channel open on the module (shared by all devices on the module).
+	uint8_t											deviceCount;									//!< Number of devices on the module.
+	uint32_t										frames;											//!< Frames decoded during the present measurement window.
+	uint32_t										framesPerSecond;								//!< Frame rate measured over the last completed window.
+	uint32_t										heldUs;											//!< Time devices were held back during the present measurement window (adaptive mode).
+	uint8_t											utilizationSaved;								//!< Share (percent) of full rate polling avoided over the last completed window.
+} WiiScheduler_Bus;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Poll pacing of a single device (adaptive mode).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiScheduler_Pacing
+{
+	uint32_t										minIntervalUs;									//!< Poll interval used while the device is active.
+	uint32_t										maxIntervalUs;									//!< Longest poll interval reached while the device is idle.
+	uint32_t										intervalUs;										//!< Present poll interval.
+	uint32_t										nextPollUs;										//!< Earliest time the next status poll may start.
+	uint8_t											primed;											//!< Flag indicating if 'reference' holds values from a frame.
+	WiiLib_Interface								reference;										//!< Values of the last frame that showed activity.
+} WiiScheduler_Pacing;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Set of devices serviced together.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiScheduler
+{
+	WiiLib_Device									*devices[WII_SCHEDULER_MAX_DEVICES];			//!< Devices owned by the scheduler.
+	uint8_t											deviceCount;									//!< Number of entries used in 'devices[]'.
+	uint8_t											next;											//!< Device serviced first on the next pass (rotates every pass).
+	WII_SCHEDULER_MODE								mode;											//!< Pacing applied to status polls.
+	WiiScheduler_Clock								clock;											//!< Time source sampled ahead of every 'WiiLib_Service()' call.
+	uint32_t										windowStartUs;									//!< Start of the present frame rate measurement window.
+	WiiScheduler_Bus								buses[I2C_NUMBER_OF_MODULES];					//!< Per module tracking.
+	WiiScheduler_Pacing								pacing[WII_SCHEDULER_MAX_DEVICES];				//!< Per device poll pacing (same order as 'devices[]').
+} WiiScheduler;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+void			WiiScheduler_Init(					WiiScheduler *scheduler,	WiiScheduler_Clock clock												);
+WII_LIB_RC		WiiScheduler_AddDevice(				WiiScheduler *scheduler,	WiiLib_Device *device,	uint8_t muxAddr,	uint8_t channel			);
+void			WiiScheduler_SetMode(				WiiScheduler *scheduler,	WII_SCHEDULER_MODE mode													);
+WII_LIB_RC		WiiScheduler_SetPollInterval(		WiiScheduler *scheduler,	uint8_t index,			uint32_t minIntervalUs,	uint32_t maxIntervalUs	);
+uint32_t		WiiScheduler_Service(				WiiScheduler *scheduler																				);
+uint32_t		WiiScheduler_GetFramesPerSecond(	WiiScheduler *scheduler,	I2C_MODULE module														);
+uint8_t			WiiScheduler_GetUtilizationSaved(	WiiScheduler *scheduler,	I2C_MODULE module														);
+
+
+#endif	// __WII_SCHEDULER__
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines public constants, types, and functions for the optional per-device 
+//!					statistics of the "wii" library module.
+//!	
+//!	@details		Once a block is attached (see 'WiiStats_Attach()') the library records:
+//!						-	The result of every transfer and response processed, per return code.
+//!						-	Bus time (I2C transfers), delay time (blocking delays and non-blocking 
+//!							waits), and decode time (decrypting and decoding a response) as 
+//!							min/avg/max plus a log2 histogram, in cycles of the backend counter 
+//!							('WiiLib_Backend{}.cycles').
+//!						-	Connection attempts and reconfigurations triggered by errors.
+//!						-	The verdict of every response validated, per 'WII_LIB_FRAME'.
+//!	
+//!					Statistics are only compiled in when 'WII_LIB_STATS' is non-zero. Otherwise the 
+//!					hooks below expand to nothing and neither the device nor the service tracking 
+//!					carry any extra members.
+//!	
+//!	@note			When transfers complete from the I2C interrupt (see "wii_async.h") bus time, 
+//!					decode time, and results are recorded from the interrupt while delays and 
+//!					counts are recorded from the main loop. Each value is only written from one 
+//!					context.
+//!	
+//!	@note			This file is pulled into "wii_lib.h" automatically.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_STATS__
+#define	__WII_STATS__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_STATS_HISTOGRAM_BINS					32												//!< Bins per histogram (bin n counts durations of 2^n - 2^(n+1)-1 cycles; bin 0 also counts 0).
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the durations tracked per device.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef enum _WII_STATS_TIMER
+{
+	WII_STATS_TIMER_BUS								= 0,											//!< I2C transfers (channel selects included).
+	WII_STATS_TIMER_DELAY							= 1,											//!< Blocking delays and non-blocking waits.
+	WII_STATS_TIMER_DECODE							= 2,											//!< Validating, decrypting, and decoding a response.
+	WII_STATS_TIMER_COUNT							= 3												//!< Number of timers (not a timer).
+} WII_STATS_TIMER;
+
+
+
+
+//==================================================================================================
+//	CONSTANTS => HOOKS
+//--------------------------------------------------------------------------------------------------
+// Used by the library to record statistics. 'name' holds the cycle count a duration starts from.
+#if WII_LIB_STATS
+#define	WII_STATS_DECLARE( name )					uint32_t name = 0
+#define	WII_STATS_MARK( device, name )				do { if( (device)->stats ) (name) = (device)->backend->cycles(); } while( 0 )
+#define	WII_STATS_TIME( device, timer, name )		do { if( (device)->stats ) WiiStats_AddTime( (device)->stats, (timer), (device)->backend->cycles() - (name) ); } while( 0 )
+#define	WII_STATS_RESULT( device, rc )				do { if( (device)->stats ) WiiStats_AddResult( (device)->stats, (rc) ); } while( 0 )
+#define	WII_STATS_COUNT( device, member )			do { if( (device)->stats ) ++(device)->stats->member; } while( 0 )
+#else
+#define	WII_STATS_DECLARE( name )
+#define	WII_STATS_MARK( device, name )
+#define	WII_STATS_TIME( device, timer, name )
+#define	WII_STATS_RESULT( device, rc )
+#define	WII_STATS_COUNT( device, member )
+#endif
+
+
+
+
+//==================================================================================================
+//	TYPEDEFS
+//--------------------------------------------------------------------------------------------------
+struct _WiiLib_Device;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Durations recorded for a single timer (in backend counter cycles).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiStats_Timer
+{
+	uint32_t										count;											//!< Number of durations recorded.
+	uint32_t										minimum;										//!< Shortest duration recorded (UINT32_MAX until the first).
+	uint32_t										maximum;										//!< Longest duration recorded.
+	uint64_t										total;											//!< Sum of all durations recorded (see 'WiiStats_GetAverage()').
+	uint32_t										histogram[WII_STATS_HISTOGRAM_BINS];			//!< Durations recorded per power of two.
+} WiiStats_Timer;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Statistics recorded for a single device.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef struct _WiiStats_Block
+{
+	uint32_t										results[WII_LIB_RC_COUNT];						//!< Transfers and responses processed per return code ('WII_LIB_RC_SUCCESS' included).
+	uint32_t										connectAttempts;								//!< Number of attempts to connect to the target.
+	uint32_t										reconfigures;									//!< Number of times the target was reconfigured after errors or invalid data.
+	uint32_t										frames[WII_LIB_FRAME_COUNT];					//!< Responses validated per verdict ('WII_LIB_FRAME_VALID' included).
+	WiiStats_Timer									timers[WII_STATS_TIMER_COUNT];					//!< Durations recorded per 'WII_STATS_TIMER'.
+} WiiStats_Block;
+
+
+
+
+//==================================================================================================
+//	PUBLIC FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+#if WII_LIB_STATS
+void			WiiStats_Init(			WiiStats_Block *stats																);
+WII_LIB_RC		WiiStats_Attach(		WiiStats_Block *stats,		struct _WiiLib_Device *device							);
+void			WiiStats_AddTime(		WiiStats_Block *stats,		WII_STATS_TIMER timer,		uint32_t cycles				);
+void			WiiStats_AddResult(		WiiStats_Block *stats,		WII_LIB_RC rc											);
+uint32_t		WiiStats_GetAverage(	const WiiStats_Timer *timer															);
+#endif
+
+
+#endif	// __WII_STATS__
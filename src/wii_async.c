@@ -0,0 +1,350 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements the interrupt driven I2C transaction queue used by the "wii" library 
+//!					module.
+//!	
+//!	@details		Every transfer is executed as the following sequence of bus phases where each 
+//!					phase completes with an I2C master interrupt:
+//!						-	Write:	start => address => data[0..N-1] => stop
+//!						-	Read:	start => address => { receive => ack }[0..N-1] => stop
+//!					The final byte read is nacked. A missing ack from the target aborts the transfer 
+//!					(after issuing a stop) and reports 'WII_LIB_RC_I2C_ERROR'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+#include "i2c.h"
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE MACROS
+//--------------------------------------------------------------------------------------------------
+// Keeps the compiler from moving the slot accesses past the index updates that hand the slot over 
+// between the main loop and the interrupt (same rule as 'WII_EVENTS_BARRIER()').
+#define	WII_ASYNC_BARRIER()							__asm__ __volatile__( "" ::: "memory" )
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static void			WiiAsync_Start(		WiiAsync_Queue *queue							);
+static void			WiiAsync_Stop(		WiiAsync_Queue *queue,	WII_LIB_RC result		);
+static void			WiiAsync_Complete(	WiiAsync_Queue *queue							);
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Resets the provided queue to an empty state.
+//!	
+//!	@note			Must not be invoked while transfers are in progress.
+//!	
+//!	@param[in]		*queue				Queue to initialize.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiAsync_Init( WiiAsync_Queue *queue )
+{
+	memset( queue, 0, sizeof(WiiAsync_Queue) );
+	queue->phase = WII_ASYNC_PHASE_IDLE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Routes all transfers made by 'WiiLib_Service()' for the device through the 
+//!					provided queue.
+//!	
+//!	@details		Passing a NULL queue reverts the device to blocking transfers. Should only be 
+//!					invoked while the device is not in the middle of a transfer (e.g. right after 
+//!					'WiiLib_InitNonBlocking()').
+//!	
+//!	@param[in]		*queue				Queue shared by all devices on the same I2C module.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiAsync_Attach( WiiAsync_Queue *queue, WiiLib_Device *device )
+{
+	if( queue && !device->backend->bus )
+		return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	
+	device->queue = queue;
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Queues a transfer and starts the bus if it is presently idle.
+//!	
+//!	@details		The transfer is copied into the queue. The data buffer it references is not and 
+//!					must remain valid until the completion callback runs.
+//!	
+//!	@note			Must only be invoked from the main loop (single producer).
+//!	
+//!	@param[in]		*queue				Queue to add the transfer to.
+//!	@param[in]		*transfer			Transfer to execute.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiAsync_Submit( WiiAsync_Queue *queue, const WiiAsync_Transfer *transfer )
+{
+	return WiiAsync_SubmitChain( queue, transfer, 1 );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Queues a chain of transfers where each transfer depends on the one before it 
+//!					(e.g. a multiplexer channel select followed by the transfer it enables).
+//!	
+//!	@details		The whole chain is published at once so the interrupt never sees part of it. 
+//!					Should a transfer fail, the ones after it are completed with the same result 
+//!					without touching the bus. Each transfer still has its own callback invoked.
+//!	
+//!	@note			Must only be invoked from the main loop (single producer).
+//!	
+//!	@param[in]		*queue				Queue to add the transfers to.
+//!	@param[in]		*transfers			Transfers to execute (in order).
+//!	@param[in]		count				Number of transfers in the chain.
+//!	
+//!	@retval			WII_LIB_RC_QUEUE_FULL						Not enough room for the whole chain 
+//!																(nothing queued).
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiAsync_SubmitChain( WiiAsync_Queue *queue, const WiiAsync_Transfer *transfers, uint8_t count )
+{
+	uint8_t				tail	= queue->tail;
+	uint8_t				index;
+	WiiAsync_Transfer	*slot;
+	
+	if( !count )
+		return WII_LIB_RC_SUCCESS;
+	
+	if( (uint8_t)(tail - queue->head) > WII_ASYNC_QUEUE_DEPTH - count )
+		return WII_LIB_RC_QUEUE_FULL;
+	
+	for( index = 0; index < count; ++index )
+	{
+		slot			= &queue->transfers[(uint8_t)(tail + index) & (WII_ASYNC_QUEUE_DEPTH - 1)];
+		*slot			= transfers[index];
+		slot->chained	= ( index + 1 < count );
+	}
+	
+	// Publish the transfers (only once they are complete) before checking if the interrupt is 
+	// running. Should the interrupt finish its last transfer between the two steps it will see 
+	// the new tail and keep going.
+	WII_ASYNC_BARRIER();
+	queue->tail = tail + count;
+	
+	if( !queue->running )
+	{
+		queue->running = TRUE;
+		WiiAsync_Start(queue);
+	}
+	
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reports if the queue has no transfers pending or in progress.
+//!	
+//!	@param[in]		*queue				Queue to check.
+//!	
+//!	@returns		TRUE if idle.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL WiiAsync_IsIdle( WiiAsync_Queue *queue )
+{
+	return ( !queue->running && queue->head == queue->tail );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reports the number of transfers that can be queued before the queue is full.
+//!	
+//!	@param[in]		*queue				Queue to check.
+//!	
+//!	@returns		Number of free slots.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t WiiAsync_GetFree( WiiAsync_Queue *queue )
+{
+	return (uint8_t)( WII_ASYNC_QUEUE_DEPTH - (uint8_t)(queue->tail - queue->head) );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Advances the active transfer by one bus phase.
+//!	
+//!	@details		Must be invoked from the I2C master interrupt of the module the queue services 
+//!					(after clearing the interrupt flag).
+//!	
+//!	@param[in]		*queue				Queue serviced by the interrupt.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiAsync_Isr( WiiAsync_Queue *queue )
+{
+	WiiAsync_Transfer		*transfer;
+	I2C_Device				*i2c;
+	const WiiLib_BusOps		*bus;
+	
+	++queue->interruptCount;
+	
+	if( !queue->running )
+		return;
+	
+	transfer	= &queue->transfers[queue->head & (WII_ASYNC_QUEUE_DEPTH - 1)];
+	i2c			= &transfer->device->i2c;
+	bus			= transfer->device->backend->bus;
+	
+	switch( queue->phase )
+	{
+		case WII_ASYNC_PHASE_START:
+			queue->index	= 0;
+			queue->phase	= WII_ASYNC_PHASE_ADDRESS;
+			bus->write( i2c, (uint8_t)((transfer->addr << 1) | (transfer->read ? 0x01 : 0x00)) );
+			break;
+		
+		case WII_ASYNC_PHASE_ADDRESS:
+		case WII_ASYNC_PHASE_WRITE:
+			if( !bus->acked(i2c) )
+			{
+				WiiAsync_Stop(queue, WII_LIB_RC_I2C_ERROR);
+			}
+			else if( queue->index >= transfer->len )
+			{
+				WiiAsync_Stop(queue, WII_LIB_RC_SUCCESS);
+			}
+			else if( transfer->read )
+			{
+				queue->phase = WII_ASYNC_PHASE_READ;
+				bus->receive(i2c);
+			}
+			else
+			{
+				queue->phase = WII_ASYNC_PHASE_WRITE;
+				bus->write( i2c, transfer->data[queue->index++] );
+			}
+			break;
+		
+		case WII_ASYNC_PHASE_READ:
+			transfer->data[queue->index++]	= bus->readByte(i2c);
+			queue->phase					= WII_ASYNC_PHASE_ACK;
+			bus->ack( i2c, (queue->index < transfer->len) );
+			break;
+		
+		case WII_ASYNC_PHASE_ACK:
+			if( queue->index >= transfer->len )
+			{
+				WiiAsync_Stop(queue, WII_LIB_RC_SUCCESS);
+			}
+			else
+			{
+				queue->phase = WII_ASYNC_PHASE_READ;
+				bus->receive(i2c);
+			}
+			break;
+		
+		case WII_ASYNC_PHASE_STOP:
+			WiiAsync_Complete(queue);
+			break;
+		
+		default:
+			break;
+	}
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Issues the start condition for the transfer at the head of the queue.
+//!	
+//!	@param[in]		*queue				Queue to start.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiAsync_Start( WiiAsync_Queue *queue )
+{
+	WiiAsync_Transfer	*transfer	= &queue->transfers[queue->head & (WII_ASYNC_QUEUE_DEPTH - 1)];
+	
+	queue->phase = WII_ASYNC_PHASE_START;
+	transfer->device->backend->bus->start( &transfer->device->i2c );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Records the result of the active transfer and issues the stop condition.
+//!	
+//!	@param[in]		*queue				Queue servicing the transfer.
+//!	@param[in]		result				Result of the transfer.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiAsync_Stop( WiiAsync_Queue *queue, WII_LIB_RC result )
+{
+	WiiAsync_Transfer	*transfer	= &queue->transfers[queue->head & (WII_ASYNC_QUEUE_DEPTH - 1)];
+	
+	transfer->result	= result;
+	queue->phase		= WII_ASYNC_PHASE_STOP;
+	transfer->device->backend->bus->stop( &transfer->device->i2c );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Retires the active transfer, invokes its callback, and starts the next transfer 
+//!					(if any).
+//!	
+//!	@details		The transfer is copied out and the head advanced before the callback runs so the 
+//!					slot is already free by the time the callback executes. Transfers depending on 
+//!					a failed transfer (see 'WiiAsync_Transfer.chained') are retired the same way 
+//!					with the failed result and never reach the bus.
+//!	
+//!	@param[in]		*queue				Queue servicing the transfer.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiAsync_Complete( WiiAsync_Queue *queue )
+{
+	WiiAsync_Transfer	transfer	= queue->transfers[queue->head & (WII_ASYNC_QUEUE_DEPTH - 1)];
+	WII_LIB_RC			result;
+	
+	// Release the slot only once the transfer has been copied out.
+	WII_ASYNC_BARRIER();
+	queue->head++;
+	queue->phase = WII_ASYNC_PHASE_IDLE;
+	
+	if( transfer.callback )
+		transfer.callback(&transfer);
+	
+	while( transfer.chained && transfer.result != WII_LIB_RC_SUCCESS && queue->head != queue->tail )
+	{
+		result = transfer.result;
+		WII_ASYNC_BARRIER();
+		transfer		= queue->transfers[queue->head & (WII_ASYNC_QUEUE_DEPTH - 1)];
+		transfer.result	= result;
+		WII_ASYNC_BARRIER();
+		queue->head++;
+		
+		if( transfer.callback )
+			transfer.callback(&transfer);
+	}
+	
+	if( queue->head != queue->tail )
+	{
+		// Read the next slot only after seeing the tail that published it.
+		WII_ASYNC_BARRIER();
+		WiiAsync_Start(queue);
+	}
+	else
+	{
+		queue->running = FALSE;
+	}
+}
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements the default backend for the "wii" library module using lib-i2c and 
+//!					lib-timing.
+//!	
+//!	@note			Host builds link "host/wii_sim.c" in place of this file.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <xc.h>
+#include "i2c.h"
+#include "wii_backend.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static I2C_RC		WiiBackend_Init(		I2C_Device *i2c,	uint32_t pbClk		);
+static void			WiiBackend_DelayMs(		uint32_t ms								);
+static uint32_t		WiiBackend_Cycles(		void									);
+static void			WiiBackend_BusStart(	I2C_Device *i2c							);
+static void			WiiBackend_BusStop(		I2C_Device *i2c							);
+static void			WiiBackend_BusWrite(	I2C_Device *i2c,	uint8_t data		);
+static void			WiiBackend_BusReceive(	I2C_Device *i2c							);
+static uint8_t		WiiBackend_BusReadByte(	I2C_Device *i2c							);
+static void			WiiBackend_BusAck(		I2C_Device *i2c,	BOOL ack			);
+static BOOL			WiiBackend_BusAcked(	I2C_Device *i2c							);
+
+
+
+
+//==================================================================================================
+//	PRIVATE VARIABLES
+//--------------------------------------------------------------------------------------------------
+// Non-blocking primitives built on the peripheral library. Each sets the flag for the I2C master 
+// interrupt once the bus phase completes.
+static const WiiLib_BusOps	WiiBackend_BusOps	=
+{
+	WiiBackend_BusStart,
+	WiiBackend_BusStop,
+	WiiBackend_BusWrite,
+	WiiBackend_BusReceive,
+	WiiBackend_BusReadByte,
+	WiiBackend_BusAck,
+	WiiBackend_BusAcked
+};
+
+
+
+
+//==================================================================================================
+//	PUBLIC VARIABLES
+//--------------------------------------------------------------------------------------------------
+const WiiLib_Backend	WiiLib_BackendDefault	=
+{
+	WiiBackend_Init,
+	I2C_Transmit,
+	I2C_Receive,
+	I2C_TxRx,
+	WiiBackend_DelayMs,
+	&WiiBackend_BusOps,
+	WiiBackend_Cycles
+};
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Initializes the delay module and the I2C port used by the provided device.
+//!	
+//!	@details		Presume delay not yet initialized and initialize delay module. Even if this is 
+//!					not the case, should have no harm (in theory/so long as pbClk not different 
+//!					between devices).
+//!	
+//!	@param[in]		*i2c				I2C device whose port should be initialized.
+//!	@param[in]		pbClk				Current peripheral bus clock.
+//!	
+//!	@returns		Return code from lib-i2c.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static I2C_RC WiiBackend_Init( I2C_Device *i2c, uint32_t pbClk )
+{
+	Delay_Init(pbClk);
+	return I2C_InitPort( &i2c->port, pbClk, FALSE );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Wrapper around lib-timing's blocking delay.
+//!	
+//!	@param[in]		ms					Time to delay in milliseconds.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBackend_DelayMs( uint32_t ms )
+{
+	Delay_Ms(ms);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reads the core timer (CP0 Count register).
+//!	
+//!	@returns		Current count (increments at half the system clock).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint32_t WiiBackend_Cycles( void )
+{
+	return _CP0_GET_COUNT();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Issues a start condition on the module used by the provided device.
+//!	
+//!	@param[in]		*i2c				I2C device to communicate with.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBackend_BusStart( I2C_Device *i2c )
+{
+	I2CStart( i2c->port.module );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Issues a stop condition on the module used by the provided device.
+//!	
+//!	@param[in]		*i2c				I2C device to communicate with.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBackend_BusStop( I2C_Device *i2c )
+{
+	I2CStop( i2c->port.module );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Loads a single byte into the transmit register of the module.
+//!	
+//!	@param[in]		*i2c				I2C device to communicate with.
+//!	@param[in]		data				Byte to send.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBackend_BusWrite( I2C_Device *i2c, uint8_t data )
+{
+	I2CSendByte( i2c->port.module, data );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Enables the receiver of the module for a single byte.
+//!	
+//!	@param[in]		*i2c				I2C device to communicate with.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBackend_BusReceive( I2C_Device *i2c )
+{
+	I2CReceiverEnable( i2c->port.module, TRUE );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Returns the byte held in the receive register of the module.
+//!	
+//!	@param[in]		*i2c				I2C device to communicate with.
+//!	
+//!	@returns		Byte received.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint8_t WiiBackend_BusReadByte( I2C_Device *i2c )
+{
+	return I2CGetByte( i2c->port.module );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Sends an ack or nack for the byte just received.
+//!	
+//!	@param[in]		*i2c				I2C device to communicate with.
+//!	@param[in]		ack					TRUE to ack (more bytes wanted) or FALSE to nack.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiBackend_BusAck( I2C_Device *i2c, BOOL ack )
+{
+	I2CAcknowledgeByte( i2c->port.module, ack );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reports if the target acknowledged the last byte sent.
+//!	
+//!	@param[in]		*i2c				I2C device to communicate with.
+//!	
+//!	@returns		TRUE if acknowledged.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiBackend_BusAcked( I2C_Device *i2c )
+{
+	return I2CByteWasAcknowledged( i2c->port.module );
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements decoding of large sets of captured status frames into 
+//!					structure-of-arrays outputs.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stddef.h>
+#include "i2c.h"
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE CONSTANTS
+//--------------------------------------------------------------------------------------------------
+// Expands a field descriptor row (see "wii_lib.h") into a loop over the present block. Expects 
+// 'planes' (bytes of the block transposed by frame byte index), 'first' (index of the first frame 
+// of the block), 'blockCount' (frames in the block), 'index' and 'arrays' in scope. Rows for 
+// outputs set to NULL are skipped.
+#define	WII_BATCH_DECODE_FIELD( destination, op, byte, shift, width, destShift, invert )				\
+	if( arrays.destination != NULL )																	\
+	{																									\
+		for( index = 0; index < blockCount; ++index )													\
+			(arrays.destination + first)[index] op WII_LIB_FIELD_VALUE( planes[(byte)][index], shift, width, destShift, invert );	\
+	}
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Decodes a contiguous array of raw status frames.
+//!	
+//!	@details		Frames are processed in blocks of 'WII_BATCH_BLOCK_FRAMES'. Each block is first 
+//!					transposed into byte planes, then every descriptor row of the target runs as 
+//!					its own loop (one contiguous byte plane in, one output array updated) which 
+//!					keeps the loops simple enough for the compiler to vectorize.
+//!	
+//!	@note			'*output' is copied to a local instance so stores to the (char sized) trigger 
+//!					arrays cannot alias the array pointers (which would prevent vectorization).
+//!	
+//!	@param[in]		target				Target type the frames were captured from.
+//!	@param[in]		*frames				Raw (decrypted) frames, 'WII_BATCH_FRAME_LEN' bytes each.
+//!	@param[in]		count				Number of frames to decode.
+//!	@param[in]		*output				Destination arrays (see 'WiiBatch_Output{}').
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiBatch_Decode( WII_LIB_TARGET_DEVICE target, const uint8_t *frames, uint32_t count, const WiiBatch_Output *output )
+{
+	uint8_t			planes[WII_BATCH_FRAME_LEN][WII_BATCH_BLOCK_FRAMES];
+	WiiBatch_Output	arrays		= *output;
+	const uint8_t	*block;
+	uint32_t		first;
+	uint32_t		blockCount;
+	uint32_t		index;
+	uint32_t		byte;
+	
+	switch( target )
+	{
+		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
+		case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
+			break;
+		
+		default:
+			return WII_LIB_RC_UNSUPPORTED_DEVICE;
+		
+	}
+	
+	for( first = 0; first < count; first += blockCount )
+	{
+		block		= &frames[first * WII_BATCH_FRAME_LEN];
+		blockCount	= ( (count - first) < WII_BATCH_BLOCK_FRAMES ) ? (count - first) : WII_BATCH_BLOCK_FRAMES;
+		
+		for( index = 0; index < blockCount; ++index )
+			for( byte = 0; byte < WII_BATCH_FRAME_LEN; ++byte )
+				planes[byte][index] = block[index * WII_BATCH_FRAME_LEN + byte];
+		
+		switch( target )
+		{
+			case WII_LIB_TARGET_DEVICE_NUNCHUCK:
+				WII_NUNCHUCK_FIELDS_NORMAL( WII_BATCH_DECODE_FIELD )
+				WII_NUNCHUCK_FIELDS_RIGHT_JOYSTICK( WII_BATCH_DECODE_FIELD )
+				break;
+			
+			case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
+				WII_NUNCHUCK_FIELDS_PASS_THROUGH( WII_BATCH_DECODE_FIELD )
+				WII_NUNCHUCK_FIELDS_RIGHT_JOYSTICK( WII_BATCH_DECODE_FIELD )
+				break;
+			
+			case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
+				WII_CLASSIC_CONTROLLER_FIELDS_NORMAL( WII_BATCH_DECODE_FIELD )
+				break;
+			
+			default:
+				WII_CLASSIC_CONTROLLER_FIELDS_PASS_THROUGH( WII_BATCH_DECODE_FIELD )
+				break;
+		
+		}
+	}
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
@@ -0,0 +1,360 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements reading and caching of the factory calibration of Wii targets.
+//!	
+//!	@details		The calibration block is decoded with the calibration field descriptor tables 
+//!					of the target (see "wii_nunchuck.h" and "wii_classic_controller.h") into the same 
+//!					units the status decoders report.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+#include "i2c.h"
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static BOOL						WiiCalibration_Matches(				const WiiCalibration_Entry *entry,	WiiLib_Device *device,		const uint8_t *checksum		);
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Initializes a calibration cache.
+//!	
+//!	@param[in]		*cache				Cache to initialize.
+//!	@param[in]		*entries			Storage for the cached values.
+//!	@param[in]		count				Number of entries in 'entries[]'.
+//!	@param[in]		keep				Flag indicating if the present content of 'entries[]' is kept 
+//!										(e.g. loaded from non-volatile memory). Otherwise all 
+//!										entries are cleared.
+//!	@param[in]		persist				Invoked whenever an entry is stored (NULL == RAM only).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiCalibration_Init( WiiCalibration_Cache *cache, WiiCalibration_Entry *entries, uint8_t count, BOOL keep, WiiCalibration_Persist persist )
+{
+	if( !keep )
+		memset( entries, 0, count * sizeof(WiiCalibration_Entry) );
+	
+	cache->entries	= entries;
+	cache->count	= count;
+	cache->persist	= persist;
+	cache->context	= NULL;
+	
+	// Fill free entries first.
+	for( cache->next = 0; cache->next < count; ++cache->next )
+	{
+		if( !entries[cache->next].valid )
+			break;
+	}
+	
+	if( cache->next >= count )
+		cache->next = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Uses the provided cache for the calibration of the device.
+//!	
+//!	@details		Passing a NULL cache detaches it (home position is measured while connecting). 
+//!					Takes effect the next time the device connects.
+//!	
+//!	@param[in]		*cache				Cache initialized with 'WiiCalibration_Init()'.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiCalibration_Attach( WiiCalibration_Cache *cache, WiiLib_Device *device )
+{
+	device->calibrationCache = cache;
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Validates and decodes a calibration block.
+//!	
+//!	@param[in]		target				Target type the block was read from.
+//!	@param[in]		report				Report profile of the device (selects the resolution the 
+//!										values are reduced to).
+//!	@param[in]		*block				'WII_CALIBRATION_BLOCK_LEN' bytes read (and decrypted) from 
+//!										'WII_LIB_PARAM_RAW_DATA'.
+//!	@param[out]		*calibration		Calibration values.
+//!	
+//!	@retval			WII_LIB_RC_DATA_RECEIVED_IS_INVALID		Checksum mismatch.
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiCalibration_Parse( WII_LIB_TARGET_DEVICE target, WII_LIB_REPORT report, const uint8_t *block, WiiCalibration_Data *calibration )
+{
+	const uint8_t			*data		= block;
+	WiiCalibration_Data		*current	= calibration;
+	uint8_t					sum			= 0;
+	uint8_t					index;
+	
+	for( index = 0; index < WII_CALIBRATION_CHECKSUM_OFFSET; ++index )
+		sum += block[index];
+	
+	if(	block[WII_CALIBRATION_CHECKSUM_OFFSET] != (uint8_t)(sum + WII_CALIBRATION_CHECKSUM_SEED_1) ||
+		block[WII_CALIBRATION_CHECKSUM_OFFSET + 1] != (uint8_t)(sum + WII_CALIBRATION_CHECKSUM_SEED_2) )
+	{
+		return WII_LIB_RC_DATA_RECEIVED_IS_INVALID;
+	}
+	
+	memset( calibration, 0, sizeof(WiiCalibration_Data) );
+	
+	switch( target )
+	{
+		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
+			WII_NUNCHUCK_FIELDS_CALIBRATION( WII_LIB_DECODE_FIELD )
+			
+			// Single joystick (see 'WiiNunchuck_ProcessStatusParam()') and accelerometer minimum 
+			// mirrors 1g around 0g.
+			current->minimum.analogRightX	= current->minimum.analogLeftX;
+			current->minimum.analogRightY	= current->minimum.analogLeftY;
+			current->center.analogRightX	= current->center.analogLeftX;
+			current->center.analogRightY	= current->center.analogLeftY;
+			current->maximum.analogRightX	= current->maximum.analogLeftX;
+			current->maximum.analogRightY	= current->maximum.analogLeftY;
+			current->minimum.accelX			= 2 * current->center.accelX - current->maximum.accelX;
+			current->minimum.accelY			= 2 * current->center.accelY - current->maximum.accelY;
+			current->minimum.accelZ			= 2 * current->center.accelZ - current->maximum.accelZ;
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
+			if( report == WII_LIB_REPORT_HIGH_RESOLUTION )
+			{
+				WII_CLASSIC_CONTROLLER_FIELDS_CALIBRATION_HIGH_RES( WII_LIB_DECODE_FIELD )
+				current->maximum.triggerLeft	= WII_CLASSIC_CONTROLLER_HIGH_RES_TRIGGER_MAX;
+				current->maximum.triggerRight	= WII_CLASSIC_CONTROLLER_HIGH_RES_TRIGGER_MAX;
+			}
+			else
+			{
+				WII_CLASSIC_CONTROLLER_FIELDS_CALIBRATION( WII_LIB_DECODE_FIELD )
+				current->maximum.triggerLeft	= WII_CLASSIC_CONTROLLER_TRIGGER_MAX;
+				current->maximum.triggerRight	= WII_CLASSIC_CONTROLLER_TRIGGER_MAX;
+			}
+			
+			// Triggers rest at their minimum.
+			current->minimum.triggerLeft	= current->center.triggerLeft;
+			current->minimum.triggerRight	= current->center.triggerRight;
+			break;
+		
+		default:
+			return WII_LIB_RC_UNSUPPORTED_DEVICE;
+		
+	}
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Checks if the calibration of the device can be looked up.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}' (target type known).
+//!	
+//!	@retval			TRUE				Cache attached and the target type has a calibration block. 
+//!										Read 'WII_LIB_PARAM_CALIBRATION_CHECKSUM' and pass the 
+//!										result to 'WiiCalibration_Find()'.
+//!	@retval			FALSE				No cache attached or the target type has no calibration 
+//!										block.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL WiiCalibration_IsSupported( WiiLib_Device *device )
+{
+	if( !device->calibrationCache )
+		return FALSE;
+	
+	switch( device->target )
+	{
+		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
+		case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
+			return TRUE;
+		
+		default:
+			return FALSE;
+		
+	}
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Looks up the calibration of the device in its cache.
+//!	
+//!	@details		Must be invoked once the ID of the target ('device->id[]') and the checksum of 
+//!					its calibration block were read. When found, 'device->calibration' is set and the 
+//!					calibration is used as home position (see 'WiiCalibration_ApplyHome()').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		*checksum			'WII_CALIBRATION_CHECKSUM_LEN' bytes read (and decrypted) 
+//!										from 'WII_LIB_PARAM_CALIBRATION_CHECKSUM'.
+//!	
+//!	@retval			WII_LIB_RC_SUCCESS				Calibration found.
+//!	@retval			WII_LIB_RC_PENDING				Not cached yet. Read 'WII_LIB_PARAM_RAW_DATA' and 
+//!													pass the result to 'WiiCalibration_Store()'.
+//!	@retval			WII_LIB_RC_UNSUPPORTED_DEVICE	No cache attached or the target type has no 
+//!													calibration block (see 
+//!													'WiiCalibration_IsSupported()').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiCalibration_Find( WiiLib_Device *device, const uint8_t *checksum )
+{
+	WiiCalibration_Cache	*cache		= device->calibrationCache;
+	uint8_t					index;
+	
+	device->calibration = NULL;
+	
+	if( !WiiCalibration_IsSupported( device ) )
+		return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	
+	for( index = 0; index < cache->count; ++index )
+	{
+		if( WiiCalibration_Matches( &cache->entries[index], device, checksum ) )
+		{
+			device->calibration = &cache->entries[index].data;
+			WiiCalibration_ApplyHome( device );
+			return WII_LIB_RC_SUCCESS;
+		}
+	}
+	
+	return WII_LIB_RC_PENDING;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Validates a calibration block read from the device and stores it in the cache.
+//!	
+//!	@details		On success 'device->calibration' is set, the calibration is used as home 
+//!					position, and the 'persist' function of the cache is invoked.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		*block				'WII_CALIBRATION_BLOCK_LEN' bytes read (and decrypted) from 
+//!										'WII_LIB_PARAM_RAW_DATA'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiCalibration_Store( WiiLib_Device *device, const uint8_t *block )
+{
+	WiiCalibration_Cache	*cache		= device->calibrationCache;
+	WiiCalibration_Entry	*entry;
+	WiiCalibration_Data		data;
+	uint8_t					index;
+	WII_LIB_RC				returnCode;
+	
+	device->calibration = NULL;
+	
+	if( !cache || !cache->count )
+		return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	
+	returnCode = WiiCalibration_Parse( device->target, device->report, block, &data );
+	if( returnCode != WII_LIB_RC_SUCCESS )
+		return returnCode;
+	
+	index		= cache->next;
+	cache->next	= (uint8_t)( (index + 1) % cache->count );
+	
+	entry				= &cache->entries[index];
+	memcpy( &entry->id[0], &device->id[0], WII_LIB_ID_LENGTH );
+	entry->module		= (uint8_t)device->i2c.port.module;
+	entry->muxAddr		= device->muxAddr;
+	entry->muxSelect	= device->muxSelect;
+	memcpy( &entry->checksum[0], &block[WII_CALIBRATION_CHECKSUM_OFFSET], WII_CALIBRATION_CHECKSUM_LEN );
+	entry->valid		= TRUE;
+	entry->data			= data;
+	
+	if( cache->persist )
+		cache->persist( cache, index );
+	
+	device->calibration = &entry->data;
+	WiiCalibration_ApplyHome( device );
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Blocking lookup of the device calibration (reads the checksum of the block, and 
+//!					the block itself when not cached).
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiCalibration_Load( WiiLib_Device *device )
+{
+	WII_LIB_RC		returnCode;
+	
+	device->calibration = NULL;
+	
+	if( !WiiCalibration_IsSupported( device ) )
+		return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	
+	returnCode = WiiLib_QueryParameter( device, WII_LIB_PARAM_CALIBRATION_CHECKSUM );
+	if( returnCode != WII_LIB_RC_SUCCESS )
+		return returnCode;
+	
+	returnCode = WiiCalibration_Find( device, &device->dataCurrent[0] );
+	if( returnCode != WII_LIB_RC_PENDING )
+		return returnCode;
+	
+	returnCode = WiiLib_QueryParameter( device, WII_LIB_PARAM_RAW_DATA );
+	if( returnCode != WII_LIB_RC_SUCCESS )
+		return returnCode;
+	
+	return WiiCalibration_Store( device, &device->dataCurrent[0] );
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Uses the calibration of the device as its home position.
+//!	
+//!	@details		Joysticks and triggers use their rest values. The accelerometer uses the device 
+//!					held level (0g along x and y, 1g along z).
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}' (with 'calibration' set).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiCalibration_ApplyHome( WiiLib_Device *device )
+{
+	device->interfaceHome			= device->calibration->center;
+	device->interfaceHome.accelZ	= device->calibration->maximum.accelZ;
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Checks if a cache entry belongs to the target of the device.
+//!	
+//!	@param[in]		*entry				Cache entry to check.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		*checksum			Checksum bytes of the calibration block of the target.
+//!	
+//!	@retval			TRUE				Entry belongs to the target.
+//!	@retval			FALSE				Entry does not belong to the target.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiCalibration_Matches( const WiiCalibration_Entry *entry, WiiLib_Device *device, const uint8_t *checksum )
+{
+	return	entry->valid && entry->module == (uint8_t)device->i2c.port.module &&
+			entry->muxAddr == device->muxAddr && entry->muxSelect == device->muxSelect &&
+			!memcmp( &entry->id[0], &device->id[0], WII_LIB_ID_LENGTH ) &&
+			!memcmp( &entry->checksum[0], checksum, WII_CALIBRATION_CHECKSUM_LEN );
+}
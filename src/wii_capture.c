@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements the optional traffic recorder of the "wii" library module.
+//!	
+//!	@details		Each response recorded is compared against the previous record. When the target 
+//!					type, parameter, register, and length match, only the bytes that changed are 
+//!					stored (behind a bitmap) unless storing them all is as short. Please see 
+//!					"wii_capture.h" for the layout of the log.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+#include "i2c.h"
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static void				WiiCapture_Reserve(				WiiCapture_Recorder *recorder,	uint32_t len				);
+static uint8_t *		WiiCapture_PutVarint(			uint8_t *out,					uint32_t value				);
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Initializes an empty recorder.
+//!	
+//!	@param[out]		*recorder			Recorder to initialize.
+//!	@param[in]		sink				Destination of the log.
+//!	@param[in]		*context			Value passed to 'sink'.
+//!	@param[in]		clock				Source of record timestamps (NULL == timestamps are zero).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiCapture_Init( WiiCapture_Recorder *recorder, WiiCapture_Sink sink, void *context, WiiCapture_Clock clock )
+{
+	memset( (void *)recorder, 0, sizeof(WiiCapture_Recorder) );
+	recorder->sink		= sink;
+	recorder->context	= context;
+	recorder->clock		= clock;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Attaches a recorder to a device so every response processed is logged.
+//!	
+//!	@details		Passing a NULL recorder stops recording (records still buffered are kept until 
+//!					'WiiCapture_Flush()').
+//!	
+//!	@param[in]		*recorder			Recorder initialized with 'WiiCapture_Init()' (must outlive 
+//!										the attachment).
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiCapture_Attach( WiiCapture_Recorder *recorder, WiiLib_Device *device )
+{
+	if( recorder && !recorder->sink )
+		return WII_LIB_RC_TARGET_STRUCTURE_NOT_DEFINED;
+	
+	device->capture = recorder;
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Appends a response to the log of the device.
+//!	
+//!	@details		Invoked by the library for each response processed when a recorder is attached. 
+//!					Runs in the context that processed the response.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}' with an attached recorder.
+//!	@param[in]		param				Parameter queried.
+//!	@param[in]		reg					Register the response was read from.
+//!	@param[in]		*data				Response (decrypted if the target encrypts).
+//!	@param[in]		len					Number of bytes in the response.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiCapture_Record( WiiLib_Device *device, WII_LIB_PARAM param, uint8_t reg, const uint8_t *data, uint32_t len )
+{
+	WiiCapture_Recorder		*recorder	= device->capture;
+	uint8_t					bitmap[WII_CAPTURE_BITMAP_LEN]	= {0};
+	uint8_t					*tag;
+	uint8_t					*out;
+	uint32_t				nowUs;
+	uint32_t				changed		= 0;
+	uint32_t				index;
+	BOOL					header;
+	
+	if( len > WII_LIB_MAX_PAYLOAD_SIZE )
+		len = WII_LIB_MAX_PAYLOAD_SIZE;
+	
+	header = (	!recorder->len || recorder->target != (uint8_t)device->target || recorder->param != (uint8_t)param || 
+				recorder->reg != reg || recorder->len != len );
+	
+	// Bytes that differ from the previous record (only comparable when the header is unchanged).
+	if( !header )
+	{
+		for( index = 0; index < len; ++index )
+		{
+			if( data[index] != recorder->previous[index] )
+			{
+				bitmap[index >> 3] |= (uint8_t)( 1 << (index & 7) );
+				++changed;
+			}
+		}
+	}
+	
+	if( !recorder->started )
+	{
+		WiiCapture_Reserve( recorder, WII_CAPTURE_MAGIC_LEN + 1 );
+		memcpy( &recorder->buffer[recorder->used], WII_CAPTURE_MAGIC, WII_CAPTURE_MAGIC_LEN );
+		recorder->buffer[recorder->used + WII_CAPTURE_MAGIC_LEN] = WII_CAPTURE_VERSION;
+		recorder->used		+= WII_CAPTURE_MAGIC_LEN + 1;
+		recorder->started	= TRUE;
+	}
+	
+	WiiCapture_Reserve( recorder, WII_CAPTURE_RECORD_MAX_LEN );
+	
+	nowUs	= ( recorder->clock ? recorder->clock() : 0 );
+	tag		= &recorder->buffer[recorder->used];
+	*tag	= 0;
+	out		= WiiCapture_PutVarint( tag + 1, nowUs - recorder->timeUs );
+	
+	if( header )
+	{
+		*tag	|= WII_CAPTURE_TAG_HEADER;
+		*out++	= (uint8_t)device->target;
+		*out++	= (uint8_t)param;
+		*out++	= reg;
+		*out++	= (uint8_t)len;
+		
+		recorder->target	= (uint8_t)device->target;
+		recorder->param		= (uint8_t)param;
+		recorder->reg		= reg;
+		recorder->len		= (uint8_t)len;
+	}
+	
+	if( header || ((len + 7) >> 3) + changed >= len )
+	{
+		*tag |= WII_CAPTURE_TAG_RAW;
+		memcpy( out, data, len );
+		out += len;
+	}
+	else
+	{
+		memcpy( out, &bitmap[0], (len + 7) >> 3 );
+		out += (len + 7) >> 3;
+		
+		for( index = 0; index < len; ++index )
+		{
+			if( bitmap[index >> 3] & (1 << (index & 7)) )
+				*out++ = data[index];
+		}
+	}
+	
+	memcpy( &recorder->previous[0], data, len );
+	recorder->timeUs	= nowUs;
+	recorder->used		= (uint32_t)( out - &recorder->buffer[0] );
+	++recorder->records;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Hands every record still buffered to the sink.
+//!	
+//!	@note			Must not be invoked while the device may be recording from another context 
+//!					(e.g. the I2C interrupt).
+//!	
+//!	@param[in]		*recorder			Recorder to flush.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiCapture_Flush( WiiCapture_Recorder *recorder )
+{
+	if( recorder->used )
+		recorder->sink( recorder->context, &recorder->buffer[0], recorder->used );
+	
+	recorder->used = 0;
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Makes room in the buffer of a recorder by flushing it if needed.
+//!	
+//!	@param[in]		*recorder			Recorder about to append.
+//!	@param[in]		len					Most bytes about to be appended.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiCapture_Reserve( WiiCapture_Recorder *recorder, uint32_t len )
+{
+	if( recorder->used + len > WII_CAPTURE_BUFFER_SIZE )
+		WiiCapture_Flush( recorder );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Writes a value as LEB128 (seven bits per byte, least significant first).
+//!	
+//!	@param[out]		*out				Destination (up to five bytes are written).
+//!	@param[in]		value				Value to write.
+//!	
+//!	@returns		Position following the last byte written.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint8_t * WiiCapture_PutVarint( uint8_t *out, uint32_t value )
+{
+	while( value >= 0x80 )
+	{
+		*out++	= (uint8_t)( value | 0x80 );
+		value	>>= 7;
+	}
+	
+	*out++ = (uint8_t)value;
+	return out;
+	
+}
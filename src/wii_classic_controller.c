@@ -9,12 +9,46 @@
 //==================================================================================================
 //	INCLUDES
 //--------------------------------------------------------------------------------------------------
+#include <stddef.h>
 #include "i2c.h"
 #include "wii_classic_controller.h"
 
 
 
 
+//==================================================================================================
+//	PRIVATE CONSTANTS
+//--------------------------------------------------------------------------------------------------
+// Configuration messages for the high-resolution report. Same as the standard messages followed by 
+// the data format (see 'WII_CLASSIC_CONTROLLER_REG_DATA_FORMAT').
+static const uint8_t			WiiClassic_ConfigEncryptedHighRes[]		= { 0x40, 0x00,		WII_CLASSIC_CONTROLLER_REG_DATA_FORMAT, WII_CLASSIC_CONTROLLER_DATA_FORMAT_HIGH_RES };					//!< Encrypted, high-resolution data format.
+static const uint8_t			WiiClassic_ConfigDecryptedHighRes[]		= { 0xF0, 0x55,		0xFB, 0x00,		WII_CLASSIC_CONTROLLER_REG_DATA_FORMAT, WII_CLASSIC_CONTROLLER_DATA_FORMAT_HIGH_RES };	//!< Decrypted, high-resolution data format.
+
+// Change each analog control must exceed to count as activity (see 'WiiDriver_Thresholds'), in 
+// counts of the standard and of the high-resolution data format.
+static const uint16_t			WiiClassic_Thresholds[WII_LIB_CONTROL_ANALOG_COUNT]	=
+{
+	[WII_LIB_CONTROL_TRIGGER_LEFT	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_TRIGGERS,
+	[WII_LIB_CONTROL_TRIGGER_RIGHT	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_TRIGGERS,
+	[WII_LIB_CONTROL_ANALOG_LEFT_X	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_ANALOG_LEFT,
+	[WII_LIB_CONTROL_ANALOG_LEFT_Y	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_ANALOG_LEFT,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_X	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_ANALOG_RIGHT,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_Y	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_ANALOG_RIGHT,
+};
+
+static const uint16_t			WiiClassic_ThresholdsHighRes[WII_LIB_CONTROL_ANALOG_COUNT]	=
+{
+	[WII_LIB_CONTROL_TRIGGER_LEFT	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_HIGH_RES_THRESHOLD_TRIGGERS,
+	[WII_LIB_CONTROL_TRIGGER_RIGHT	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_HIGH_RES_THRESHOLD_TRIGGERS,
+	[WII_LIB_CONTROL_ANALOG_LEFT_X	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_HIGH_RES_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_LEFT_Y	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_HIGH_RES_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_X	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_HIGH_RES_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_Y	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_HIGH_RES_THRESHOLD_ANALOG,
+};
+
+
+
+
 //==================================================================================================
 // PUBLIC METHODS
 //--------------------------------------------------------------------------------------------------
@@ -23,7 +57,8 @@
 //!					status register.
 //!	
 //!	@details		Populates the relevant 'device->interfaceCurrent' values by applying the 
-//!					appropriate bitfield mapping and merging values.
+//!					field descriptor table for the target mode and report profile (see 
+//!					'WiiLib_SetReport()'). A buttons-only report only updates the buttons.
 //!	
 //!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
 //!	
@@ -32,71 +67,29 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 WII_LIB_RC WiiClassic_ProcessStatusParam(WiiLib_Device *device)
 {
+	const uint8_t		*data		= &device->dataCurrent[0];
+	WiiLib_Interface	*current	= &device->interfaceCurrent;
+	
 	switch( device->target )
 	{
 		case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
-		{
-			WiiClassic_StatusNormal	*bitfields			= (WiiClassic_StatusNormal*)&device->dataCurrent[0];
-			
-			// Discrete Buttons:
-			device->interfaceCurrent.buttonA			= !(bitfields->buttonA & 0x01);
-			device->interfaceCurrent.buttonB			= !(bitfields->buttonB & 0x01);
-			device->interfaceCurrent.buttonX			= !(bitfields->buttonX & 0x01);
-			device->interfaceCurrent.buttonY			= !(bitfields->buttonY & 0x01);
-			device->interfaceCurrent.buttonZL			= !(bitfields->buttonZLeft & 0x01);
-			device->interfaceCurrent.buttonZR			= !(bitfields->buttonZRight & 0x01);
-			device->interfaceCurrent.buttonMinus		= !(bitfields->buttonMinus & 0x01);
-			device->interfaceCurrent.buttonHome			= !(bitfields->buttonHome & 0x01);
-			device->interfaceCurrent.buttonPlus			= !(bitfields->buttonPlus & 0x01);
-			// D-Pad Buttons:
-			device->interfaceCurrent.dpadLeft			= !(bitfields->dpadLeft & 0x01);
-			device->interfaceCurrent.dpadUp				= !(bitfields->dpadUp & 0x01);
-			device->interfaceCurrent.dpadRight			= !(bitfields->dpadRight & 0x01);
-			device->interfaceCurrent.dpadDown			= !(bitfields->dpadDown & 0x01);
-			// Triggers:
-			device->interfaceCurrent.buttonLeftTrigger	= !(bitfields->buttonTriggerLeft & 0x01);
-			device->interfaceCurrent.buttonRightTrigger	= !(bitfields->buttonTriggerRight & 0x01);
-			device->interfaceCurrent.triggerLeft		= ( ((bitfields->leftTriggerHigh & 0x03) << 3) | (bitfields->leftTriggerLow & 0x07) );
-			device->interfaceCurrent.triggerRight		= bitfields->rightTrigger;
-			// Analog Joysticks:
-			device->interfaceCurrent.analogLeftX		= bitfields->analogLeftX;
-			device->interfaceCurrent.analogLeftY		= bitfields->analogLeftY;
-			device->interfaceCurrent.analogRightX		= ( ((bitfields->analogRightXHigh & 0x03) << 3) | ((bitfields->analogRightXMid & 0x03) << 1) | (bitfields->analogRightXLow & 0x01) );
-			device->interfaceCurrent.analogRightY		= bitfields->analogRightY;
+			if( device->report == WII_LIB_REPORT_BUTTONS )
+			{
+				WII_CLASSIC_CONTROLLER_FIELDS_BUTTONS( WII_LIB_DECODE_FIELD )
+			}
+			else if( device->report == WII_LIB_REPORT_HIGH_RESOLUTION )
+			{
+				WII_CLASSIC_CONTROLLER_FIELDS_HIGH_RES( WII_LIB_DECODE_FIELD )
+			}
+			else
+			{
+				WII_CLASSIC_CONTROLLER_FIELDS_NORMAL( WII_LIB_DECODE_FIELD )
+			}
 			break;
-		}
 		
 		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
-		{
-			WiiClassic_StatusPassThrough	*bitfields	= (WiiClassic_StatusPassThrough*)&device->dataCurrent[0];
-			
-			// Discrete Buttons:
-			device->interfaceCurrent.buttonA			= !(bitfields->buttonA & 0x01);
-			device->interfaceCurrent.buttonB			= !(bitfields->buttonB & 0x01);
-			device->interfaceCurrent.buttonX			= !(bitfields->buttonX & 0x01);
-			device->interfaceCurrent.buttonY			= !(bitfields->buttonY & 0x01);
-			device->interfaceCurrent.buttonZL			= !(bitfields->buttonZLeft & 0x01);
-			device->interfaceCurrent.buttonZR			= !(bitfields->buttonZRight & 0x01);
-			device->interfaceCurrent.buttonMinus		= !(bitfields->buttonMinus & 0x01);
-			device->interfaceCurrent.buttonHome			= !(bitfields->buttonHome & 0x01);
-			device->interfaceCurrent.buttonPlus			= !(bitfields->buttonPlus & 0x01);
-			// D-Pad Buttons:
-			device->interfaceCurrent.dpadLeft			= !(bitfields->dpadLeft & 0x01);
-			device->interfaceCurrent.dpadUp				= !(bitfields->dpadUp & 0x01);
-			device->interfaceCurrent.dpadRight			= !(bitfields->dpadRight & 0x01);
-			device->interfaceCurrent.dpadDown			= !(bitfields->dpadDown & 0x01);
-			// Triggers:
-			device->interfaceCurrent.buttonLeftTrigger	= !(bitfields->buttonTriggerLeft & 0x01);
-			device->interfaceCurrent.buttonRightTrigger	= !(bitfields->buttonTriggerRight & 0x01);
-			device->interfaceCurrent.triggerLeft		= ( ((bitfields->leftTriggerHigh & 0x03) << 3) | (bitfields->leftTriggerLow & 0x07) );
-			device->interfaceCurrent.triggerRight		= bitfields->rightTrigger;
-			// Analog Joysticks:
-			device->interfaceCurrent.analogLeftX		= (bitfields->analogLeftX & 0x3E);
-			device->interfaceCurrent.analogLeftY		= (bitfields->analogLeftY & 0x3E);
-			device->interfaceCurrent.analogRightX		= ( ((bitfields->analogRightXHigh & 0x03) << 3) | ((bitfields->analogRightXMid & 0x03) << 1) | (bitfields->analogRightXLow & 0x01) );
-			device->interfaceCurrent.analogRightY		= bitfields->analogRightY;
+			WII_CLASSIC_CONTROLLER_FIELDS_PASS_THROUGH( WII_LIB_DECODE_FIELD )
 			break;
-		}
 		
 		default:
 			return WII_LIB_RC_TARGET_ID_MISMATCH;
@@ -107,3 +100,73 @@ WII_LIB_RC WiiClassic_ProcessStatusParam(WiiLib_Device *device)
 	
 }
 
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Selects the configuration messages of a classic controller (see 
+//!					'WiiDriver_Configure').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[out]		*count				Number of messages in the returned sequence.
+//!	
+//!	@returns		Pointer to the first message in the sequence (NULL == standard messages).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const uint8_t * WiiClassic_GetConfigSequence( WiiLib_Device *device, uint8_t *count )
+{
+	if( device->report != WII_LIB_REPORT_HIGH_RESOLUTION )
+		return NULL;
+	
+	if( device->dataEncrypted )
+	{
+		*count = sizeof(WiiClassic_ConfigEncryptedHighRes) / 2;
+		return &WiiClassic_ConfigEncryptedHighRes[0];
+	}
+	
+	*count = sizeof(WiiClassic_ConfigDecryptedHighRes) / 2;
+	return &WiiClassic_ConfigDecryptedHighRes[0];
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Returns the length of the status frame of a classic controller for a full frame 
+//!					report profile (see 'WiiDriver_FrameLength').
+//!	
+//!	@param[in]		report				Report profile.
+//!	
+//!	@returns		Number of bytes read (zero == profile not supported).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t WiiClassic_GetFrameLength( WII_LIB_REPORT report )
+{
+	switch( report )
+	{
+		case WII_LIB_REPORT_STANDARD:
+			return WII_LIB_PARAM_RESPONSE_LEN_DEFAULT;
+		
+		case WII_LIB_REPORT_HIGH_RESOLUTION:
+			return WII_CLASSIC_CONTROLLER_HIGH_RES_LEN;
+		
+		default:
+			return 0;
+		
+	}
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Returns the activity thresholds of a classic controller for the report profile 
+//!					of the device (see 'WiiDriver_Thresholds').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Change each analog control must exceed, indexed by control - 
+//!					'WII_LIB_BUTTON_COUNT'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const uint16_t * WiiClassic_GetThresholds( WiiLib_Device *device )
+{
+	if( device->report == WII_LIB_REPORT_HIGH_RESOLUTION )
+		return &WiiClassic_ThresholdsHighRes[0];
+	
+	return &WiiClassic_Thresholds[0];
+	
+}
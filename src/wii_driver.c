@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements the extension driver registry of the "wii" library module.
+//!	
+//!	@details		Please see "wii_driver.h" for the layout of the registry.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stddef.h>
+#include "i2c.h"
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static void				WiiDriver_Setup(			void										);
+static uint64_t			WiiDriver_Key(				const uint8_t *id							);
+static uint32_t			WiiDriver_Slot(				uint64_t key								);
+
+
+
+
+//==================================================================================================
+//	PRIVATE CONSTANTS
+//--------------------------------------------------------------------------------------------------
+// Drivers shipped with the library. The first entry of a target type is the one found by target 
+// (e.g. the classic controller also reports a second identifier in the high-resolution data 
+// format).
+static const WiiDriver			WiiDriver_BuiltIn[]		=
+{
+	{	WII_LIB_TARGET_DEVICE_NUNCHUCK,						WII_LIB_ID_NUNCHUCK,						WII_LIB_I2C_ADDR_STANDARD,	0,											NULL,								WiiNunchuck_ProcessStatusParam,		NULL,						WiiNunchuck_GetThresholds		},
+	{	WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,			WII_LIB_ID_CLASSIC_CONTROLLER,				WII_LIB_I2C_ADDR_STANDARD,	WII_DRIVER_FLAG_RECONFIGURE_ON_INVALID,		WiiClassic_GetConfigSequence,		WiiClassic_ProcessStatusParam,		WiiClassic_GetFrameLength,	WiiClassic_GetThresholds		},
+	{	WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER,			WII_LIB_ID_CLASSIC_CONTROLLER_HIGH_RES,		WII_LIB_I2C_ADDR_STANDARD,	WII_DRIVER_FLAG_RECONFIGURE_ON_INVALID,		WiiClassic_GetConfigSequence,		WiiClassic_ProcessStatusParam,		WiiClassic_GetFrameLength,	WiiClassic_GetThresholds		},
+	{	WII_LIB_TARGET_DEVICE_MOTION_PLUS,					WII_LIB_ID_WII_MOTION_PLUS,					WII_LIB_I2C_ADDR_STANDARD,	0,											WiiMotionPlus_GetConfigSequence,	WiiMotionPlus_ProcessStatusParam,	NULL,						WiiMotionPlus_GetThresholds		},
+	{	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK,	WII_LIB_ID_WII_MOTION_PLUS_PASS_NUNCHUCK,	WII_LIB_I2C_ADDR_STANDARD,	WII_DRIVER_FLAG_DECODE_REPEATED,			WiiMotionPlus_GetConfigSequence,	WiiMotionPlus_ProcessPassThrough,	NULL,						WiiMotionPlus_GetThresholds		},
+	{	WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC,		WII_LIB_ID_WII_MOTION_PLUS_PASS_CLASSIC,	WII_LIB_I2C_ADDR_STANDARD,	WII_DRIVER_FLAG_DECODE_REPEATED |
+																																	WII_DRIVER_FLAG_RECONFIGURE_ON_INVALID,		WiiMotionPlus_GetConfigSequence,	WiiMotionPlus_ProcessPassThrough,	NULL,						WiiMotionPlus_GetThresholds		},
+	{	WII_LIB_TARGET_DEVICE_GUITAR,						WII_GUITAR_HERO_ID_GUITAR,					WII_LIB_I2C_ADDR_STANDARD,	0,											NULL,								WiiGuitarHero_ProcessGuitar,		NULL,						WiiGuitarHero_GetThresholds		},
+	{	WII_LIB_TARGET_DEVICE_DRUMS,						WII_GUITAR_HERO_ID_DRUMS,					WII_LIB_I2C_ADDR_STANDARD,	0,											NULL,								WiiGuitarHero_ProcessDrums,			NULL,						WiiGuitarHero_GetThresholds		},
+	{	WII_LIB_TARGET_DEVICE_TURNTABLE,					WII_GUITAR_HERO_ID_TURNTABLE,				WII_LIB_I2C_ADDR_STANDARD,	0,											NULL,								WiiGuitarHero_ProcessTurntable,		NULL,						WiiGuitarHero_GetThresholds		},
+};
+
+
+
+
+//==================================================================================================
+//	PRIVATE VARIABLES
+//--------------------------------------------------------------------------------------------------
+static uint64_t					WiiDriver_Keys[WII_DRIVER_TABLE_SIZE];										//!< Packed identifier of each used slot.
+static const WiiDriver *		WiiDriver_Slots[WII_DRIVER_TABLE_SIZE];										//!< Driver of each slot (NULL == free).
+static const WiiDriver *		WiiDriver_Targets[WII_DRIVER_MAX_TARGETS];									//!< Driver found by target type.
+static uint8_t					WiiDriver_Count;															//!< Number of slots used.
+static uint8_t					WiiDriver_Ready;															//!< Flag indicating if the built-in drivers have been registered.
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Adds a driver to the registry.
+//!	
+//!	@details		A driver reporting the same identifier as one already registered replaces it 
+//!					(built-in drivers included). The driver found by target type is the first one 
+//!					registered for it, unless replaced. A replacement for the same target type takes 
+//!					its place; one for another target type leaves the old type to another driver 
+//!					still registered for it (if any).
+//!	
+//!	@param[in]		*driver				Driver to add (must outlive the registry).
+//!	
+//!	@retval			WII_LIB_RC_TARGET_STRUCTURE_NOT_DEFINED		No decode function, or target type 
+//!																not below 'WII_DRIVER_MAX_TARGETS'.
+//!	@retval			WII_LIB_RC_QUEUE_FULL						'WII_DRIVER_MAX_DRIVERS' already 
+//!																registered.
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiDriver_Register( const WiiDriver *driver )
+{
+	uint64_t			key			= WiiDriver_Key( &driver->id[0] );
+	uint32_t			slot;
+	uint32_t			index;
+	const WiiDriver		*replaced;
+	
+	WiiDriver_Setup();
+	
+	if( !driver->decode || (uint32_t)driver->target >= WII_DRIVER_MAX_TARGETS )
+		return WII_LIB_RC_TARGET_STRUCTURE_NOT_DEFINED;
+	
+	for( slot = WiiDriver_Slot( key ); WiiDriver_Slots[slot]; slot = (slot + 1) & (WII_DRIVER_TABLE_SIZE - 1) )
+	{
+		if( WiiDriver_Keys[slot] == key )
+			break;
+	}
+	
+	replaced = WiiDriver_Slots[slot];
+	if( !replaced && WiiDriver_Count >= WII_DRIVER_MAX_DRIVERS )
+		return WII_LIB_RC_QUEUE_FULL;
+	
+	if( !replaced )
+		++WiiDriver_Count;
+	
+	WiiDriver_Keys[slot]	= key;
+	WiiDriver_Slots[slot]	= driver;
+	
+	if( replaced && WiiDriver_Targets[replaced->target] == replaced )
+	{
+		WiiDriver_Targets[replaced->target] = NULL;
+		
+		// A driver moving the identifier to another target type hands the old type to any other 
+		// driver still registered for it (table order; NULL == none left).
+		for( index = 0; replaced->target != driver->target && index < WII_DRIVER_TABLE_SIZE; ++index )
+		{
+			if( WiiDriver_Slots[index] && WiiDriver_Slots[index]->target == replaced->target )
+			{
+				WiiDriver_Targets[replaced->target] = WiiDriver_Slots[index];
+				break;
+			}
+		}
+	}
+	
+	if( !WiiDriver_Targets[driver->target] )
+		WiiDriver_Targets[driver->target] = driver;
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Finds the driver of the target reporting an identifier.
+//!	
+//!	@param[in]		*id					'WII_LIB_ID_LENGTH' byte identifier (decrypted).
+//!	
+//!	@returns		Driver registered for the identifier (NULL == none).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const WiiDriver * WiiDriver_FindById( const uint8_t *id )
+{
+	uint64_t		key			= WiiDriver_Key( id );
+	uint32_t		slot;
+	
+	WiiDriver_Setup();
+	
+	for( slot = WiiDriver_Slot( key ); WiiDriver_Slots[slot]; slot = (slot + 1) & (WII_DRIVER_TABLE_SIZE - 1) )
+	{
+		if( WiiDriver_Keys[slot] == key )
+			return WiiDriver_Slots[slot];
+	}
+	
+	return NULL;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Finds the driver handling a target type.
+//!	
+//!	@param[in]		target				Target type.
+//!	
+//!	@returns		Driver registered for the target type (NULL == none).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const WiiDriver * WiiDriver_FindByTarget( WII_LIB_TARGET_DEVICE target )
+{
+	WiiDriver_Setup();
+	
+	if( (uint32_t)target >= WII_DRIVER_MAX_TARGETS )
+		return NULL;
+	
+	return WiiDriver_Targets[target];
+	
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Registers the built-in drivers the first time the registry is used.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiDriver_Setup( void )
+{
+	uint32_t		index;
+	
+	if( WiiDriver_Ready )
+		return;
+	
+	WiiDriver_Ready = TRUE;
+	for( index = 0; index < sizeof(WiiDriver_BuiltIn) / sizeof(WiiDriver_BuiltIn[0]); ++index )
+		WiiDriver_Register( &WiiDriver_BuiltIn[index] );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Packs an identifier into a 64-bit key (first byte most significant).
+//!	
+//!	@param[in]		*id					'WII_LIB_ID_LENGTH' byte identifier.
+//!	
+//!	@returns		Key of the identifier.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint64_t WiiDriver_Key( const uint8_t *id )
+{
+	uint64_t		key			= 0;
+	uint32_t		index;
+	
+	for( index = 0; index < WII_LIB_ID_LENGTH; ++index )
+		key = (key << 8) | id[index];
+	
+	return key;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Selects the first slot probed for a key (multiplicative hash).
+//!	
+//!	@param[in]		key					Key of an identifier (see 'WiiDriver_Key()').
+//!	
+//!	@returns		Slot index (0 - 'WII_DRIVER_TABLE_SIZE' - 1).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint32_t WiiDriver_Slot( uint64_t key )
+{
+	return (uint32_t)( (key * 0x9E3779B97F4A7C15ULL) >> (64 - WII_DRIVER_TABLE_BITS) );
+	
+}
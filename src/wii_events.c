@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements the optional input event queue of the "wii" library module.
+//!	
+//!	@details		Each status frame published for a device with an attached source:
+//!						1.	Primes the source with the frame if it has not seen one yet.
+//!						2.	Queues an event per button bit that differs from the value last reported.
+//!						3.	Queues an event per analog control whose distance from the value last 
+//!							reported exceeds its threshold.
+//!	
+//!					Only controls that changed in the frame (see 'WiiLib_Device{}.changedMask') or 
+//!					that are pending from an earlier frame are checked. A control that did not 
+//!					change cannot have moved further from the value last reported. Values are only 
+//!					marked as reported once their event is in the queue.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+#include "i2c.h"
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE CONSTANTS
+//--------------------------------------------------------------------------------------------------
+// Keeps the compiler from moving the event stores past the index update that publishes them (the 
+// PIC32 core does not reorder stores on its own).
+#define	WII_EVENTS_BARRIER()						__asm__ __volatile__( "" ::: "memory" )
+
+// Queues an event for a flagged analog control that moved beyond its threshold (see 
+// 'WII_LIB_CONTROLS_ANALOG'). Expects 'source', 'current', 'dirty', 'pending', and 'timestampUs' in 
+// scope.
+#define	WII_EVENTS_CHECK_ANALOG( control, member )													\
+	if( (dirty & WII_LIB_CONTROL_BIT( control )) 													\
+		&& WiiEvents_Exceeds( current->member, source->reported.member, source->thresholds[(control) - WII_LIB_BUTTON_COUNT] ) )	\
+	{																								\
+		if( WiiEvents_Push( source, (control), source->reported.member, current->member, timestampUs ) == WII_LIB_RC_SUCCESS )	\
+			source->reported.member = current->member;												\
+		else																						\
+			pending |= WII_LIB_CONTROL_BIT( control );												\
+	}
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static BOOL						WiiEvents_Exceeds(					int32_t value,				int32_t reported,		uint16_t threshold		);
+static WII_LIB_RC				WiiEvents_Push(						WiiEvents_Source *source,	uint8_t control,		int16_t previous,		int16_t value,		uint32_t timestampUs	);
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Initializes an empty event queue.
+//!	
+//!	@param[in]		*queue				Queue to initialize.
+//!	@param[in]		clock				Source of event timestamps (NULL == timestamps are zero).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiEvents_Init( WiiEvents_Queue *queue, WiiEvents_Clock clock )
+{
+	memset( (void *)queue, 0, sizeof(WiiEvents_Queue) );
+	queue->clock = clock;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Attaches an event source to a device so every status frame published feeds the 
+//!					queue.
+//!	
+//!	@details		Thresholds default to 'WII_EVENTS_DEFAULT_THRESHOLD'. The next frame published 
+//!					primes the source (no events). Passing a NULL source detaches the device.
+//!	
+//!	@param[out]		*source				Source to initialize (must outlive the attachment).
+//!	@param[in]		*queue				Queue events are pushed to.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		id					Identifier copied into every event of this device.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiEvents_Attach( WiiEvents_Source *source, WiiEvents_Queue *queue, WiiLib_Device *device, uint8_t id )
+{
+	uint8_t			index;
+	
+	if( source )
+	{
+		memset( (void *)source, 0, sizeof(WiiEvents_Source) );
+		source->queue	= queue;
+		source->device	= id;
+		
+		for( index = 0; index < WII_LIB_CONTROL_ANALOG_COUNT; ++index )
+			source->thresholds[index] = WII_EVENTS_DEFAULT_THRESHOLD;
+	}
+	
+	device->events = source;
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines how far an analog control must move before an event is queued.
+//!	
+//!	@note			Should be invoked from the producer context (or while the device is not 
+//!					being serviced).
+//!	
+//!	@param[in]		*source				Source initialized with 'WiiEvents_Attach()'.
+//!	@param[in]		control				Analog control to update.
+//!	@param[in]		threshold			Change (in counts) that must be exceeded (0 == any change).
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiEvents_SetThreshold( WiiEvents_Source *source, WII_LIB_CONTROL control, uint16_t threshold )
+{
+	if( control < WII_LIB_BUTTON_COUNT || control >= WII_LIB_CONTROL_COUNT )
+		return WII_LIB_RC_UNKOWN_PARAMETER;
+	
+	source->thresholds[control - WII_LIB_BUTTON_COUNT] = threshold;
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Removes the oldest event from the queue.
+//!	
+//!	@note			Must only be invoked from a single context (single consumer).
+//!	
+//!	@param[in]		*queue				Queue to read from.
+//!	@param[out]		*event				Destination for the event.
+//!	
+//!	@returns		TRUE if an event was returned (FALSE == queue empty).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL WiiEvents_Pop( WiiEvents_Queue *queue, WiiEvents_Event *event )
+{
+	uint8_t		head	= queue->head;
+	
+	if( head == queue->tail )
+		return FALSE;
+	
+	WII_EVENTS_BARRIER();
+	*event = queue->events[head & (WII_EVENTS_QUEUE_DEPTH - 1)];
+	
+	// Release the slot only once the event has been copied out.
+	WII_EVENTS_BARRIER();
+	queue->head = head + 1;
+	
+	return TRUE;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reports the number of events waiting in the queue.
+//!	
+//!	@param[in]		*queue				Queue to check.
+//!	
+//!	@returns		Number of queued events.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t WiiEvents_GetCount( WiiEvents_Queue *queue )
+{
+	return (uint8_t)( queue->tail - queue->head );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Queues events for the controls of the device that changed since they were last 
+//!					reported.
+//!	
+//!	@details		Invoked by the library for each status frame published to 'interfaceCurrent' 
+//!					when a source is attached. Runs in the context that decoded the frame 
+//!					(single producer).
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}' with an attached source.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiEvents_ProcessDevice( WiiLib_Device *device )
+{
+	WiiEvents_Source			*source			= device->events;
+	const WiiLib_Interface		*current		= &device->interfaceCurrent;
+	uint32_t					dirty			= device->changedMask | source->pending;
+	uint32_t					pending			= 0;
+	uint32_t					timestampUs;
+	uint32_t					changed;
+	uint32_t					mask;
+	uint8_t						bit;
+	
+	if( !source->primed )
+	{
+		source->reported	= *current;
+		source->primed		= TRUE;
+		return;
+	}
+	
+	// Nothing changed (most frames while idle).
+	if( !dirty )
+		return;
+	
+	timestampUs = ( source->queue->clock ? source->queue->clock() : 0 );
+	
+	// Buttons (one event per bit).
+	changed = ( current->buttons ^ source->reported.buttons ) & dirty;
+	for( bit = 0; changed; ++bit, changed >>= 1 )
+	{
+		if( !(changed & 1) )
+			continue;
+		
+		mask = (1UL << bit);
+		if( WiiEvents_Push( source, bit, (source->reported.buttons & mask) ? 1 : 0, (current->buttons & mask) ? 1 : 0, timestampUs ) == WII_LIB_RC_SUCCESS )
+			source->reported.buttons ^= mask;
+		else
+			pending |= mask;
+	}
+	
+	// Analog controls.
+	WII_LIB_CONTROLS_ANALOG( WII_EVENTS_CHECK_ANALOG )
+	
+	source->pending = pending;
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Checks if an analog control moved beyond its threshold.
+//!	
+//!	@param[in]		value				Current value of the control.
+//!	@param[in]		reported			Value last reported for the control.
+//!	@param[in]		threshold			Change that must be exceeded.
+//!	
+//!	@returns		TRUE if an event should be queued.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiEvents_Exceeds( int32_t value, int32_t reported, uint16_t threshold )
+{
+	int32_t			delta		= value - reported;
+	
+	return ( (delta < 0 ? -delta : delta) > (int32_t)threshold );
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Adds an event to the queue of a source.
+//!	
+//!	@note			Must only be invoked from a single context (single producer).
+//!	
+//!	@param[in]		*source				Source the event belongs to.
+//!	@param[in]		control				Control that changed.
+//!	@param[in]		previous			Value last reported for the control.
+//!	@param[in]		value				New value of the control.
+//!	@param[in]		timestampUs			Time the frame was decoded.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiEvents_Push( WiiEvents_Source *source, uint8_t control, int16_t previous, int16_t value, uint32_t timestampUs )
+{
+	WiiEvents_Queue		*queue		= source->queue;
+	uint8_t				tail		= queue->tail;
+	WiiEvents_Event		*event;
+	
+	if( (uint8_t)(tail - queue->head) >= WII_EVENTS_QUEUE_DEPTH )
+	{
+		queue->overflowCount++;
+		return WII_LIB_RC_QUEUE_FULL;
+	}
+	
+	event				= &queue->events[tail & (WII_EVENTS_QUEUE_DEPTH - 1)];
+	event->timestampUs	= timestampUs;
+	event->previous		= previous;
+	event->value		= value;
+	event->device		= source->device;
+	event->control		= control;
+	
+	// Publish the event only once it is complete.
+	WII_EVENTS_BARRIER();
+	queue->tail = tail + 1;
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
@@ -0,0 +1,335 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements the optional orientation fusion stage of the "wii" library module.
+//!	
+//!	@details		Each update:
+//!						1.	Turns the gyroscope rates into a half-angle step for the update period.
+//!						2.	Adds a correction proportional to the cross product of the measured 
+//!							(normalized) accelerometer vector and the gravity vector predicted by the 
+//!							present quaternion.
+//!						3.	Integrates the step into the quaternion and renormalizes it with a single 
+//!							Newton step (the quaternion never drifts far from unit length).
+//!						4.	Derives pitch/roll/yaw with a CORDIC arctangent.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+#include "i2c.h"
+#include "wii_lib.h"
+#include "wii_math.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE CONSTANTS
+//--------------------------------------------------------------------------------------------------
+#define	WII_FUSION_CORDIC_STEPS						13												//!< Iterations of the CORDIC arctangent (last step below one output count).
+#define	WII_FUSION_CORDIC_GAIN						1768195363L										//!< Growth of the vector magnitude over the CORDIC steps (~1.6468, 'WII_FUSION_Q_BITS' fractional bits).
+#define	WII_FUSION_DEGREES(deg)						((int32_t)(deg) << WII_FUSION_ANGLE_FRACTION_BITS)	//!< Converts whole degrees to the output angle format.
+
+static const int16_t			WiiFusion_AtanTable[WII_FUSION_CORDIC_STEPS]	= { 2880, 1700, 898, 456, 229, 115, 57, 29, 14, 7, 4, 2, 1 };		//!< atan(2^-i) in output angle format.
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static int32_t					WiiFusion_Mul(						int32_t a,					int32_t b				);
+static int16_t					WiiFusion_Atan2(					int32_t y,					int32_t x,				int32_t *magnitude		);
+static void						WiiFusion_UpdateAngles(				WiiFusion_State *fusion		);
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Resets the provided fusion state to the identity orientation.
+//!	
+//!	@param[in]		*fusion				State to initialize.
+//!	@param[in]		periodUs			Nominal time between updates in microseconds (the status 
+//!										poll period). Used until the interval between frames can 
+//!										be measured (see 'WiiFusion_ProcessDevice()'). Limited to 
+//!										'WII_FUSION_MAX_PERIOD_US'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiFusion_Init( WiiFusion_State *fusion, uint32_t periodUs )
+{
+	memset( fusion, 0, sizeof(WiiFusion_State) );
+	fusion->q0			= WII_FUSION_Q_ONE;
+	fusion->periodUs	= periodUs;
+	WiiFusion_SetPeriod( fusion, periodUs );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Sets the time integrated by the next updates.
+//!	
+//!	@details		Invoked by 'WiiFusion_ProcessDevice()' ahead of every update. Only needed when 
+//!					invoking 'WiiFusion_Update()' directly with a varying period.
+//!	
+//!	@param[in]		*fusion				State to update.
+//!	@param[in]		periodUs			Time since the previous update in microseconds. Limited to 
+//!										'WII_FUSION_MAX_PERIOD_US'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiFusion_SetPeriod( WiiFusion_State *fusion, uint32_t periodUs )
+{
+	if( periodUs > WII_FUSION_MAX_PERIOD_US )
+		periodUs = WII_FUSION_MAX_PERIOD_US;
+	
+	fusion->gyroStep	= (int32_t)( ((uint32_t)periodUs * WII_FUSION_GYRO_SCALE) >> 16 );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Updates the provided fusion state with every status frame published for the 
+//!					device.
+//!	
+//!	@details		Passing a NULL state detaches the fusion stage. The sources fused are selected 
+//!					from the target type (see 'WiiFusion_ProcessDevice()').
+//!	
+//!	@param[in]		*fusion				State initialized with 'WiiFusion_Init()'.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiFusion_Attach( WiiFusion_State *fusion, WiiLib_Device *device )
+{
+	device->fusion = fusion;
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Advances the orientation estimate by one update period.
+//!	
+//!	@details		May also be invoked directly (without attaching to a device) to fuse values from 
+//!					any source.
+//!	
+//!	@param[in]		*fusion				State to update.
+//!	@param[in]		*interface			Values to fuse.
+//!	@param[in]		sources				Valid values in '*interface' ('WII_FUSION_SOURCE_*').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiFusion_Update( WiiFusion_State *fusion, const WiiLib_Interface *interface, uint8_t sources )
+{
+	int32_t			q0			= fusion->q0;
+	int32_t			q1			= fusion->q1;
+	int32_t			q2			= fusion->q2;
+	int32_t			q3			= fusion->q3;
+	int32_t			hx			= 0;
+	int32_t			hy			= 0;
+	int32_t			hz			= 0;
+	int32_t			ax;
+	int32_t			ay;
+	int32_t			az;
+	int32_t			vx;
+	int32_t			vy;
+	int32_t			vz;
+	int32_t			scale;
+	uint32_t		norm;
+	uint8_t			shift;
+	
+	// Half-angle step from the gyroscope rates.
+	if( sources & WII_FUSION_SOURCE_GYRO )
+	{
+		hx = (int32_t)interface->gyroX * fusion->gyroStep;
+		hy = (int32_t)interface->gyroY * fusion->gyroStep;
+		hz = (int32_t)interface->gyroZ * fusion->gyroStep;
+	}
+	
+	// Correct towards the gravity vector measured by the accelerometer.
+	if( sources & WII_FUSION_SOURCE_ACCEL )
+	{
+		ax		= (int32_t)interface->accelX - WII_FUSION_ACCEL_ZERO;
+		ay		= (int32_t)interface->accelY - WII_FUSION_ACCEL_ZERO;
+		az		= (int32_t)interface->accelZ - WII_FUSION_ACCEL_ZERO;
+		norm	= WiiMath_Sqrt( (uint32_t)(ax * ax + ay * ay + az * az) );
+		
+		if( norm )
+		{
+			// Each component is no larger than the norm so the normalized values fit.
+			scale	= WII_FUSION_Q_ONE / (int32_t)norm;
+			ax		*= scale;
+			ay		*= scale;
+			az		*= scale;
+			
+			vx		= 2 * ( WiiFusion_Mul( q1, q3 ) - WiiFusion_Mul( q0, q2 ) );
+			vy		= 2 * ( WiiFusion_Mul( q0, q1 ) + WiiFusion_Mul( q2, q3 ) );
+			vz		= WiiFusion_Mul( q0, q0 ) - WiiFusion_Mul( q1, q1 ) - WiiFusion_Mul( q2, q2 ) + WiiFusion_Mul( q3, q3 );
+			
+			shift	= ( (sources & WII_FUSION_SOURCE_GYRO) ? WII_FUSION_GAIN_SHIFT_GYRO : WII_FUSION_GAIN_SHIFT_ACCEL_ONLY );
+			hx		+= ( WiiFusion_Mul( ay, vz ) - WiiFusion_Mul( az, vy ) ) >> shift;
+			hy		+= ( WiiFusion_Mul( az, vx ) - WiiFusion_Mul( ax, vz ) ) >> shift;
+			hz		+= ( WiiFusion_Mul( ax, vy ) - WiiFusion_Mul( ay, vx ) ) >> shift;
+		}
+	}
+	
+	// Integrate (q += q * (0, h)) and renormalize (scale by (3 - |q|^2) / 2).
+	fusion->q0	= q0 - WiiFusion_Mul( q1, hx ) - WiiFusion_Mul( q2, hy ) - WiiFusion_Mul( q3, hz );
+	fusion->q1	= q1 + WiiFusion_Mul( q0, hx ) + WiiFusion_Mul( q2, hz ) - WiiFusion_Mul( q3, hy );
+	fusion->q2	= q2 + WiiFusion_Mul( q0, hy ) - WiiFusion_Mul( q1, hz ) + WiiFusion_Mul( q3, hx );
+	fusion->q3	= q3 + WiiFusion_Mul( q0, hz ) + WiiFusion_Mul( q1, hy ) - WiiFusion_Mul( q2, hx );
+	
+	scale		= WiiFusion_Mul( fusion->q0, fusion->q0 ) + WiiFusion_Mul( fusion->q1, fusion->q1 ) +
+				  WiiFusion_Mul( fusion->q2, fusion->q2 ) + WiiFusion_Mul( fusion->q3, fusion->q3 );
+	scale		= WII_FUSION_Q_ONE + ( (WII_FUSION_Q_ONE - scale) >> 1 );
+	fusion->q0	= WiiFusion_Mul( fusion->q0, scale );
+	fusion->q1	= WiiFusion_Mul( fusion->q1, scale );
+	fusion->q2	= WiiFusion_Mul( fusion->q2, scale );
+	fusion->q3	= WiiFusion_Mul( fusion->q3, scale );
+	
+	fusion->sources = sources;
+	++fusion->updates;
+	WiiFusion_UpdateAngles( fusion );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Updates the fusion state attached to the device with the frame just published.
+//!	
+//!	@details		Invoked by the library after each status frame is decoded. The sources fused 
+//!					depend on the target:
+//!						-	Nunchuck:								accelerometer only.
+//!						-	Wii Motion Plus (standalone/classic):	gyroscope only.
+//!						-	Wii Motion Plus (nunchuck):				gyroscope and accelerometer.
+//!					Targets without either (classic controller) leave the state untouched.
+//!	
+//!					Frames read by 'WiiLib_Service()' are integrated over the time measured since 
+//!					the previous frame (the poll period varies with pacing, re-reads, and the other 
+//!					devices sharing the bus). Frames read by blocking polls, and the first frame 
+//!					read by the service, use the nominal period passed to 'WiiFusion_Init()'.
+//!	
+//!	@note			Intervals are limited to 'WII_FUSION_MAX_PERIOD_US'. Rotation during longer 
+//!					gaps (e.g. a reconnect) is only partially integrated. The scheduler keeps 
+//!					adaptive pacing below the limit (see 'WII_SCHEDULER_FUSION_MAX_INTERVAL_US').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		timed				Flag indicating if 'timestampUs' is valid.
+//!	@param[in]		timestampUs			Time the frame was read in microseconds (free-running 
+//!										counter).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiFusion_ProcessDevice( WiiLib_Device *device, BOOL timed, uint32_t timestampUs )
+{
+	WiiFusion_State		*fusion		= device->fusion;
+	uint8_t				sources;
+	
+	switch( device->target )
+	{
+		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
+			sources = WII_FUSION_SOURCE_ACCEL;
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
+			sources = WII_FUSION_SOURCE_GYRO;
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
+			sources = WII_FUSION_SOURCE_ACCEL | WII_FUSION_SOURCE_GYRO;
+			break;
+		
+		default:
+			return;
+		
+	}
+	
+	WiiFusion_SetPeriod( fusion, ( timed && fusion->timed ? timestampUs - fusion->lastUs : fusion->periodUs ) );
+	fusion->lastUs	= timestampUs;
+	fusion->timed	= (uint8_t)timed;
+	
+	WiiFusion_Update( fusion, &device->interfaceCurrent, sources );
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Multiplies two values with 'WII_FUSION_Q_BITS' fractional bits.
+//!	
+//!	@param[in]		a					First factor.
+//!	@param[in]		b					Second factor.
+//!	
+//!	@returns		Product with 'WII_FUSION_Q_BITS' fractional bits.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static int32_t WiiFusion_Mul( int32_t a, int32_t b )
+{
+	return (int32_t)( ((int64_t)a * b) >> WII_FUSION_Q_BITS );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Computes the four quadrant arctangent of y/x with a CORDIC (shift and add only).
+//!	
+//!	@param[in]		y					Numerator (magnitude of the vector must stay below 2^30).
+//!	@param[in]		x					Denominator.
+//!	@param[out]		*magnitude			Magnitude of the vector scaled by 'WII_FUSION_CORDIC_GAIN'.
+//!	
+//!	@returns		Angle in degrees ('WII_FUSION_ANGLE_FRACTION_BITS' fractional bits).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static int16_t WiiFusion_Atan2( int32_t y, int32_t x, int32_t *magnitude )
+{
+	int32_t			angle		= 0;
+	int32_t			xNext;
+	int32_t			mask;
+	uint8_t			step;
+	
+	// Rotate the left half plane by 180 degrees to stay within the CORDIC range.
+	if( x < 0 )
+	{
+		angle	= ( y >= 0 ) ? WII_FUSION_DEGREES(180) : -WII_FUSION_DEGREES(180);
+		x		= -x;
+		y		= -y;
+	}
+	
+	// Rotate towards the x-axis each step. The direction is applied through a sign mask (0 == 
+	// clockwise, -1 == counter-clockwise) as '(value ^ mask) - mask' to avoid branching.
+	for( step = 0; step < WII_FUSION_CORDIC_STEPS; ++step )
+	{
+		mask	= -(int32_t)( y <= 0 );
+		xNext	= x + ( ((y >> step) ^ mask) - mask );
+		y		= y - ( ((x >> step) ^ mask) - mask );
+		angle	+= ( (WiiFusion_AtanTable[step] ^ mask) - mask );
+		x		= xNext;
+	}
+	
+	*magnitude = x;
+	return (int16_t)angle;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Derives pitch/roll/yaw from the quaternion of the provided state.
+//!	
+//!	@param[in]		*fusion				State to update.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiFusion_UpdateAngles( WiiFusion_State *fusion )
+{
+	int32_t			q0			= fusion->q0;
+	int32_t			q1			= fusion->q1;
+	int32_t			q2			= fusion->q2;
+	int32_t			q3			= fusion->q3;
+	int32_t			sine;
+	int32_t			cosine;
+	int32_t			unused;
+	
+	fusion->pitch	= WiiFusion_Atan2(	2 * ( WiiFusion_Mul( q0, q1 ) + WiiFusion_Mul( q2, q3 ) ),
+										WII_FUSION_Q_ONE - 2 * ( WiiFusion_Mul( q1, q1 ) + WiiFusion_Mul( q2, q2 ) ), &cosine );
+	fusion->yaw		= WiiFusion_Atan2(	2 * ( WiiFusion_Mul( q0, q3 ) + WiiFusion_Mul( q1, q2 ) ),
+										WII_FUSION_Q_ONE - 2 * ( WiiFusion_Mul( q2, q2 ) + WiiFusion_Mul( q3, q3 ) ), &unused );
+	
+	// Roll is asin(sine). The vector used for pitch has a magnitude of cos(roll) so the CORDIC 
+	// already produced the matching cosine (scaled by its gain). Scale the sine to match and halve 
+	// both to stay within range.
+	sine			= 2 * ( WiiFusion_Mul( q0, q2 ) - WiiFusion_Mul( q1, q3 ) );
+	fusion->roll	= WiiFusion_Atan2( WiiFusion_Mul( sine, WII_FUSION_CORDIC_GAIN ) >> 1, cosine >> 1, &unused );
+}
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements functions used to interpret data read from Guitar Hero (guitar and 
+//!					drums) and DJ Hero (turntable) devices.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stddef.h>
+#include "i2c.h"
+#include "wii_guitar_hero.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE CONSTANTS
+//--------------------------------------------------------------------------------------------------
+// Change each analog control must exceed to count as activity (see 'WiiDriver_Thresholds'). The drum 
+// pad is left at zero: any change names the pad hit.
+static const uint16_t			WiiGuitarHero_ThresholdsGuitar[WII_LIB_CONTROL_ANALOG_COUNT]	=
+{
+	[WII_LIB_CONTROL_ANALOG_LEFT_X	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_LEFT_Y	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_X	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_TOUCH_BAR,
+	[WII_LIB_CONTROL_TRIGGER_RIGHT	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_WHAMMY,
+};
+
+static const uint16_t			WiiGuitarHero_ThresholdsDrums[WII_LIB_CONTROL_ANALOG_COUNT]	=
+{
+	[WII_LIB_CONTROL_ANALOG_LEFT_X	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_LEFT_Y	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_TRIGGER_RIGHT	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_VELOCITY,
+};
+
+static const uint16_t			WiiGuitarHero_ThresholdsTurntable[WII_LIB_CONTROL_ANALOG_COUNT]	=
+{
+	[WII_LIB_CONTROL_ANALOG_LEFT_X	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_LEFT_Y	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_TRIGGER_LEFT	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_FADER,
+	[WII_LIB_CONTROL_TRIGGER_RIGHT	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_DIAL,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_X	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_TURNTABLE,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_Y	- WII_LIB_BUTTON_COUNT]	= WII_GUITAR_HERO_THRESHOLD_TURNTABLE,
+};
+
+
+
+
+//==================================================================================================
+// PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Process current data for a Guitar Hero guitar as the response field from 
+//!					querying the device status register.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiGuitarHero_ProcessGuitar(WiiLib_Device *device)
+{
+	const uint8_t		*data		= &device->dataCurrent[0];
+	WiiLib_Interface	*current	= &device->interfaceCurrent;
+	
+	WII_GUITAR_HERO_FIELDS_GUITAR( WII_LIB_DECODE_FIELD )
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Process current data for a Guitar Hero drum kit as the response field from 
+//!					querying the device status register.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiGuitarHero_ProcessDrums(WiiLib_Device *device)
+{
+	const uint8_t		*data		= &device->dataCurrent[0];
+	WiiLib_Interface	*current	= &device->interfaceCurrent;
+	
+	WII_GUITAR_HERO_FIELDS_DRUMS( WII_LIB_DECODE_FIELD )
+	
+	if( data[WII_GUITAR_HERO_DRUMS_NO_VELOCITY_BYTE] & WII_GUITAR_HERO_DRUMS_NO_VELOCITY_MASK )
+		current->triggerRight = 0;
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Process current data for a DJ Hero turntable as the response field from 
+//!					querying the device status register.
+//!	
+//!	@details		Turntable speeds are sign extended and the bits of byte 4 - 5 that do not hold 
+//!					a button are cleared from 'buttons'.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiGuitarHero_ProcessTurntable(WiiLib_Device *device)
+{
+	const uint8_t		*data		= &device->dataCurrent[0];
+	WiiLib_Interface	*current	= &device->interfaceCurrent;
+	
+	WII_GUITAR_HERO_FIELDS_TURNTABLE( WII_LIB_DECODE_FIELD )
+	
+	current->analogRightX	= (int16_t)( (current->analogRightX ^ WII_GUITAR_HERO_TURNTABLE_SIGN) - WII_GUITAR_HERO_TURNTABLE_SIGN );
+	current->analogRightY	= (int16_t)( (current->analogRightY ^ WII_GUITAR_HERO_TURNTABLE_SIGN) - WII_GUITAR_HERO_TURNTABLE_SIGN );
+	current->buttons		&= WII_GUITAR_HERO_TURNTABLE_BUTTONS;
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Returns the activity thresholds of a Guitar Hero or DJ Hero target (see 
+//!					'WiiDriver_Thresholds').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Change each analog control must exceed, indexed by control - 
+//!					'WII_LIB_BUTTON_COUNT' (NULL == not a Guitar Hero or DJ Hero target).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const uint16_t * WiiGuitarHero_GetThresholds( WiiLib_Device *device )
+{
+	switch( device->target )
+	{
+		case WII_LIB_TARGET_DEVICE_GUITAR:
+			return &WiiGuitarHero_ThresholdsGuitar[0];
+		
+		case WII_LIB_TARGET_DEVICE_DRUMS:
+			return &WiiGuitarHero_ThresholdsDrums[0];
+		
+		case WII_LIB_TARGET_DEVICE_TURNTABLE:
+			return &WiiGuitarHero_ThresholdsTurntable[0];
+		
+		default:
+			return NULL;
+		
+	}
+	
+}
@@ -14,14 +14,38 @@
 //!								(nunchuck and classic controller interchangeable).
 //!						3.	Invoke 'WiiLib_DoMaintenance()' on a regular basis to gracefully handle 
 //!							error conditions (suggested to invoke just prior to the following step).
+//!							-	A target that stops answering is presumed unplugged and probed for 
+//!								with an exponential backoff (no blocking delays). Once plugged back 
+//!								in (even as a different target type) it is re-identified and 
+//!								connected again.
 //!						4.	Invoke 'WiiLib_PollStatus()' to read in the state of the external 
 //!							target.
-//!						5.	Use 'devce.interfaceCurrent{}' and 'device.interfaceRelative{}' to 
-//!							check the state of the various features provided by the external target.
+//!						5.	Use 'devce.interfaceCurrent{}' and 'WiiLib_GetRelative()' (or 
+//!							'WiiLib_GetRelativeInterface()') to check the state of the various 
+//!							features provided by the external target.
 //!						6.	If ever you wish to reconfigure the relative positioning reference 
 //!							point, invoke the 'WiiLib_MeasureNewHomePosition()' function.
 //!							-	Alternatively, if you have recently polled the status of a target 
 //!								device, you can call 'WiiLib_SaveCurrentPositionAsHome()' instead.
+//!	
+//!					When the caller cannot afford to block while waiting on the target, the 
+//!					following non-blocking flow may be used instead of steps 2 - 4:
+//!						1.	Pass pointer to instance of device along to 'WiiLib_InitNonBlocking()'.
+//!						2.	Invoke 'WiiLib_Service()' on every pass through the main loop with the 
+//!							current time in microseconds. Each call executes at most one I2C 
+//!							transaction and returns immediately. A return value of 
+//!							'WII_LIB_RC_SUCCESS' indicates a new status frame was decoded; 
+//!							'WII_LIB_RC_PENDING' indicates work is still in progress.
+//!						-	The blocking and non-blocking functions should not be mixed for the 
+//!							same device while a service job is in progress.
+//!						-	Only 'WiiLib_InitNonBlocking()' and 'WiiLib_Service()' are non-blocking. 
+//!							All other functions that talk to the target (e.g. 
+//!							'WiiLib_ConfigureDevice()', 'WiiLib_ConnectToTarget()', 
+//!							'WiiLib_PollStatus()') still block on the bus and sleep through the 
+//!							delays it needs.
+//!						-	To keep the CPU free while bytes move on the bus, attach a transaction 
+//!							queue ('WiiAsync_Attach()') and invoke 'WiiAsync_Isr()' from the I2C 
+//!							master interrupt. Status frames are then decoded from the interrupt.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -36,12 +60,72 @@
 
 
 //==================================================================================================
-//	PRIVATE FUNCTION PROTOTYPES
+//								PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static WII_LIB_TARGET_DEVICE	WiiLib_DetermineDeviceType(			WiiLib_Device *device		);
+static WII_LIB_TARGET_DEVICE	WiiLib_IdentifyTarget(				uint8_t *id					);
+static const uint8_t *			WiiLib_GetConfigSequence(			WiiLib_Device *device,		uint8_t *count			);
+static uint8_t					WiiLib_GetConfigAddr(				WiiLib_Device *device		);
+static BOOL						WiiLib_IsMotionPlus(				WiiLib_Device *device		);
+static BOOL						WiiLib_ReconfigureOnInvalidData(	WiiLib_Device *device		);
+static uint8_t					WiiLib_GetRegister(					WiiLib_Device *device,		WII_LIB_PARAM param		);
+static WII_LIB_RC				WiiLib_GetResponseLength(			WiiLib_Device *device,		WII_LIB_PARAM param,	uint32_t *len			);
+static WII_LIB_RC				WiiLib_ProcessResponse(				WiiLib_Device *device,		WII_LIB_PARAM param,	uint8_t *data,			uint32_t len,				BOOL timed					);
+static WII_LIB_FRAME			WiiLib_ValidateDataReceived(		const uint8_t *data,		uint32_t len			);
+static WII_LIB_FRAME			WiiLib_ValidateFrame(				WiiLib_Device *device,		const uint8_t *data,	uint32_t len			);
+static WII_LIB_RC				WiiLib_Decrypt(						const WiiLib_Cipher *cipher,	uint8_t *data,		uint32_t len,			uint8_t addr				);
+static WII_LIB_RC				WiiLib_UpdateInterfaceTracking(		WiiLib_Device *device,		BOOL timed				);
+static void						WiiLib_Delay(						WiiLib_Device *device,		uint32_t ms				);
+static void						WiiLib_AdoptTarget(					WiiLib_Device *device,		WII_LIB_TARGET_DEVICE target	);
+static void						WiiLib_Disconnect(					WiiLib_Device *device		);
+static uint32_t					WiiLib_BackOff(						WiiLib_Device *device,		uint32_t first,			uint32_t max			);
+static BOOL						WiiLib_TimeReached(					uint32_t nowUs,				uint32_t deadlineUs		);
+static void						WiiLib_ServiceWait(					WiiLib_Device *device,		uint32_t nowUs,			uint32_t delayUs,		WII_LIB_SERVICE_STATE next	);
+static WII_LIB_RC				WiiLib_ServiceSchedule(				WiiLib_Device *device		);
+static WII_LIB_RC				WiiLib_ServiceConfigWrite(			WiiLib_Device *device,		uint32_t nowUs			);
+static WII_LIB_RC				WiiLib_ServiceConfigWriteDone(		WiiLib_Device *device,		uint32_t nowUs			);
+static WII_LIB_RC				WiiLib_ServiceWritePointer(			WiiLib_Device *device,		uint32_t nowUs			);
+static WII_LIB_RC				WiiLib_ServiceWritePointerDone(		WiiLib_Device *device,		uint32_t nowUs			);
+static WII_LIB_RC				WiiLib_ServiceRead(					WiiLib_Device *device,		uint32_t nowUs			);
+static WII_LIB_RC				WiiLib_ServiceReadDone(				WiiLib_Device *device,		uint32_t nowUs			);
+static WII_LIB_RC				WiiLib_ServiceTransfer(				WiiLib_Device *device,		uint32_t nowUs,			uint32_t len,			BOOL read					);
+static void						WiiLib_ServiceTransferComplete(		WiiAsync_Transfer *transfer	);
+static void						WiiLib_ServiceTransferDone(			WiiLib_Device *device,		WII_LIB_RC result		);
+static WII_LIB_RC				WiiLib_ServiceTransferFinish(		WiiLib_Device *device,		uint32_t nowUs			);
+static WII_LIB_RC				WiiLib_ServiceFail(					WiiLib_Device *device,		uint32_t nowUs,			WII_LIB_RC returnCode	);
+static WII_LIB_RC				WiiLib_SelectMuxChannel(			WiiLib_Device *device,		WiiAsync_Transfer *chain,	uint8_t *count		);
+static WII_LIB_RC				WiiLib_WriteMux(					WiiLib_Device *device,		uint8_t muxAddr,		uint8_t *control,		WiiAsync_Transfer *chain,	uint8_t *count		);
+static void						WiiLib_WriteMuxComplete(			WiiAsync_Transfer *transfer		);
+
+
+
+
+//==================================================================================================
+//								PRIVATE CONSTANTS
 //--------------------------------------------------------------------------------------------------
-static WII_LIB_TARGET_DEVICE	WiiLib_DetermineDeviceType(		WiiLib_Device *device					);
-static BOOL						WiiLib_ValidateDataReceived(	uint8_t *data,			uint32_t len	);
-static WII_LIB_RC				WiiLib_Decrypt(					uint8_t *data,			int8_t len		);
-static WII_LIB_RC				WiiLib_UpdateInterfaceTracking(	WiiLib_Device *device					);
+// Configuration messages (register address followed by value) pushed out to the target when 
+// (re)configuring it. A delay of 'WII_LIB_DELAY_AFTER_CONFIG_MESSAGE_MS' follows each message.
+static const uint8_t			WiiLib_ConfigEncrypted[]		= { 0x40, 0x00 };								//!< Initializes target in most basic form. This leaves data in an encrypted state.
+static const uint8_t			WiiLib_ConfigDecrypted[]		= { 0xF0, 0x55,		0xFB, 0x00 };				//!< Initializes target such that future data transmitted is no longer encrypted.
+
+// Control byte written to a multiplexer to close all of its channels.
+static const uint8_t			WiiLib_MuxClosed				= 0x00;											//!< Channel mask with every channel closed.
+
+// Flags an analog control that differs from the previous frame (see 'WII_LIB_CONTROLS_ANALOG'). 
+// Expects 'current', 'previous', and 'changed' in scope.
+#define	WII_LIB_CHECK_CHANGED( control, member )													\
+	if( current->member != previous.member )														\
+		changed |= WII_LIB_CONTROL_BIT( control );
+
+// Relative value of an analog control (see 'WII_LIB_CONTROLS_ANALOG'). Expects 'device' in scope.
+#define	WII_LIB_GET_RELATIVE( control, member )														\
+	case (control):																					\
+		return (int32_t)device->interfaceCurrent.member - device->interfaceHome.member;
+
+// Copies the relative value of an analog control into 'relative'. Expects 'device' and 'relative' 
+// in scope.
+#define	WII_LIB_COPY_RELATIVE( control, member )													\
+	relative->member = device->interfaceCurrent.member - device->interfaceHome.member;
 
 
 
@@ -54,6 +138,9 @@ static WII_LIB_RC				WiiLib_UpdateInterfaceTracking(	WiiLib_Device *device					)
 //!	
 //!	@details		Initializes the I2C bus and pushes initialization messages to target device.
 //!	
+//!	@note			Blocks until the connection attempt completes. See 'WiiLib_InitNonBlocking()' 
+//!					for an alternative that defers all bus traffic to 'WiiLib_Service()'.
+//!	
 //!	@param[in]		module				Which I2C module (port) to use(e.g. I2C1) when communicating 
 //!										to target device.
 //!	@param[in]		pbClk				Current peripheral bus clock for device (referenced during 
@@ -68,9 +155,55 @@ static WII_LIB_RC				WiiLib_UpdateInterfaceTracking(	WiiLib_Device *device					)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 WII_LIB_RC WiiLib_Init( I2C_MODULE module, uint32_t pbClk, WII_LIB_TARGET_DEVICE target, BOOL decryptData, WiiLib_Device *device )
 {
-	// Presume delay not yet initialized and initialize delay module. Even if this is not the case, 
-	// should have no harm (in theory/so long as pbClk not different between devices).
-	Delay_Init(pbClk);
+	WII_LIB_RC		returnCode;
+	
+	returnCode = WiiLib_InitNonBlocking( module, pbClk, target, decryptData, device );
+	if( returnCode != WII_LIB_RC_SUCCESS )
+		return returnCode;
+	
+	WiiLib_Delay( device, WII_LIB_DELAY_I2C_SETTLE_TIME_MS );
+	
+	// Settle time already observed. Execute maintenance tasks to handle initialization / etc.
+	device->service.state				= WII_LIB_SERVICE_STATE_IDLE;
+	return WiiLib_DoMaintenance(device);
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Initializes the Wii structure and I2C port without communicating with the 
+//!					target device.
+//!	
+//!	@details		Populates the device structure and initializes the I2C port. Connecting to the 
+//!					target (settle time, configuration, ID confirmation, and measuring the home 
+//!					position) is left to subsequent calls to 'WiiLib_Service()'.
+//!	
+//!	@param[in]		module				Which I2C module (port) to use(e.g. I2C1) when communicating 
+//!										to target device.
+//!	@param[in]		pbClk				Current peripheral bus clock for device (referenced during 
+//!										I2C initialization).
+//!	@param[in]		target				Target type. Should be of type 'WII_LIB_TARGET_DEVICE'.
+//!	@param[in]		decryptData			Boolean flag indicating if data should be initialized as 
+//!										decrypted.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}' to populate/utilize.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiLib_InitNonBlocking( I2C_MODULE module, uint32_t pbClk, WII_LIB_TARGET_DEVICE target, BOOL decryptData, WiiLib_Device *device )
+{
+	// Route all bus traffic and delays through the backend linked in for this platform.
+	device->backend						= &WiiLib_BackendDefault;
+	device->queue						= NULL;
+	device->calibrationCache			= NULL;
+	device->calibration					= NULL;
+	device->fusion						= NULL;
+	device->events						= NULL;
+	device->capture						= NULL;
+	device->muxState					= NULL;
+	device->muxAddr						= WII_LIB_MUX_NONE;
+	device->muxSelect					= 0;
+	device->muxPending					= FALSE;
 	
 	// Define I2C port for communication as a master device.
 	device->i2c.port.config				= I2C_ENABLE_SLAVE_CLOCK_STRETCHING | I2C_STOP_IN_IDLE;
@@ -78,9 +211,10 @@ WII_LIB_RC WiiLib_Init( I2C_MODULE module, uint32_t pbClk, WII_LIB_TARGET_DEVICE
 	device->i2c.port.clkFreq			= I2C_CLOCK_RATE_STANDARD;
 	device->i2c.port.ackMode			= I2C_ACK_MODE_ACK;
 	
-	// Define processing delays for I2C communication.
+	// Define processing delays for I2C communication. The delay after reading is handled by this 
+	// library (sleep or deadline) so the non-blocking service never stalls inside the I2C driver.
 	device->i2c.delayAfterSend_Ms		= WII_LIB_I2C_DELAY_POST_SEND_MS;
-	device->i2c.delayAfterReceive_Ms	= WII_LIB_I2C_DELAY_POST_READ_MS;
+	device->i2c.delayAfterReceive_Ms	= 0;
 	device->i2c.delayBetweenTxRx_Ms		= WII_LIB_I2C_DELAY_BETWEEN_TX_RX_MS;
 	
 	// Set flag controlling if relative positioning is enabled (when enabled, automatically 
@@ -95,38 +229,36 @@ WII_LIB_RC WiiLib_Init( I2C_MODULE module, uint32_t pbClk, WII_LIB_TARGET_DEVICE
 	device->i2c.mode					= I2C_MODE_MASTER;
 	device->i2c.addrLength				= I2C_ADDR_LEN_7_BITS;
 	device->target						= target;
+	device->driver						= WiiDriver_FindByTarget( target );
+	WiiLib_SetReport( device, WII_LIB_REPORT_STANDARD );
 	device->dataEncrypted				= (uint8_t)!(decryptData);
+	WiiLib_SetCipher( device, NULL, NULL );
 	
-	// Define device-specific settings.
-	switch(device->target)
-	{
-		case WII_LIB_TARGET_DEVICE_UNKNOWN:
-		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
-		case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
-		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
-		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
-			device->i2c.addr		= WII_LIB_I2C_ADDR_STANDARD;
-			break;
-		
-		case WII_LIB_TARGET_DEVICE_MOTION_PLUS:
-			device->i2c.addr		= WII_LIB_I2C_ADDR_WII_MOTION_PLUS;
-			break;
-		
-		default:
-			return WII_LIB_RC_UNSUPPORTED_DEVICE;
-		
-	}
+	// Define device-specific settings from the driver of the target (see "wii_driver.h"). An unknown 
+	// target is identified while connecting. A Wii Motion Plus is only addressed at 
+	// 'WII_LIB_I2C_ADDR_WII_MOTION_PLUS' while activating it (see 'WiiLib_GetConfigAddr()').
+	if( device->driver )
+		device->i2c.addr				= device->driver->addr;
+	else if( device->target == WII_LIB_TARGET_DEVICE_UNKNOWN )
+		device->i2c.addr				= WII_LIB_I2C_ADDR_STANDARD;
+	else
+		return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	
+	if( WiiLib_IsMotionPlus( device ) )
+		device->dataEncrypted			= FALSE;
 	
 	// Initialize I2C port and push out settings to initialize device.
-	if( I2C_InitPort(&device->i2c.port, pbClk, FALSE) != I2C_RC_SUCCESS )
+	if( device->backend->init( &device->i2c, pbClk ) != I2C_RC_SUCCESS )
 		return WII_LIB_RC_I2C_ERROR;
 	
-	Delay_Ms(WII_LIB_DELAY_I2C_SETTLE_TIME_MS);
-	
-	// Define initial device status and execute maintenance tasks to handle initialization / etc.
+	// Define initial device status. Bus must settle before the first connection attempt.
 	device->failedParamQueryCount		= 0;
+	device->probeInterval				= 0;
+	device->probeCountdown				= 0;
 	device->status						= WII_LIB_DEVICE_STATUS_NOT_INITIALIZED;
-	return WiiLib_DoMaintenance(device);
+	device->service.state				= WII_LIB_SERVICE_STATE_SETTLE;
+	device->service.job					= WII_LIB_SERVICE_JOB_NONE;
+	return WII_LIB_RC_SUCCESS;
 	
 }
 
@@ -150,40 +282,51 @@ WII_LIB_RC WiiLib_DoMaintenance( WiiLib_Device *device )
 		// the call to the initialization function.
 		return WII_LIB_RC_TARGET_STRUCTURE_NOT_DEFINED;
 	}
-	else if( device->failedParamQueryCount > WII_LIB_MAX_FAILURES_BEFORE_DISABLING )
+	else if( device->status == WII_LIB_DEVICE_STATUS_DISABLED )
 	{
-		device->status = WII_LIB_DEVICE_STATUS_DISABLED;
 		return WII_LIB_RC_DEVICE_DISABLED;
 	}
+	else if( device->failedParamQueryCount > WII_LIB_MAX_FAILURES_BEFORE_DISCONNECTING )
+	{
+		// Target presumed unplugged. Probe for it on the next call.
+		WiiLib_Disconnect( device );
+		device->probeCountdown = 0;
+		return WII_LIB_RC_TARGET_DISCONNECTED;
+	}
 	else if( device->failedParamQueryCount > WII_LIB_MAX_FAILURES_BEFORE_RECONFIGURING )
 	{
 		device->status = WII_LIB_DEVICE_STATUS_CONFIGURING;
+		WII_STATS_COUNT( device, reconfigures );
 		return WiiLib_ConfigureDevice(device);
 	}
-	else if( device->status == WII_LIB_DEVICE_STATUS_NOT_INITIALIZED )
+	else if( device->status == WII_LIB_DEVICE_STATUS_NOT_INITIALIZED || device->status == WII_LIB_DEVICE_STATUS_DISCONNECTED )
 	{
-		// NOTE:	It is vital that the 'not initialized' state follows after the checks against 
-		//			error counts. Thus, if the device is not found at boot, querying for it will 
-		//			halt eventually.
-		WII_LIB_RC		returnCode						= WII_LIB_RC_SUCCESS;
-		uint8_t			connectionAttemptsReamining		= WII_LIB_MAX_CONNECTION_ATTEMPTS;
+		// NOTE:	A single connection attempt (probe) is made per call so an empty port never 
+		//			stalls the caller. While disconnected, probes are spaced out by skipping a 
+		//			growing number of calls.
+		WII_LIB_RC		returnCode;
+		BOOL			disconnected	= ( device->status == WII_LIB_DEVICE_STATUS_DISCONNECTED );
 		
-		// Attempt to connect to the target device until we are successful, run out of attempts, or connect successfully but to the wrong target type.
-		do
+		if( disconnected && device->probeCountdown )
 		{
-			if( connectionAttemptsReamining != WII_LIB_MAX_CONNECTION_ATTEMPTS )
-				Delay_Ms( WII_LIB_DELAY_AFTER_CONNECTION_ATTEMPT_MS );
-
-			returnCode = WiiLib_ConnectToTarget( device );
-
-			if( returnCode == WII_LIB_RC_SUCCESS || returnCode == WII_LIB_RC_TARGET_ID_MISMATCH )
-			{
-				device->status = WII_LIB_DEVICE_STATUS_ACTIVE;
-				return WII_LIB_RC_SUCCESS;
-			}
-
-		} while( --connectionAttemptsReamining );
+			--device->probeCountdown;
+			return WII_LIB_RC_TARGET_DISCONNECTED;
+		}
+		
+		// Queries are refused while disconnected. Let the probe through.
+		device->status	= WII_LIB_DEVICE_STATUS_NOT_INITIALIZED;
+		returnCode		= WiiLib_ConnectToTarget( device );
+		
+		if( returnCode == WII_LIB_RC_SUCCESS || returnCode == WII_LIB_RC_TARGET_ID_MISMATCH )
+		{
+			device->status = WII_LIB_DEVICE_STATUS_ACTIVE;
+			return WII_LIB_RC_SUCCESS;
+		}
 		
+		if( disconnected )
+			device->status = WII_LIB_DEVICE_STATUS_DISCONNECTED;
+		
+		device->probeCountdown = WiiLib_BackOff( device, 1, WII_LIB_PROBE_MAX_SKIPPED_CALLS );
 		return WII_LIB_RC_TARGET_NOT_INITIALIZED;
 	} 
 	else
@@ -203,17 +346,30 @@ WII_LIB_RC WiiLib_DoMaintenance( WiiLib_Device *device )
 //!					but before exiting the function, grabs the initial device status (queries 
 //!					WII_LIB_PARAM_STATUS).
 //!	
+//!					A target of a different type than requested (e.g. a controller swapped while 
+//!					unplugged) is adopted: 'device->target' is updated and the connection completes 
+//!					as usual.
+//!	
 //!	@note			Only attempts to connect once. Repeated connection attempts (and any desired 
 //!					delays) should be handled by caller.
 //!	
+//!	@note			Blocks for the whole connection (configuration, settle delays, and status 
+//!					reads). Use 'WiiLib_Service()' to connect without blocking.
+//!	
 //!	@param[in]		*device				Instance of 'WiiLib_Device{}' to utilize.
 //!	
+//!	@retval			WII_LIB_RC_TARGET_ID_MISMATCH	Connected to a target of a different type than 
+//!													requested ('device->target' updated).
 //!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
 //!					non-zero == error code). Please see enum definition for details.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 WII_LIB_RC WiiLib_ConnectToTarget( WiiLib_Device *device )
 {
 	WII_LIB_TARGET_DEVICE		targetValueRead;
+	WII_LIB_RC					returnCode;
+	BOOL						mismatch;
+	
+	WII_STATS_COUNT( device, connectAttempts );
 	
 	// Push out configuration settings to device (uses flags defined when 'device' was initialized).
 	if( WiiLib_ConfigureDevice( device ) != WII_LIB_RC_SUCCESS )
@@ -222,16 +378,27 @@ WII_LIB_RC WiiLib_ConnectToTarget( WiiLib_Device *device )
 	// Confirm target is correct target by confirming able to query device ID and that the returned 
 	// value matches the desired value.
 	targetValueRead = WiiLib_DetermineDeviceType(device);
-	if( targetValueRead != device->target  && device->target != WII_LIB_TARGET_DEVICE_UNKNOWN )
-	{
-		device->target	= targetValueRead;
-		return WII_LIB_RC_TARGET_ID_MISMATCH;
-	}
+	if( targetValueRead == WII_LIB_TARGET_DEVICE_UNKNOWN )
+		return WII_LIB_RC_TARGET_NOT_INITIALIZED;
+	
+	mismatch = ( targetValueRead != device->target && device->target != WII_LIB_TARGET_DEVICE_UNKNOWN );
+	if( mismatch )
+		WiiLib_AdoptTarget( device, targetValueRead );
+	
+	WiiLib_Delay( device, WII_LIB_DELAY_AFTER_CONFIRM_ID_MS );
 	
-	Delay_Ms(WII_LIB_DELAY_AFTER_CONFIRM_ID_MS);
+	// Use the factory calibration as the home position when available (see 
+	// 'WiiCalibration_Attach()'). Otherwise record current status values from target and use those 
+	// as the home position for the device.
+	if( WiiCalibration_Load( device ) == WII_LIB_RC_SUCCESS )
+		returnCode = WiiLib_PollStatus( device );
+	else
+		returnCode = WiiLib_MeasureNewHomePosition( device );
+	
+	if( mismatch && (returnCode == WII_LIB_RC_SUCCESS || returnCode == WII_LIB_RC_RELATIVE_POSITION_FEATURE_DISABLED) )
+		return WII_LIB_RC_TARGET_ID_MISMATCH;
 	
-	// Record current status values from target and use those as the home position for the device.
-	return WiiLib_MeasureNewHomePosition( device );
+	return returnCode;
 	
 }
 
@@ -240,7 +407,11 @@ WII_LIB_RC WiiLib_ConnectToTarget( WiiLib_Device *device )
 //!	@brief			Pushes out configuration to target device.
 //!	
 //!	@details		Initializes target device in an encrypted or decrypted state based on the 
-//!					configuration flags in the provided device.
+//!					configuration flags in the provided device. A Wii Motion Plus is activated 
+//!					instead (see 'WiiLib_GetConfigAddr()').
+//!	
+//!	@note			Blocks until every message is sent (including the delay after each one). The 
+//!					non-blocking service pushes the same messages out one per call.
 //!	
 //!	@param[in]		*device				Instance of 'WiiLib_Device{}' defining target device 
 //!										interaction.
@@ -250,38 +421,48 @@ WII_LIB_RC WiiLib_ConnectToTarget( WiiLib_Device *device )
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 WII_LIB_RC WiiLib_ConfigureDevice( WiiLib_Device *device )
 {
+	const uint8_t	*first;
+	const uint8_t	*sequence;
+	I2C_Device		i2c;
 	uint8_t			buff[2];
+	uint8_t			count;
+	I2C_RC			i2cResult;
+	WII_STATS_DECLARE( start );
 	
-	// Initialize in most basic form. This leaves data in an encypted state.
-	if( device->dataEncrypted )
-	{
-		buff[0] = 0x40;
-		buff[1] = 0x00;
-		if( I2C_Transmit( &device->i2c, &buff[0], 2, TRUE ) != I2C_RC_SUCCESS )
-			return WII_LIB_RC_I2C_ERROR;
-	}
-	// Initialize such that future data transmitted is no longer encrypted.
-	else
+	if( WiiLib_SelectMuxChannel( device, NULL, NULL ) != WII_LIB_RC_SUCCESS )
+		return WII_LIB_RC_I2C_ERROR;
+	
+	i2c			= device->i2c;
+	i2c.addr	= WiiLib_GetConfigAddr( device );
+	first		= WiiLib_GetConfigSequence( device, &count );
+	
+	// Frames read before (re)configuring are neither merged nor compared against.
+	WiiMotionPlus_ResetPassThrough( device );
+	memset( &device->dataStatus[0], 0, WII_LIB_MAX_PAYLOAD_SIZE );
+	
+	for( sequence = first; count > 0; --count, sequence += 2 )
 	{
-		buff[0] = 0xF0;
-		buff[1] = 0x55;
-		if( I2C_Transmit( &device->i2c, &buff[0], 2, TRUE ) == I2C_RC_SUCCESS )
+		buff[0] = sequence[0];
+		buff[1] = sequence[1];
+		
+		WII_STATS_MARK( device, start );
+		i2cResult = device->backend->transmit( &i2c, &buff[0], 2, TRUE );
+		WII_STATS_TIME( device, WII_STATS_TIMER_BUS, start );
+		
+		if( i2cResult != I2C_RC_SUCCESS )
 		{
-			Delay_Ms(WII_LIB_DELAY_AFTER_CONFIG_MESSAGE_MS);
+			// An active Wii Motion Plus no longer answers at its activation address. Leave it to 
+			// the queries that follow to confirm it is present.
+			if( sequence == first && WiiLib_IsMotionPlus( device ) )
+				return WII_LIB_RC_SUCCESS;
 			
-			buff[0] = 0xFB;
-			buff[1] = 0x00;
-			if( I2C_Transmit( &device->i2c, &buff[0], 2, TRUE ) != I2C_RC_SUCCESS )
-				return WII_LIB_RC_I2C_ERROR;
-		}
-		else
-		{
+			WII_STATS_RESULT( device, WII_LIB_RC_I2C_ERROR );
 			return WII_LIB_RC_I2C_ERROR;
 		}
+		
+		WiiLib_Delay( device, WII_LIB_DELAY_AFTER_CONFIG_MESSAGE_MS );
 	}
 	
-	Delay_Ms(WII_LIB_DELAY_AFTER_CONFIG_MESSAGE_MS);
-	
 	return WII_LIB_RC_SUCCESS;
 	
 }
@@ -306,74 +487,82 @@ WII_LIB_RC WiiLib_ConfigureDevice( WiiLib_Device *device )
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 WII_LIB_RC WiiLib_QueryParameter( WiiLib_Device *device, WII_LIB_PARAM param )
 {
-	uint8_t			buffIn[WII_LIB_PARAM_REQUEST_LEN]		= { param };
+	uint8_t			buffIn[WII_LIB_PARAM_REQUEST_LEN]		= { WiiLib_GetRegister( device, param ) };
 	uint8_t			buffOut[WII_LIB_MAX_PAYLOAD_SIZE]		= {0};
-	uint8_t			decryptData								= device->dataEncrypted;
 	uint32_t		lenIn									= WII_LIB_PARAM_REQUEST_LEN;
 	uint32_t		lenOut;
+	WII_LIB_RC		returnCode;
+	I2C_RC			i2cResult;
+	WII_STATS_DECLARE( start );
 	
 	// Disable queries based on device status to prevent flooding the I2C bus if device 
 	// non-responsive.
 	if( device->status == WII_LIB_DEVICE_STATUS_DISABLED )
 		return WII_LIB_RC_DEVICE_DISABLED;
 	
+	if( device->status == WII_LIB_DEVICE_STATUS_DISCONNECTED )
+		return WII_LIB_RC_TARGET_DISCONNECTED;
+	
 	// Validate parameter ID provided and define response length (amount to query over I2C bus).
-	switch( param )
+	returnCode = WiiLib_GetResponseLength( device, param, &lenOut );
+	if( returnCode != WII_LIB_RC_SUCCESS )
+		return returnCode;
+	
+	// Execute I2C query, validate results, and (if necessary) decrypt value(s) received.
+	WII_STATS_MARK( device, start );
+	if( WiiLib_SelectMuxChannel( device, NULL, NULL ) != WII_LIB_RC_SUCCESS )
 	{
-		case WII_LIB_PARAM_STATUS:
-			// HACK:	Presently we need to push the configuration data out each time we communicate 
-			//			with the classic controller. Handling this automatically for status data queries.
-			if( device->target == WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER || device->target == WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC )
-				WiiLib_ConfigureDevice(device);
-		case WII_LIB_PARAM_DEVICE_TYPE:
-			lenOut		= WII_LIB_PARAM_RESPONSE_LEN_DEFAULT;
-			break;
-		
-		case WII_LIB_PARAM_RAW_DATA:
-			lenOut = WII_LIB_PARAM_RESPONSE_LEN_EXTENDED;
-			break;
-		
-		default:
-			return WII_LIB_RC_UNKOWN_PARAMETER;
-			break;
+		++device->failedParamQueryCount;
+		WII_STATS_RESULT( device, WII_LIB_RC_I2C_ERROR );
+		return WII_LIB_RC_I2C_ERROR;
 	}
 	
-	// Execute I2C query, validate results, and (if necessary) decrypt value(s) received.
-	if( I2C_TxRx( &device->i2c, &buffIn[0], lenIn, &buffOut[0], lenOut, TRUE, FALSE ) == I2C_RC_SUCCESS )
+	i2cResult = device->backend->txrx( &device->i2c, &buffIn[0], lenIn, &buffOut[0], lenOut, TRUE, FALSE );
+	WII_STATS_TIME( device, WII_STATS_TIMER_BUS, start );
+	
+	if( i2cResult != I2C_RC_SUCCESS )
 	{
-		if( !WiiLib_ValidateDataReceived(&buffOut[0], lenOut) )
-		{
-			memset( &device->dataCurrent[0], 0, WII_LIB_MAX_PAYLOAD_SIZE );
-			++device->failedParamQueryCount;
-			return WII_LIB_RC_DATA_RECEIVED_IS_INVALID;
-		}
+		++device->failedParamQueryCount;
+		WII_STATS_RESULT( device, WII_LIB_RC_I2C_ERROR );
+		return WII_LIB_RC_I2C_ERROR;
+	}
+	
+	WiiLib_Delay( device, WII_LIB_I2C_DELAY_POST_READ_MS );
+	
+	WII_STATS_MARK( device, start );
+	returnCode = WiiLib_ProcessResponse( device, param, &buffOut[0], lenOut, FALSE );
+	WII_STATS_TIME( device, WII_STATS_TIMER_DECODE, start );
+	WII_STATS_RESULT( device, returnCode );
+	
+	// Target dropped its configuration (responds with 'not ready' data). Reconfigure it and retry 
+	// the query once rather than reconfiguring ahead of every status query.
+	if(	returnCode == WII_LIB_RC_DATA_RECEIVED_IS_INVALID && param == WII_LIB_PARAM_STATUS && 
+		device->frame == WII_LIB_FRAME_NOT_READY && WiiLib_ReconfigureOnInvalidData( device ) )
+	{
+		WII_STATS_COUNT( device, reconfigures );
+		if( WiiLib_ConfigureDevice( device ) != WII_LIB_RC_SUCCESS )
+			return WII_LIB_RC_I2C_ERROR;
+		
+		WII_STATS_MARK( device, start );
+		i2cResult = device->backend->txrx( &device->i2c, &buffIn[0], lenIn, &buffOut[0], lenOut, TRUE, FALSE );
+		WII_STATS_TIME( device, WII_STATS_TIMER_BUS, start );
 		
-		if( decryptData )
+		if( i2cResult != I2C_RC_SUCCESS )
 		{
-			if( WiiLib_Decrypt( &buffOut[0], WII_LIB_ID_LENGTH ) != WII_LIB_RC_SUCCESS )
-			{
-				++device->failedParamQueryCount;
-				return WII_LIB_RC_UNABLE_TO_DECRYPT_DATA_RECEIVED;
-			}
+			++device->failedParamQueryCount;
+			WII_STATS_RESULT( device, WII_LIB_RC_I2C_ERROR );
+			return WII_LIB_RC_I2C_ERROR;
 		}
 		
-		// Save to store date received. Copy temporary buffer over to destination.
-		memcpy( &device->dataCurrent[0], &buffOut[0], WII_LIB_MAX_PAYLOAD_SIZE );
-		
-		// If we reach this point we know communication over I2C is valid and can clear the error 
-		// flag count.
-		device->failedParamQueryCount = 0;
-		
-		// Process data to infer the state of the user interface if query was for status:
-		if( param == WII_LIB_PARAM_STATUS )
-			return WiiLib_UpdateInterfaceTracking( device );
-		
-		return WII_LIB_RC_SUCCESS;
+		WiiLib_Delay( device, WII_LIB_I2C_DELAY_POST_READ_MS );
 		
+		WII_STATS_MARK( device, start );
+		returnCode = WiiLib_ProcessResponse( device, param, &buffOut[0], lenOut, FALSE );
+		WII_STATS_TIME( device, WII_STATS_TIMER_DECODE, start );
+		WII_STATS_RESULT( device, returnCode );
 	}
 	
-	++device->failedParamQueryCount;
-	return WII_LIB_RC_I2C_ERROR;
+	return returnCode;
 	
 }
 
@@ -390,6 +579,9 @@ WII_LIB_RC WiiLib_QueryParameter( WiiLib_Device *device, WII_LIB_PARAM param )
 //!	
 //!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
 //!	
+//!	@retval			WII_LIB_RC_PENDING	Only half of an interleaved frame was read from a Wii Motion 
+//!										Plus in pass-through mode (see 
+//!										'WiiMotionPlus_ProcessPassThrough()'). Poll again.
 //!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
 //!					non-zero == error code). Please see enum definition for details.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -399,6 +591,224 @@ WII_LIB_RC WiiLib_PollStatus( WiiLib_Device *device )
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Advances the non-blocking state machine for the provided device.
+//!	
+//!	@details		Non-blocking alternative to 'WiiLib_DoMaintenance()' + 'WiiLib_PollStatus()'. 
+//!					Every call executes at most one I2C transaction (configuration message, write of 
+//!					the register address, or read of the response) and then returns. Delays required 
+//!					by the target are tracked as deadlines against 'nowUs' rather than slept through. 
+//!					The job executed is selected with the same rules as 'WiiLib_DoMaintenance()':
+//!						-	Disabled:				nothing (see 'WII_LIB_DEVICE_STATUS_DISABLED').
+//!						-	Too many failures:		presume the target unplugged and probe for it.
+//!						-	Some failures:			reconfigure the target and then poll its status.
+//!						-	Not initialized or 
+//!							disconnected:			configure, confirm ID, and measure home position. 
+//!													A failed attempt is retried after a wait that 
+//!													doubles every time (from 
+//!													'WII_LIB_DELAY_PROBE_MIN_MS' up to 
+//!													'WII_LIB_DELAY_PROBE_MAX_MS').
+//!						-	Otherwise:				poll the target status.
+//!	
+//!	@note			'nowUs' is permitted to wrap. Deadlines are compared using the signed difference 
+//!					between timestamps, so the interval between calls must stay below ~35 minutes.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds (free-running counter).
+//!	
+//!	@retval			WII_LIB_RC_SUCCESS	A new status frame was read and processed during this call 
+//!										(or the device finished connecting).
+//!	@retval			WII_LIB_RC_PENDING	Work is in progress. No new data available yet.
+//!	@returns		Any other entry in the 'WII_LIB_RC' enum indicates the error encountered.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiLib_Service( WiiLib_Device *device, uint32_t nowUs )
+{
+	WII_LIB_RC		returnCode;
+	
+	for(;;)
+	{
+		switch( device->service.state )
+		{
+			case WII_LIB_SERVICE_STATE_SETTLE:
+				WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_DELAY_I2C_SETTLE_TIME_MS), WII_LIB_SERVICE_STATE_IDLE );
+				break;
+			
+			case WII_LIB_SERVICE_STATE_WAIT:
+				if( !WiiLib_TimeReached( nowUs, device->service.deadlineUs ) )
+					return WII_LIB_RC_PENDING;
+				WII_STATS_TIME( device, WII_STATS_TIMER_DELAY, device->service.waitStart );
+				device->service.state = device->service.nextState;
+				break;
+			
+			case WII_LIB_SERVICE_STATE_IDLE:
+				returnCode = WiiLib_ServiceSchedule( device );
+				if( returnCode != WII_LIB_RC_SUCCESS )
+					return returnCode;
+				break;
+			
+			case WII_LIB_SERVICE_STATE_CONFIG_WRITE:
+				return WiiLib_ServiceConfigWrite( device, nowUs );
+			
+			case WII_LIB_SERVICE_STATE_WRITE_POINTER:
+				return WiiLib_ServiceWritePointer( device, nowUs );
+			
+			case WII_LIB_SERVICE_STATE_READ:
+				return WiiLib_ServiceRead( device, nowUs );
+			
+			case WII_LIB_SERVICE_STATE_TRANSFER:
+				if( !device->service.transferDone )
+					return WII_LIB_RC_PENDING;
+				return WiiLib_ServiceTransferFinish( device, nowUs );
+			
+			default:
+				device->service.state = WII_LIB_SERVICE_STATE_IDLE;
+				break;
+			
+		}
+	}
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Selects the part of the status frame read by status queries.
+//!	
+//!	@details		Bus time per poll is roughly proportional to the number of bytes read:
+//!						-	'WII_LIB_REPORT_STANDARD':	Reads the full frame.
+//!						-	'WII_LIB_REPORT_BUTTONS':	Reads the byte(s) holding the buttons (nunchuck 
+//!														and classic controller only). Values other 
+//!														than 'buttons' keep their last value.
+//!						-	'WII_LIB_REPORT_HIGH_RESOLUTION':	Reads the full high-resolution 
+//!																frame (classic controller only). 
+//!																Joysticks and triggers are 8-bit.
+//!	
+//!	@note			The high-resolution data format is written by 'WiiLib_ConfigureDevice()' (call it 
+//!					after selecting the report on a connected target). Switching back to another 
+//!					report only restores the standard data format once the target is reconnected 
+//!					(the standard configuration does not write the data format).
+//!	
+//!	@note			Wii Motion Plus targets always read the full frame (the frame type flag is 
+//!					needed to decode it). A target that drops its configuration reads as idle 
+//!					buttons with a buttons-only report (the 'not ready' check needs a full frame).
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		report				Report profile to use.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiLib_SetReport( WiiLib_Device *device, WII_LIB_REPORT report )
+{
+	uint8_t			offset		= 0;
+	uint8_t			len			= WII_LIB_PARAM_RESPONSE_LEN_DEFAULT;
+	
+	if( report == WII_LIB_REPORT_BUTTONS )
+	{
+		switch( device->target )
+		{
+			case WII_LIB_TARGET_DEVICE_NUNCHUCK:
+				offset	= WII_NUNCHUCK_REPORT_BUTTONS_OFFSET;
+				len		= WII_NUNCHUCK_REPORT_BUTTONS_LEN;
+				break;
+			
+			case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
+				offset	= WII_CLASSIC_CONTROLLER_REPORT_BUTTONS_OFFSET;
+				len		= WII_CLASSIC_CONTROLLER_REPORT_BUTTONS_LEN;
+				break;
+			
+			default:
+				return WII_LIB_RC_UNSUPPORTED_DEVICE;
+			
+		}
+	}
+	else
+	{
+		// Full frame profiles. Their length is up to the driver of the target (see 
+		// "wii_driver.h").
+		if( device->driver && device->driver->frameLength )
+			len = device->driver->frameLength( report );
+		else if( report != WII_LIB_REPORT_STANDARD )
+			len = 0;
+		
+		if( !len )
+			return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	}
+	
+	device->report			= report;
+	device->reportOffset	= WII_LIB_PARAM_STATUS + offset;
+	device->reportLen		= len;
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the tables used to decrypt data read from an encrypted target.
+//!	
+//!	@details		The basic initialization leaves the target encrypted with the default (all zero) 
+//!					key which both tables default to. Targets given a custom key (written to 
+//!					registers 0x40 - 0x4F by the application) need the tables derived from that key.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		*xorKey				'WII_LIB_CIPHER_PERIOD' values xor'd with each byte (NULL == 
+//!										default key).
+//!	@param[in]		*addKey				'WII_LIB_CIPHER_PERIOD' values added to each byte (NULL == 
+//!										default key).
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiLib_SetCipher( WiiLib_Device *device, const uint8_t *xorKey, const uint8_t *addKey )
+{
+	uint8_t			index;
+	
+	for( index = 0; index < 2 * WII_LIB_CIPHER_PERIOD; ++index )
+	{
+		device->cipher.xorKey[index] = xorKey ? xorKey[index % WII_LIB_CIPHER_PERIOD] : WII_LIB_CIPHER_KEY_DEFAULT;
+		device->cipher.addKey[index] = addKey ? addKey[index % WII_LIB_CIPHER_PERIOD] : WII_LIB_CIPHER_KEY_DEFAULT;
+	}
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the multiplexer channel used to reach the target.
+//!	
+//!	@details		Every transfer to the target is preceded by a channel select write whenever 
+//!					'muxState' shows a different channel (or multiplexer) open on the module. When 
+//!					switching between multiplexers, the channel open on the previous one is closed 
+//!					first so only one target answers at the shared address.
+//!	
+//!	@note			All devices on the module (including ones wired directly, 'WII_LIB_MUX_NONE') 
+//!					must share the same 'muxState'. Must be invoked before any communication with 
+//!					the target (e.g. right after 'WiiLib_InitNonBlocking()').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		*muxState			Channel tracking shared by all devices on the module (NULL 
+//!										== no multiplexers on the bus).
+//!	@param[in]		muxAddr				Address of the multiplexer ('WII_LIB_MUX_NONE' == wired 
+//!										directly).
+//!	@param[in]		channel				Channel of the multiplexer the target is wired to.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiLib_SetMuxChannel( WiiLib_Device *device, WiiLib_MuxState *muxState, uint8_t muxAddr, uint8_t channel )
+{
+	if( channel >= WII_LIB_MUX_CHANNELS || muxAddr == WII_LIB_MUX_UNKNOWN || (muxAddr != WII_LIB_MUX_NONE && !muxState) )
+		return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	
+	device->muxState	= muxState;
+	device->muxAddr		= muxAddr;
+	device->muxSelect	= ( muxAddr == WII_LIB_MUX_NONE ? 0 : (uint8_t)(1 << channel) );
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //!	@brief			Refreshes tracking values for the target device's status bits.
 //!	
@@ -421,11 +831,16 @@ WII_LIB_RC WiiLib_PollStatus( WiiLib_Device *device )
 WII_LIB_RC WiiLib_MeasureNewHomePosition( WiiLib_Device *device )
 {
 	WII_LIB_RC		returnCode;
+	uint8_t			reads				= 0;
 	
 	if( ! device->calculateRelativePosition )
 		return WII_LIB_RC_RELATIVE_POSITION_FEATURE_DISABLED;
 	
-	returnCode = WiiLib_PollStatus( device );
+	// Pass-through targets take more than one read to fill both halves of the merged values.
+	do
+	{
+		returnCode = WiiLib_PollStatus( device );
+	} while( returnCode == WII_LIB_RC_PENDING && reads++ < WII_MOTION_PLUS_MERGE_MAX_AGE );
 	
 	if( returnCode == WII_LIB_RC_SUCCESS )
 		WiiLib_SaveCurrentPositionAsHome(device);
@@ -438,33 +853,74 @@ WII_LIB_RC WiiLib_MeasureNewHomePosition( WiiLib_Device *device )
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //!	@brief			Saves the current interface values as the new home position.
 //!	
-//!	@details		Executes a simple memcpy() to copy over data. Serves as a method to encapsulate/
+//!	@details		Executes a simple memcpy() to copy over data. Serves as a method to encapsulate/ 
 //!					abstract away the necessary pointer and size information.
 //!	
 //!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void WiiLib_SaveCurrentPositionAsHome( WiiLib_Device *device )
 {
-	memcpy( (void *)&device->interfaceHome, (void *)&device->interfaceCurrent, sizeof(WiiLib_Device) );
+	memcpy( (void *)&device->interfaceHome, (void *)&device->interfaceCurrent, sizeof(WiiLib_Interface) );
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-//!	@brief			Simple wrapper to handle enabling of relative positioning.
+//!	@brief			Computes the relative value of a single control.
 //!	
-//!	@note			No values interface tracking values are modified by this function. This function 
-//!					sole aim is to wrap the enable/disable flag for if relative position information 
-//!					is tracked and calculated.
+//!	@details		Relative values are the current value minus the home value. They are computed 
+//!					on demand from 'interfaceCurrent' and 'interfaceHome' rather than kept up to 
+//!					date with each frame. Buttons have no relative form and report their state.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		control				Control to compute (button bit position or analog control).
+//!	
+//!	@returns		Relative value of the control (0 or 1 for buttons). Zero if relative position 
+//!					is disabled or the control is unknown.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int32_t WiiLib_GetRelative( const WiiLib_Device *device, WII_LIB_CONTROL control )
+{
+	if( !device->calculateRelativePosition )
+		return 0;
+	
+	if( (uint32_t)control < WII_LIB_BUTTON_COUNT )
+		return ( (device->interfaceCurrent.buttons & WII_LIB_CONTROL_BIT( control )) ? 1 : 0 );
+	
+	switch( control )
+	{
+		WII_LIB_CONTROLS_ANALOG( WII_LIB_GET_RELATIVE )
+		
+		default:
+			return 0;
+		
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Computes the relative value of every control at once.
+//!	
+//!	@details		Buttons (edges included) are copied as is. Analog values are the current value 
+//!					minus the home value (see 'WiiLib_GetRelative()').
 //!	
 //!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[out]		*relative			Destination for the relative values.
 //!	
 //!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
 //!					non-zero == error code). Please see enum definition for details.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-WII_LIB_RC WiiLib_EnableRelativePosition( WiiLib_Device *device )
+WII_LIB_RC WiiLib_GetRelativeInterface( const WiiLib_Device *device, WiiLib_Interface *relative )
 {
-	device->calculateRelativePosition = TRUE;
+	if( !device->calculateRelativePosition )
+		return WII_LIB_RC_RELATIVE_POSITION_FEATURE_DISABLED;
+	
+	relative->buttons			= device->interfaceCurrent.buttons;
+	relative->buttonsPressed	= device->interfaceCurrent.buttonsPressed;
+	relative->buttonsReleased	= device->interfaceCurrent.buttonsReleased;
+	
+	WII_LIB_CONTROLS_ANALOG( WII_LIB_COPY_RELATIVE )
+	
 	return WII_LIB_RC_SUCCESS;
+	
 }
 
 
@@ -480,9 +936,28 @@ WII_LIB_RC WiiLib_EnableRelativePosition( WiiLib_Device *device )
 //!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
 //!					non-zero == error code). Please see enum definition for details.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-WII_LIB_RC WiiLib_DisableRelativePosition( WiiLib_Device *device )
+WII_LIB_RC WiiLib_EnableRelativePosition( WiiLib_Device *device )
 {
-	device->calculateRelativePosition = FALSE;
+	device->calculateRelativePosition = TRUE;
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Simple wrapper to handle enabling of relative positioning.
+//!	
+//!	@note			No values interface tracking values are modified by this function. This function 
+//!					sole aim is to wrap the enable/disable flag for if relative position information 
+//!					is tracked and calculated.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiLib_DisableRelativePosition( WiiLib_Device *device )
+{
+	device->calculateRelativePosition = FALSE;
 	return WII_LIB_RC_SUCCESS;
 }
 
@@ -493,7 +968,7 @@ WII_LIB_RC WiiLib_DisableRelativePosition( WiiLib_Device *device )
 //	PRIVATE METHODS
 //--------------------------------------------------------------------------------------------------
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-//!	@brief			Handles the process of determining the target device type based on reading its
+//!	@brief			Handles the process of determining the target device type based on reading its 
 //!					device ID register.
 //!	
 //!	@details		Queries the device for it's identifier by writing 'WII_LIB_PARAM_DEVICE_TYPE' to 
@@ -507,75 +982,433 @@ WII_LIB_RC WiiLib_DisableRelativePosition( WiiLib_Device *device )
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 static WII_LIB_TARGET_DEVICE WiiLib_DetermineDeviceType( WiiLib_Device *device )
 {
-	if( WiiLib_QueryParameter( device, WII_LIB_PARAM_DEVICE_TYPE ) == I2C_RC_SUCCESS )
+	if( WiiLib_QueryParameter( device, WII_LIB_PARAM_DEVICE_TYPE ) == WII_LIB_RC_SUCCESS )
+		return WiiLib_IdentifyTarget( &device->dataCurrent[0] );
+	
+	return WII_LIB_TARGET_DEVICE_UNKNOWN;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Compares an identifier read from a target against the known ID values.
+//!	
+//!	@details		Identifiers are looked up in the driver registry (see 'WiiDriver_FindById()'), 
+//!					so the cost does not grow with the number of targets supported.
+//!	
+//!	@param[in]		*id					Pointer to the (decrypted) 'WII_LIB_ID_LENGTH' byte ID.
+//!	
+//!	@returns		Entry from 'WII_LIB_TARGET_DEVICE{}' that represents the target device 
+//!					determined.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_TARGET_DEVICE WiiLib_IdentifyTarget( uint8_t *id )
+{
+	const WiiDriver		*driver		= WiiDriver_FindById( id );
+	
+	if( !driver )
+		return WII_LIB_TARGET_DEVICE_UNSUPPORTED;
+	
+	return driver->target;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Selects the configuration messages to push out to the target device.
+//!	
+//!	@details		Messages are stored as pairs of bytes (register address followed by value). The 
+//!					driver of the target selects its own sequence when it needs one (e.g. the data 
+//!					format of the report profile, or the activation mode for a Wii Motion Plus). 
+//!					Otherwise the sequence depends on if the target should leave its data encrypted.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[out]		*count				Number of messages in the returned sequence.
+//!	
+//!	@returns		Pointer to the first message in the sequence.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static const uint8_t * WiiLib_GetConfigSequence( WiiLib_Device *device, uint8_t *count )
+{
+	const uint8_t		*sequence;
+	
+	if( device->driver && device->driver->configure )
 	{
-		if( !memcmp( (uint8_t [])WII_LIB_ID_NUNCHUCK,						&device->dataCurrent[0],	WII_LIB_ID_LENGTH ) )
-			return WII_LIB_TARGET_DEVICE_NUNCHUCK;
-		
-		if( !memcmp( (uint8_t [])WII_LIB_ID_CLASSIC_CONTROLLER,				&device->dataCurrent[0],	WII_LIB_ID_LENGTH ) )
-			return WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER;
+		sequence = device->driver->configure( device, count );
+		if( sequence )
+			return sequence;
+	}
+	
+	if( device->dataEncrypted )
+	{
+		*count = sizeof(WiiLib_ConfigEncrypted) / 2;
+		return &WiiLib_ConfigEncrypted[0];
+	}
+	
+	*count = sizeof(WiiLib_ConfigDecrypted) / 2;
+	return &WiiLib_ConfigDecrypted[0];
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Selects the address configuration messages are sent to.
+//!	
+//!	@details		A Wii Motion Plus is activated at 'WII_LIB_I2C_ADDR_WII_MOTION_PLUS' and then 
+//!					answers at the target address ('WII_LIB_I2C_ADDR_STANDARD'). All other targets 
+//!					are configured at the target address.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Address to send configuration messages to.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint8_t WiiLib_GetConfigAddr( WiiLib_Device *device )
+{
+	if( WiiLib_IsMotionPlus( device ) )
+		return WII_LIB_I2C_ADDR_WII_MOTION_PLUS;
+	
+	return device->i2c.addr;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Determines if the target is a Wii Motion Plus (with or without pass-through).
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@retval			TRUE				Target is a Wii Motion Plus.
+//!	@retval			FALSE				Target is not a Wii Motion Plus.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiLib_IsMotionPlus( WiiLib_Device *device )
+{
+	return (	device->target == WII_LIB_TARGET_DEVICE_MOTION_PLUS					|| 
+				device->target == WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK	|| 
+				device->target == WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC	);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Determines if the target should be reconfigured when it replies to a status 
+//!					query with invalid ('not ready') data.
+//!	
+//!	@details		Classic controllers intermittently lose their configuration and then respond 
+//!					with 0xFF bytes until it is pushed out again. Re-arming the register pointer 
+//!					alone (done for every query) does not recover them. Drivers of such targets set 
+//!					'WII_DRIVER_FLAG_RECONFIGURE_ON_INVALID'.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@retval			TRUE				Reconfigure the target and retry the query.
+//!	@retval			FALSE				Treat invalid data as a normal failed query.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiLib_ReconfigureOnInvalidData( WiiLib_Device *device )
+{
+	return ( device->driver && (device->driver->flags & WII_DRIVER_FLAG_RECONFIGURE_ON_INVALID) );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Selects the register address written to start a parameter query.
+//!	
+//!	@details		Status queries start at the offset of the report profile (see 
+//!					'WiiLib_SetReport()'). All other parameters start at their own address.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		param				Parameter value to query.
+//!	
+//!	@returns		Register address to write.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint8_t WiiLib_GetRegister( WiiLib_Device *device, WII_LIB_PARAM param )
+{
+	if( param == WII_LIB_PARAM_STATUS )
+		return device->reportOffset;
+	
+	return (uint8_t)param;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Validates the parameter ID provided and defines the response length (amount to 
+//!					query over the I2C bus).
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		param				Parameter value to query.
+//!	@param[out]		*len				Number of bytes to read in response to the query.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_GetResponseLength( WiiLib_Device *device, WII_LIB_PARAM param, uint32_t *len )
+{
+	switch( param )
+	{
+		case WII_LIB_PARAM_STATUS:
+			*len = device->reportLen;
+			return WII_LIB_RC_SUCCESS;
 		
-		if( !memcmp( (uint8_t [])WII_LIB_ID_WII_MOTION_PLUS, 				&device->dataCurrent[0],	WII_LIB_ID_LENGTH ) )
-			return WII_LIB_TARGET_DEVICE_MOTION_PLUS;
+		case WII_LIB_PARAM_DEVICE_TYPE:
+			*len = WII_LIB_PARAM_RESPONSE_LEN_DEFAULT;
+			return WII_LIB_RC_SUCCESS;
 		
-		if( !memcmp( (uint8_t [])WII_LIB_ID_WII_MOTION_PLUS_PASS_NUNCHUCK,	&device->dataCurrent[0],	WII_LIB_ID_LENGTH ) )
-			return WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK;
+		case WII_LIB_PARAM_RAW_DATA:
+			*len = WII_LIB_PARAM_RESPONSE_LEN_EXTENDED;
+			return WII_LIB_RC_SUCCESS;
 		
-		if( !memcmp( (uint8_t [])WII_LIB_ID_WII_MOTION_PLUS_PASS_CLASSIC,	&device->dataCurrent[0],	WII_LIB_ID_LENGTH ) )
-			return WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC;
+		case WII_LIB_PARAM_CALIBRATION_CHECKSUM:
+			*len = WII_CALIBRATION_CHECKSUM_LEN;
+			return WII_LIB_RC_SUCCESS;
 		
-		return WII_LIB_TARGET_DEVICE_UNSUPPORTED;
+		default:
+			return WII_LIB_RC_UNKOWN_PARAMETER;
 		
 	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Processes the response read for a parameter query.
+//!	
+//!	@details		Validates the results, (if necessary) decrypts the value(s) received, and copies 
+//!					the result into 'device->dataCurrent[]'. Status queries are then interpreted to 
+//!					update the interface tracking values. The verdict of the validation is left in 
+//!					'device->frame' (see 'WII_LIB_FRAME').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		param				Parameter the response belongs to.
+//!	@param[in]		*data				Response read. Must be 'WII_LIB_MAX_PAYLOAD_SIZE' bytes long.
+//!	@param[in]		len					Number of bytes read from the target.
+//!	@param[in]		timed				Flag indicating if the response was read by 'WiiLib_Service()' 
+//!										(read issued at 'device->service.readUs').
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ProcessResponse( WiiLib_Device *device, WII_LIB_PARAM param, uint8_t *data, uint32_t len, BOOL timed )
+{
+	device->frame = WiiLib_ValidateDataReceived( data, len );
+	
+	if( device->frame == WII_LIB_FRAME_VALID && device->dataEncrypted )
+	{
+		if( WiiLib_Decrypt( &device->cipher, data, len, WiiLib_GetRegister( device, param ) ) != WII_LIB_RC_SUCCESS )
+		{
+			++device->failedParamQueryCount;
+			return WII_LIB_RC_UNABLE_TO_DECRYPT_DATA_RECEIVED;
+		}
+	}
 	
-	return WII_LIB_TARGET_DEVICE_UNKNOWN;
+	// Responses are logged as read (rejected frames included) so replays take the same path.
+	if( device->capture )
+		WiiCapture_Record( device, param, WiiLib_GetRegister( device, param ), data, len );
+	
+	// Fixed bits and repeats can only be checked once decrypted (and before the previous frame 
+	// is overwritten).
+	if( device->frame == WII_LIB_FRAME_VALID && param == WII_LIB_PARAM_STATUS )
+		device->frame = WiiLib_ValidateFrame( device, data, len );
+	
+	WII_STATS_COUNT( device, frames[device->frame] );
+	
+	if( device->frame >= WII_LIB_FRAME_NOT_READY )
+	{
+		memset( &device->dataCurrent[0], 0, WII_LIB_MAX_PAYLOAD_SIZE );
+		++device->failedParamQueryCount;
+		return WII_LIB_RC_DATA_RECEIVED_IS_INVALID;
+	}
+	
+	// Save to store date received. Copy temporary buffer over to destination. Status data lands at 
+	// its position within the status frame (see 'WiiLib_SetReport()').
+	if( param == WII_LIB_PARAM_STATUS )
+		memcpy( &device->dataCurrent[device->reportOffset - WII_LIB_PARAM_STATUS], data, len );
+	else
+		memcpy( &device->dataCurrent[0], data, WII_LIB_MAX_PAYLOAD_SIZE );
+	
+	if( param == WII_LIB_PARAM_DEVICE_TYPE )
+		memcpy( &device->id[0], data, WII_LIB_ID_LENGTH );
+	
+	// If we reach this point we know communication over I2C is valid and can clear the error 
+	// flag count.
+	device->failedParamQueryCount = 0;
+	
+	// Process data to infer the state of the user interface if query was for status:
+	if( param == WII_LIB_PARAM_STATUS )
+		return WiiLib_UpdateInterfaceTracking( device, timed );
+	
+	return WII_LIB_RC_SUCCESS;
 	
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-//!	@brief			Verifies the data provided is not a known set of invalid byte(s).
+//!	@brief			Verifies the data provided (as read, before decrypting) is not a known set of 
+//!					invalid bytes.
 //!	
-//!	@details		Confirms data is ready was ready to be read from the target device (did not 
-//!					receive all 0xFF bytes) and returns the result. Long term, any error codes can 
-//!					and should be checked by this function.
+//!	@details		Rejects data that is all 0xFF (no data ready to read) or all 0x00 (data line 
+//!					held low). The bytes are folded four at a time into a running AND and OR, so 
+//!					both checks take a single pass without a reference buffer.
 //!	
 //!	@param[in]		*data				Pointer to data to validate.
 //!	@param[in]		len					Number of bytes of data to validate.
 //!	
-//!	@retval			TRUE				Data is valid.
-//!	@retval			TRUE				Data is not valid.
+//!	@returns		'WII_LIB_FRAME_VALID', 'WII_LIB_FRAME_NOT_READY', or 'WII_LIB_FRAME_ALL_ZERO'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_FRAME WiiLib_ValidateDataReceived( const uint8_t *data, uint32_t len )
+{
+	uint32_t		allSet		= UINT32_MAX;
+	uint32_t		anySet		= 0;
+	uint32_t		word;
+	uint32_t		index;
+	
+	// Reads shorter than a full frame cannot be checked (idle buttons also read as '0xFF').
+	if( len < WII_LIB_PARAM_RESPONSE_LEN_DEFAULT )
+		return WII_LIB_FRAME_VALID;
+	
+	// Whole words first (copied out as buffers are not necessarily word aligned), then any 
+	// trailing bytes.
+	for( index = 0; index + sizeof(word) <= len; index += sizeof(word) )
+	{
+		memcpy( &word, &data[index], sizeof(word) );
+		allSet	&= word;
+		anySet	|= word;
+	}
+	
+	for( ; index < len; ++index )
+	{
+		allSet	&= ( 0xFFFFFF00UL | data[index] );
+		anySet	|= data[index];
+	}
+	
+	if( allSet == UINT32_MAX )
+		return WII_LIB_FRAME_NOT_READY;
+	
+	if( anySet == 0 )
+		return WII_LIB_FRAME_ALL_ZERO;
+	
+	return WII_LIB_FRAME_VALID;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Checks a decrypted status frame against the layout of the target and the 
+//!					previous frame.
+//!	
+//!	@details		Bits fixed by the layout (see the '*_FIXED_*' constants of the target) are only 
+//!					checked when they fall within the report window read. The comparison against 
+//!					the previous status frame validated ('device->dataStatus[]', which device type 
+//!					and raw data queries leave alone) is done a word at a time. Frames passing the 
+//!					checks replace it.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		*data				Decrypted status data (starting at 'device->reportOffset').
+//!	@param[in]		len					Number of bytes of data to validate.
+//!	
+//!	@returns		'WII_LIB_FRAME_VALID', 'WII_LIB_FRAME_REPEATED', or 'WII_LIB_FRAME_RESERVED'.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-static BOOL WiiLib_ValidateDataReceived( uint8_t *data, uint32_t len )
+static WII_LIB_FRAME WiiLib_ValidateFrame( WiiLib_Device *device, const uint8_t *data, uint32_t len )
 {
-	static uint8_t	notReady[WII_LIB_MAX_PAYLOAD_SIZE];
+	uint8_t				*previous	= &device->dataStatus[device->reportOffset - WII_LIB_PARAM_STATUS];
+	uint32_t			changed		= 0;
+	uint32_t			word;
+	uint32_t			wordPrevious;
+	uint32_t			index;
+	uint8_t				byte;
+	uint8_t				mask;
+	uint8_t				value;
+	
+	switch( device->target )
+	{
+		case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
+			byte	= ( device->report == WII_LIB_REPORT_HIGH_RESOLUTION ) ? WII_CLASSIC_CONTROLLER_HIGH_RES_FIXED_BYTE : WII_CLASSIC_CONTROLLER_FIXED_BYTE;
+			mask	= WII_CLASSIC_CONTROLLER_FIXED_MASK;
+			value	= WII_CLASSIC_CONTROLLER_FIXED_VALUE;
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS:
+			byte	= WII_MOTION_PLUS_FIXED_BYTE;
+			mask	= WII_MOTION_PLUS_FIXED_MASK | WII_MOTION_PLUS_FRAME_TYPE_MASK;
+			value	= WII_MOTION_PLUS_FIXED_VALUE | WII_MOTION_PLUS_FRAME_TYPE_MASK;
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
+			byte	= WII_MOTION_PLUS_FIXED_BYTE;
+			mask	= WII_MOTION_PLUS_FIXED_MASK;
+			value	= WII_MOTION_PLUS_FIXED_VALUE;
+			break;
+		
+		default:
+			byte	= 0;
+			mask	= 0;
+			value	= 0;
+			break;
+		
+	}
+	
+	if( mask && byte >= device->reportOffset && byte < device->reportOffset + len && (data[byte - device->reportOffset] & mask) != value )
+		return WII_LIB_FRAME_RESERVED;
+	
+	for( index = 0; index + sizeof(word) <= len; index += sizeof(word) )
+	{
+		memcpy( &word, &data[index], sizeof(word) );
+		memcpy( &wordPrevious, &previous[index], sizeof(wordPrevious) );
+		changed |= ( word ^ wordPrevious );
+	}
 	
-	// Confirm data is not all '0xFF' (indicates no data ready to read).
-	memset(&notReady[0], 0xFF, WII_LIB_MAX_PAYLOAD_SIZE);
-	if( memcmp( &notReady[0], data, len ) == 0 )
-		return FALSE;
+	for( ; index < len; ++index )
+		changed |= ( data[index] ^ previous[index] );
+	
+	memcpy( previous, data, len );
+	return ( changed ? WII_LIB_FRAME_VALID : WII_LIB_FRAME_REPEATED );
 	
-	return TRUE;
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //!	@brief			Handles the process of decrypting data received from a target device.
 //!	
-//!	@details		Executes the following to decrypt:
-//!						-	x = (x [xor] 0x17) + 0x17
+//!	@details		Executes the following to decrypt (see 'WiiLib_Cipher{}'):
+//!						-	x = (x [xor] xorKey[n]) + addKey[n]
+//!	
+//!					Four bytes are decrypted per step. The additions are done in the low 7 bits of 
+//!					each byte and the top bits are patched in with an xor so no carry crosses into 
+//!					the neighboring byte. The tables repeat every two words.
 //!	
+//!	@note			Whole words are processed so up to three bytes past 'len' are modified. 'data' 
+//!					must be 'WII_LIB_MAX_PAYLOAD_SIZE' bytes long (a multiple of four).
+//!	
+//!	@param[in]		*cipher				Decryption tables.
 //!	@param[in]		*data				Pointer to data to decrypt.
 //!	@param[in]		len					Number of bytes of data to decrypt.
+//!	@param[in]		addr				Register address the data was read from.
 //!	
 //!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
 //!					non-zero == error code). Please see enum definition for details.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-static WII_LIB_RC WiiLib_Decrypt( uint8_t *data, int8_t len )
+static WII_LIB_RC WiiLib_Decrypt( const WiiLib_Cipher *cipher, uint8_t *data, uint32_t len, uint8_t addr )
 {
-	for(;len > 0; --len, ++data)
+	uint32_t		xorWords[2];
+	uint32_t		addLow[2];
+	uint32_t		addHigh[2];
+	uint32_t		word;
+	uint32_t		index;
+	
+	if( len > WII_LIB_MAX_PAYLOAD_SIZE )
+		return WII_LIB_RC_UNABLE_TO_DECRYPT_DATA_RECEIVED;
+	
+	// Load the table entries for the first two words (byte order matches the data words).
+	memcpy( &xorWords[0],	&cipher->xorKey[addr % WII_LIB_CIPHER_PERIOD],	sizeof(xorWords) );
+	memcpy( &addLow[0],		&cipher->addKey[addr % WII_LIB_CIPHER_PERIOD],	sizeof(addLow) );
+	for( index = 0; index < 2; ++index )
+	{
+		addHigh[index]	= addLow[index] & 0x80808080;
+		addLow[index]	&= 0x7F7F7F7F;
+	}
+	
+	for( index = 0; index < len; index += sizeof(word) )
 	{
-		*data = (((*data ^ 0x17) + 0x17) & 0x00FF);
+		memcpy( &word, &data[index], sizeof(word) );
+		word ^= xorWords[(index >> 2) & 1];
+		word = ( (word & 0x7F7F7F7F) + addLow[(index >> 2) & 1] ) ^ ( (word & 0x80808080) ^ addHigh[(index >> 2) & 1] );
+		memcpy( &data[index], &word, sizeof(word) );
 	}
 	
 	return WII_LIB_RC_SUCCESS;
@@ -587,59 +1420,851 @@ static WII_LIB_RC WiiLib_Decrypt( uint8_t *data, int8_t len )
 //!	@brief			Wrapper to invoke the appropriate target-specific processing function to 
 //!					interpret the current status data.
 //!	
+//!	@details		The values decoded are compared against the previous frame to build 
+//!					'device->changedMask'. Button edges and the event source only handle the 
+//!					controls flagged. A frame repeating the previous one (see 
+//!					'WII_LIB_FRAME_REPEATED') is not decoded at all (pass-through frames excepted, 
+//!					as each one also ages the merge). Frames are decoded by the driver of the 
+//!					target (see "wii_driver.h").
+//!	
 //!	@note			Presumes data available in 'device->dataCurrent[]' is a valid payload from 
 //!					querying status data.
 //!	
 //!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		timed				Flag indicating if the frame was read by 'WiiLib_Service()' 
+//!										(read issued at 'device->service.readUs').
 //!	
-//!	@returns		Entry from 'WII_LIB_TARGET_DEVICE{}' that represents the target device 
-//!					determined.
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-static WII_LIB_RC WiiLib_UpdateInterfaceTracking( WiiLib_Device *device )
+static WII_LIB_RC WiiLib_UpdateInterfaceTracking( WiiLib_Device *device, BOOL timed )
 {
-	WII_LIB_RC		returnCode;
+	WiiLib_Interface	*current			= &device->interfaceCurrent;
+	WiiLib_Interface	previous			= device->interfaceCurrent;
+	WII_LIB_RC			returnCode;
+	uint32_t			changed				= 0;
 	
-	switch(device->target)
-	{
-		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
-		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
-			returnCode = WiiNunchuck_ProcessStatusParam( device );
-			break;
-		
-		case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
-		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
-			returnCode = WiiClassic_ProcessStatusParam( device );
-			break;
-		
-		case WII_LIB_TARGET_DEVICE_MOTION_PLUS:
-			// DEVELOPMENT NEEDED.
-			break;
-		
-		default:
-			return WII_LIB_RC_UNSUPPORTED_DEVICE;
-		
-	}
+	if( !device->driver )
+		return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	
+	if( device->frame == WII_LIB_FRAME_REPEATED && !(device->driver->flags & WII_DRIVER_FLAG_DECODE_REPEATED) )
+		returnCode = WII_LIB_RC_SUCCESS;
+	else
+		returnCode = device->driver->decode( device );
 	
-	// Calculate relative positioning values.
-	if( returnCode == WII_LIB_RC_SUCCESS && device->calculateRelativePosition )
+	// Flag the controls that changed and track button edges against the previous frame.
+	if( returnCode == WII_LIB_RC_SUCCESS )
 	{
-		memcpy( (void*)&device->interfaceRelative, (void*)&device->interfaceHome, WII_LIB_MAX_PAYLOAD_SIZE );
+		changed = ( previous.buttons ^ current->buttons );
+		WII_LIB_CONTROLS_ANALOG( WII_LIB_CHECK_CHANGED )
 		
-		device->interfaceRelative.triggerLeft	= device->interfaceCurrent.triggerLeft	- device->interfaceHome.triggerLeft;
-		device->interfaceRelative.triggerRight	= device->interfaceCurrent.triggerRight	- device->interfaceHome.triggerRight;
-		device->interfaceRelative.analogLeftX	= device->interfaceCurrent.analogLeftX	- device->interfaceHome.analogLeftX;
-		device->interfaceRelative.analogLeftY	= device->interfaceCurrent.analogLeftY	- device->interfaceHome.analogLeftY;
-		device->interfaceRelative.analogRightX	= device->interfaceCurrent.analogRightX	- device->interfaceHome.analogRightX;
-		device->interfaceRelative.analogRightY	= device->interfaceCurrent.analogRightY	- device->interfaceHome.analogRightY;
-		device->interfaceRelative.accelX		= device->interfaceCurrent.accelX		- device->interfaceHome.accelX;
-		device->interfaceRelative.accelY		= device->interfaceCurrent.accelY		- device->interfaceHome.accelY;
-		device->interfaceRelative.accelZ		= device->interfaceCurrent.accelZ		- device->interfaceHome.accelZ;
-		device->interfaceRelative.gyroX			= device->interfaceCurrent.gyroX		- device->interfaceHome.gyroX;
-		device->interfaceRelative.gyroY			= device->interfaceCurrent.gyroY		- device->interfaceHome.gyroY;
-		device->interfaceRelative.gyroZ			= device->interfaceCurrent.gyroZ		- device->interfaceHome.gyroZ;
+		current->buttonsPressed		= changed & current->buttons;
+		current->buttonsReleased	= changed & previous.buttons;
 	}
 	
+	device->changedMask = changed;
+	
+	// Advance the orientation estimate (see 'WiiFusion_Attach()'). Runs on every frame as rates 
+	// are integrated over time whether or not they changed. Frames read by the service are 
+	// integrated over the time measured since the previous one.
+	if( returnCode == WII_LIB_RC_SUCCESS && device->fusion )
+		WiiFusion_ProcessDevice( device, timed, device->service.readUs );
+	
+	// Queue events for the controls that changed (see 'WiiEvents_Attach()').
+	if( returnCode == WII_LIB_RC_SUCCESS && device->events )
+		WiiEvents_ProcessDevice( device );
+	
 	return returnCode;
 	
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Blocks for the requested number of milliseconds using the device backend.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		ms					Time to block in milliseconds.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiLib_Delay( WiiLib_Device *device, uint32_t ms )
+{
+	WII_STATS_DECLARE( start );
+	
+	WII_STATS_MARK( device, start );
+	device->backend->delayMs( ms );
+	WII_STATS_TIME( device, WII_STATS_TIMER_DELAY, start );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Switches the device over to a target of a different type than requested.
+//!	
+//!	@details		Used when the ID read while connecting does not match 'device->target' (e.g. 
+//!					a different controller was plugged in). The report profile is re-applied since 
+//!					its layout depends on the target (falling back to 'WII_LIB_REPORT_STANDARD' when 
+//!					the new target does not support it).
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		target				Target type identified.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiLib_AdoptTarget( WiiLib_Device *device, WII_LIB_TARGET_DEVICE target )
+{
+	device->target = target;
+	device->driver = WiiDriver_FindByTarget( target );
+	if( WiiLib_SetReport( device, device->report ) != WII_LIB_RC_SUCCESS )
+		WiiLib_SetReport( device, WII_LIB_REPORT_STANDARD );
+	
+	if( WiiLib_IsMotionPlus( device ) )
+		device->dataEncrypted = FALSE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Marks the target as unplugged.
+//!	
+//!	@details		Queries are refused until a probe (connection attempt) succeeds. The error 
+//!					count is cleared and the backoff restarts from its first interval.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiLib_Disconnect( WiiLib_Device *device )
+{
+	device->status					= WII_LIB_DEVICE_STATUS_DISCONNECTED;
+	device->failedParamQueryCount	= 0;
+	device->probeInterval			= 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Records a failed probe and computes the spacing before the next one.
+//!	
+//!	@details		The target is marked as unplugged (if not already). The spacing starts at 
+//!					'first' and doubles with every probe that fails, up to 'max'.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		first				Spacing after the first failed probe.
+//!	@param[in]		max					Longest spacing.
+//!	
+//!	@returns		Spacing before the next probe (same unit as 'first').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint32_t WiiLib_BackOff( WiiLib_Device *device, uint32_t first, uint32_t max )
+{
+	if( device->status != WII_LIB_DEVICE_STATUS_DISCONNECTED )
+		WiiLib_Disconnect( device );
+	
+	device->failedParamQueryCount	= 0;
+	
+	if( !device->probeInterval )
+		device->probeInterval = first;
+	else
+		device->probeInterval = ( device->probeInterval > (max / 2) ? max : device->probeInterval * 2 );
+	
+	return device->probeInterval;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Determines if a deadline has been reached.
+//!	
+//!	@details		Uses the signed difference between the timestamps so the comparison remains 
+//!					valid when the microsecond counter wraps.
+//!	
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	@param[in]		deadlineUs			Deadline in microseconds.
+//!	
+//!	@retval			TRUE				Deadline reached.
+//!	@retval			FALSE				Deadline not yet reached.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiLib_TimeReached( uint32_t nowUs, uint32_t deadlineUs )
+{
+	return ( (int32_t)(nowUs - deadlineUs) >= 0 );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Places the state machine into the wait state.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	@param[in]		delayUs				Time to wait in microseconds.
+//!	@param[in]		next				Step to advance to once the wait completes.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiLib_ServiceWait( WiiLib_Device *device, uint32_t nowUs, uint32_t delayUs, WII_LIB_SERVICE_STATE next )
+{
+	device->service.deadlineUs	= nowUs + delayUs;
+	device->service.nextState	= next;
+	device->service.state		= WII_LIB_SERVICE_STATE_WAIT;
+	WII_STATS_MARK( device, device->service.waitStart );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Selects the next job for the state machine to execute.
+//!	
+//!	@details		Mirrors the checks executed by 'WiiLib_DoMaintenance()'. Jobs that do not 
+//!					require any communication with the target (e.g. disabling the device) are 
+//!					handled immediately.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ServiceSchedule( WiiLib_Device *device )
+{
+	WiiLib_ServiceTracking		*service	= &device->service;
+	
+	if( device->status == WII_LIB_DEVICE_STATUS_STRUCTURE_NOT_DEFINED )
+		return WII_LIB_RC_TARGET_STRUCTURE_NOT_DEFINED;
+	
+	if( device->status == WII_LIB_DEVICE_STATUS_DISABLED )
+		return WII_LIB_RC_DEVICE_DISABLED;
+	
+	// Target presumed unplugged. Probe for it straight away (see 'WiiLib_ServiceFail()').
+	if( device->failedParamQueryCount > WII_LIB_MAX_FAILURES_BEFORE_DISCONNECTING )
+		WiiLib_Disconnect( device );
+	
+	service->configIndex	= 0;
+	service->statusReads	= 0;
+	service->frameRetries	= 0;
+	
+	if( device->status == WII_LIB_DEVICE_STATUS_NOT_INITIALIZED || device->status == WII_LIB_DEVICE_STATUS_DISCONNECTED )
+	{
+		service->job			= WII_LIB_SERVICE_JOB_CONNECT;
+		service->param			= WII_LIB_PARAM_DEVICE_TYPE;
+		service->state			= WII_LIB_SERVICE_STATE_CONFIG_WRITE;
+		WII_STATS_COUNT( device, connectAttempts );
+		return WII_LIB_RC_SUCCESS;
+	}
+	
+	if( device->failedParamQueryCount > WII_LIB_MAX_FAILURES_BEFORE_RECONFIGURING )
+	{
+		device->status			= WII_LIB_DEVICE_STATUS_CONFIGURING;
+		WII_STATS_COUNT( device, reconfigures );
+	}
+	
+	service->configFirst	= ( device->status == WII_LIB_DEVICE_STATUS_CONFIGURING );
+	service->job			= WII_LIB_SERVICE_JOB_POLL;
+	service->param			= WII_LIB_PARAM_STATUS;
+	service->state			= ( service->configFirst ? WII_LIB_SERVICE_STATE_CONFIG_WRITE : WII_LIB_SERVICE_STATE_WRITE_POINTER );
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Pushes out the next configuration message to the target.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ServiceConfigWrite( WiiLib_Device *device, uint32_t nowUs )
+{
+	WiiLib_ServiceTracking		*service	= &device->service;
+	const uint8_t				*sequence;
+	uint8_t						count;
+	
+	// Frames read before (re)configuring are neither merged nor compared against.
+	if( service->configIndex == 0 )
+	{
+		WiiMotionPlus_ResetPassThrough( device );
+		memset( &device->dataStatus[0], 0, WII_LIB_MAX_PAYLOAD_SIZE );
+	}
+	
+	sequence			= WiiLib_GetConfigSequence( device, &count );
+	service->buffer[0]	= sequence[ (service->configIndex * 2) + 0 ];
+	service->buffer[1]	= sequence[ (service->configIndex * 2) + 1 ];
+	
+	return WiiLib_ServiceTransfer( device, nowUs, 2, FALSE );
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Advances the configuration sequence once a configuration message is sent.
+//!	
+//!	@details		Once the final message is sent (and its delay observed), the state machine moves 
+//!					on to querying the parameter associated with the active job.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ServiceConfigWriteDone( WiiLib_Device *device, uint32_t nowUs )
+{
+	WiiLib_ServiceTracking		*service	= &device->service;
+	uint8_t						count;
+	
+	WiiLib_GetConfigSequence( device, &count );
+	
+	if( service->transferResult == WII_LIB_RC_SUCCESS )
+		++service->configIndex;
+	else if( service->configIndex == 0 && WiiLib_IsMotionPlus( device ) )
+		service->configIndex = count;		// Already active (see 'WiiLib_ConfigureDevice()').
+	else
+		return WiiLib_ServiceFail( device, nowUs, service->transferResult );
+	
+	if( service->configIndex < count )
+	{
+		WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_DELAY_AFTER_CONFIG_MESSAGE_MS), WII_LIB_SERVICE_STATE_CONFIG_WRITE );
+		return WII_LIB_RC_PENDING;
+	}
+	
+	if( device->status == WII_LIB_DEVICE_STATUS_CONFIGURING )
+		device->status = WII_LIB_DEVICE_STATUS_ACTIVE;
+	
+	WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_DELAY_AFTER_CONFIG_MESSAGE_MS), WII_LIB_SERVICE_STATE_WRITE_POINTER );
+	return WII_LIB_RC_PENDING;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Writes the parameter ID (register address) for the active job to the target.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ServiceWritePointer( WiiLib_Device *device, uint32_t nowUs )
+{
+	device->service.buffer[0] = WiiLib_GetRegister( device, device->service.param );
+	return WiiLib_ServiceTransfer( device, nowUs, WII_LIB_PARAM_REQUEST_LEN, FALSE );
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Schedules the read once the parameter ID is written.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ServiceWritePointerDone( WiiLib_Device *device, uint32_t nowUs )
+{
+	if( device->service.transferResult != WII_LIB_RC_SUCCESS )
+		return WiiLib_ServiceFail( device, nowUs, device->service.transferResult );
+	
+	WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_BETWEEN_TX_RX_MS), WII_LIB_SERVICE_STATE_READ );
+	return WII_LIB_RC_PENDING;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reads the response for the parameter of the active job.
+//!	
+//!	@details		The response is processed (decrypted and decoded) as soon as the transfer 
+//!					completes. See 'WiiLib_ServiceTransferDone()'.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ServiceRead( WiiLib_Device *device, uint32_t nowUs )
+{
+	uint32_t					len;
+	WII_LIB_RC					returnCode;
+	
+	returnCode = WiiLib_GetResponseLength( device, device->service.param, &len );
+	if( returnCode != WII_LIB_RC_SUCCESS )
+		return WiiLib_ServiceFail( device, nowUs, returnCode );
+	
+	memset( &device->service.buffer[0], 0, WII_LIB_MAX_PAYLOAD_SIZE );
+	return WiiLib_ServiceTransfer( device, nowUs, len, TRUE );
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Completes the active job or advances it to its next phase once the response has 
+//!					been read and processed.
+//!	
+//!	@details		Job outcomes:
+//!						-	Poll:		Job complete once the status frame is processed.
+//!						-	Connect:	The ID read is compared against the requested target, then 
+//!										the checksum of the calibration block is read and the block 
+//!										itself if not cached (see 'WiiCalibration_Find()') before 
+//!										measuring the home position (status query). Job complete once the home position is saved 
+//!										(or taken from the calibration).
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ServiceReadDone( WiiLib_Device *device, uint32_t nowUs )
+{
+	WiiLib_ServiceTracking		*service							= &device->service;
+	WII_LIB_RC					returnCode							= service->transferResult;
+	WII_LIB_TARGET_DEVICE		targetValueRead;
+	
+	// Target dropped its configuration (see 'WiiLib_QueryParameter()'). Reconfigure immediately and 
+	// retry the poll once instead of waiting for the error count to trigger maintenance.
+	if(	returnCode == WII_LIB_RC_DATA_RECEIVED_IS_INVALID && service->job == WII_LIB_SERVICE_JOB_POLL && 
+		device->frame == WII_LIB_FRAME_NOT_READY && !service->configFirst && WiiLib_ReconfigureOnInvalidData( device ) )
+	{
+		service->configFirst	= TRUE;
+		service->configIndex	= 0;
+		WII_STATS_COUNT( device, reconfigures );
+		WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_POST_READ_MS), WII_LIB_SERVICE_STATE_CONFIG_WRITE );
+		return WII_LIB_RC_PENDING;
+	}
+	
+	// Frame rejected (see 'WII_LIB_FRAME'). Read it again after a short wait rather than waiting 
+	// for the next poll (which may be a long way off with adaptive pacing).
+	if(	returnCode == WII_LIB_RC_DATA_RECEIVED_IS_INVALID && service->job == WII_LIB_SERVICE_JOB_POLL && 
+		++service->frameRetries <= WII_LIB_MAX_FRAME_RETRIES )
+	{
+		WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_DELAY_FRAME_RETRY_MS), WII_LIB_SERVICE_STATE_WRITE_POINTER );
+		return WII_LIB_RC_PENDING;
+	}
+	
+	// Only half of an interleaved pass-through frame is available (see 
+	// 'WiiMotionPlus_ProcessPassThrough()'). Read the other half straight away.
+	if( returnCode == WII_LIB_RC_PENDING && ++service->statusReads <= WII_MOTION_PLUS_MERGE_MAX_AGE )
+	{
+		WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_POST_READ_MS), WII_LIB_SERVICE_STATE_WRITE_POINTER );
+		return WII_LIB_RC_PENDING;
+	}
+	
+	if( returnCode != WII_LIB_RC_SUCCESS )
+		return WiiLib_ServiceFail( device, nowUs, returnCode );
+	
+	// Confirm target is correct target. A mismatch is accepted (target updated to match the 
+	// value read and connected as usual) just as it is by 'WiiLib_ConnectToTarget()'.
+	if( service->job == WII_LIB_SERVICE_JOB_CONNECT && service->param == WII_LIB_PARAM_DEVICE_TYPE )
+	{
+		targetValueRead = WiiLib_IdentifyTarget( &device->dataCurrent[0] );
+		
+		if( targetValueRead != device->target && device->target != WII_LIB_TARGET_DEVICE_UNKNOWN )
+			WiiLib_AdoptTarget( device, targetValueRead );
+		
+		device->calibration = NULL;
+		
+		if( WiiCalibration_IsSupported( device ) )
+		{
+			// Cached entries are matched against the checksum of the calibration block.
+			service->param	= WII_LIB_PARAM_CALIBRATION_CHECKSUM;
+			WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_POST_READ_MS + WII_LIB_DELAY_AFTER_CONFIRM_ID_MS), WII_LIB_SERVICE_STATE_WRITE_POINTER );
+			return WII_LIB_RC_PENDING;
+		}
+		else if( device->calculateRelativePosition )
+		{
+			// Record current status values from target (and use those as the home position when 
+			// no calibration is available).
+			service->param	= WII_LIB_PARAM_STATUS;
+			WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_POST_READ_MS + WII_LIB_DELAY_AFTER_CONFIRM_ID_MS), WII_LIB_SERVICE_STATE_WRITE_POINTER );
+			return WII_LIB_RC_PENDING;
+		}
+	}
+	else if( service->job == WII_LIB_SERVICE_JOB_CONNECT && service->param == WII_LIB_PARAM_CALIBRATION_CHECKSUM )
+	{
+		if( WiiCalibration_Find( device, &device->dataCurrent[0] ) == WII_LIB_RC_PENDING )
+		{
+			// Calibration not cached yet. Read the calibration block first.
+			service->param	= WII_LIB_PARAM_RAW_DATA;
+			WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_POST_READ_MS), WII_LIB_SERVICE_STATE_WRITE_POINTER );
+			return WII_LIB_RC_PENDING;
+		}
+		else if( device->calculateRelativePosition )
+		{
+			service->param	= WII_LIB_PARAM_STATUS;
+			WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_POST_READ_MS), WII_LIB_SERVICE_STATE_WRITE_POINTER );
+			return WII_LIB_RC_PENDING;
+		}
+	}
+	else if( service->job == WII_LIB_SERVICE_JOB_CONNECT && service->param == WII_LIB_PARAM_RAW_DATA )
+	{
+		// A block failing its checksum leaves the device uncalibrated (home position is measured).
+		WiiCalibration_Store( device, &device->dataCurrent[0] );
+		
+		if( device->calculateRelativePosition )
+		{
+			service->param	= WII_LIB_PARAM_STATUS;
+			WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_POST_READ_MS), WII_LIB_SERVICE_STATE_WRITE_POINTER );
+			return WII_LIB_RC_PENDING;
+		}
+	}
+	else if( service->job == WII_LIB_SERVICE_JOB_CONNECT && !device->calibration )
+	{
+		WiiLib_SaveCurrentPositionAsHome( device );
+	}
+	
+	if( service->job == WII_LIB_SERVICE_JOB_CONNECT )
+		device->status = WII_LIB_DEVICE_STATUS_ACTIVE;
+	
+	service->job = WII_LIB_SERVICE_JOB_NONE;
+	WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_POST_READ_MS), WII_LIB_SERVICE_STATE_IDLE );
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Executes the transfer prepared in 'device->service.buffer' for the current step.
+//!	
+//!	@details		Without a queue the transfer blocks for the duration of the bus traffic and the 
+//!					step is completed immediately. With a queue (see 'WiiAsync_Attach()') the 
+//!					transfer is handed off to the I2C interrupt and the state machine waits in 
+//!					'WII_LIB_SERVICE_STATE_TRANSFER' until 'WiiLib_ServiceTransferDone()' runs.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	@param[in]		len					Number of bytes to write or read.
+//!	@param[in]		read				Flag indicating if the transfer reads (TRUE) or writes (FALSE).
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ServiceTransfer( WiiLib_Device *device, uint32_t nowUs, uint32_t len, BOOL read )
+{
+	WiiLib_ServiceTracking		*service	= &device->service;
+	I2C_Device					*i2c		= &device->i2c;
+	WiiAsync_Transfer			chain[WII_LIB_SERVICE_MAX_TRANSFERS_PER_STEP];
+	WiiAsync_Transfer			*transfer;
+	uint8_t						count		= 0;
+	I2C_Device					i2cConfig;
+	I2C_RC						i2cResult;
+	uint8_t						addr;
+	
+	// Queue momentarily full (shared with other devices). Stay on the current step and retry on 
+	// the next call. Room is needed for the channel select writes as well.
+	if( device->queue && WiiAsync_GetFree( device->queue ) < WII_LIB_SERVICE_MAX_TRANSFERS_PER_STEP )
+		return WII_LIB_RC_PENDING;
+	
+	service->step			= service->state;
+	service->transferLen	= (uint8_t)len;
+	service->transferDone	= FALSE;
+	if( read )
+		service->readUs		= nowUs;
+	WII_STATS_MARK( device, service->transferStart );
+	addr					= ( service->step == WII_LIB_SERVICE_STATE_CONFIG_WRITE ? WiiLib_GetConfigAddr( device ) : device->i2c.addr );
+	
+	// Queued channel select writes are chained ahead of the transfer below so a failed select 
+	// drops the transfer (reported as failed) instead of sending it to whichever channel is open.
+	if( WiiLib_SelectMuxChannel( device, (device->queue ? &chain[0] : NULL), &count ) != WII_LIB_RC_SUCCESS )
+	{
+		WiiLib_ServiceTransferDone( device, WII_LIB_RC_I2C_ERROR );
+		return WiiLib_ServiceTransferFinish( device, nowUs );
+	}
+	
+	if( device->queue )
+	{
+		transfer			= &chain[count++];
+		transfer->device	= device;
+		transfer->addr		= addr;
+		transfer->data		= &service->buffer[0];
+		transfer->len		= (uint8_t)len;
+		transfer->read		= (uint8_t)read;
+		transfer->result	= WII_LIB_RC_PENDING;
+		transfer->callback	= WiiLib_ServiceTransferComplete;
+		transfer->context	= NULL;
+		
+		service->state = WII_LIB_SERVICE_STATE_TRANSFER;
+		WiiAsync_SubmitChain( device->queue, &chain[0], count );
+		
+		// Channel is only recorded as open once the transfer completes (see 
+		// 'WiiLib_ServiceTransferFinish()').
+		if( count > 1 )
+		{
+			device->muxPending					= TRUE;
+			device->muxState->pendingAddr		= device->muxAddr;
+			device->muxState->pendingChannels	= device->muxSelect;
+			++device->muxState->pending;
+		}
+		
+		return WII_LIB_RC_PENDING;
+	}
+	
+	if( addr != device->i2c.addr )
+	{
+		i2cConfig		= device->i2c;
+		i2cConfig.addr	= addr;
+		i2c				= &i2cConfig;
+	}
+	
+	if( read )
+		i2cResult = device->backend->receive( i2c, &service->buffer[0], len, TRUE );
+	else
+		i2cResult = device->backend->transmit( i2c, &service->buffer[0], len, TRUE );
+	
+	WiiLib_ServiceTransferDone( device, (i2cResult == I2C_RC_SUCCESS ? WII_LIB_RC_SUCCESS : WII_LIB_RC_I2C_ERROR) );
+	return WiiLib_ServiceTransferFinish( device, nowUs );
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Completion callback for transfers queued by 'WiiLib_ServiceTransfer()'.
+//!	
+//!	@note			Invoked from the I2C interrupt.
+//!	
+//!	@param[in]		*transfer			Transfer that completed.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiLib_ServiceTransferComplete( WiiAsync_Transfer *transfer )
+{
+	WiiLib_ServiceTransferDone( transfer->device, transfer->result );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Records the outcome of a transfer and processes any response read.
+//!	
+//!	@details		Runs in the context that completed the transfer (the I2C interrupt when queued) 
+//!					so status frames are decrypted and decoded as soon as they arrive. All 
+//!					remaining bookkeeping (timing and job progress) is deferred to 
+//!					'WiiLib_ServiceTransferFinish()'.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		result				Result of the bus transfer.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiLib_ServiceTransferDone( WiiLib_Device *device, WII_LIB_RC result )
+{
+	WiiLib_ServiceTracking		*service	= &device->service;
+	WII_STATS_DECLARE( start );
+	
+	WII_STATS_TIME( device, WII_STATS_TIMER_BUS, service->transferStart );
+	
+	if( result != WII_LIB_RC_SUCCESS )
+	{
+		// Channel may not have been selected. Force a reselect ahead of the next transfer (applied 
+		// by the main loop, see 'WiiLib_SelectMuxChannel()').
+		if( device->muxState )
+			device->muxState->invalid = TRUE;
+		
+		++device->failedParamQueryCount;
+		service->transferResult = WII_LIB_RC_I2C_ERROR;
+	}
+	else if( service->step == WII_LIB_SERVICE_STATE_READ )
+	{
+		WII_STATS_MARK( device, start );
+		service->transferResult = WiiLib_ProcessResponse( device, service->param, &service->buffer[0], service->transferLen, TRUE );
+		WII_STATS_TIME( device, WII_STATS_TIMER_DECODE, start );
+	}
+	else
+	{
+		service->transferResult = WII_LIB_RC_SUCCESS;
+	}
+	
+	WII_STATS_RESULT( device, service->transferResult );
+	service->transferDone = TRUE;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Completes the step that issued the finished transfer.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ServiceTransferFinish( WiiLib_Device *device, uint32_t nowUs )
+{
+	WiiLib_MuxState		*muxState	= device->muxState;
+	
+	// Record the channel selected ahead of the transfer as open once it is known to have worked 
+	// (any failure on the module sets 'invalid'). Only the last select queued on the module 
+	// describes the channel left open.
+	if( device->muxPending )
+	{
+		device->muxPending = FALSE;
+		if( --muxState->pending == 0 && !muxState->invalid )
+		{
+			muxState->muxAddr	= device->muxAddr;
+			muxState->channels	= device->muxSelect;
+		}
+	}
+	
+	switch( device->service.step )
+	{
+		case WII_LIB_SERVICE_STATE_CONFIG_WRITE:
+			return WiiLib_ServiceConfigWriteDone( device, nowUs );
+		
+		case WII_LIB_SERVICE_STATE_WRITE_POINTER:
+			return WiiLib_ServiceWritePointerDone( device, nowUs );
+		
+		default:
+			return WiiLib_ServiceReadDone( device, nowUs );
+	}
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Aborts the active job after a failed step.
+//!	
+//!	@details		A failed connection attempt leaves the target disconnected and the next attempt 
+//!					(probe) waits for the backoff interval (see 'WiiLib_BackOff()'). All other 
+//!					jobs are retried after the standard post-read delay. Error counts are updated by 
+//!					the caller.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	@param[in]		returnCode			Error encountered by the failed step.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_ServiceFail( WiiLib_Device *device, uint32_t nowUs, WII_LIB_RC returnCode )
+{
+	if( device->service.job == WII_LIB_SERVICE_JOB_CONNECT )
+	{
+		device->service.job = WII_LIB_SERVICE_JOB_NONE;
+		WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WiiLib_BackOff( device, WII_LIB_DELAY_PROBE_MIN_MS, WII_LIB_DELAY_PROBE_MAX_MS )), WII_LIB_SERVICE_STATE_IDLE );
+		return WII_LIB_RC_TARGET_NOT_INITIALIZED;
+	}
+	
+	device->service.job = WII_LIB_SERVICE_JOB_NONE;
+	WiiLib_ServiceWait( device, nowUs, WII_LIB_MS_TO_US(WII_LIB_I2C_DELAY_POST_READ_MS), WII_LIB_SERVICE_STATE_IDLE );
+	return returnCode;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Opens the multiplexer channel used to reach the target (if not already open).
+//!	
+//!	@details		Without a chain the select writes block and 'muxState' is updated once they 
+//!					succeed. With a chain the select writes are only added to it (queued by the 
+//!					caller ahead of the transfer they enable) and 'muxState' is updated once that 
+//!					transfer completes (see 'WiiLib_ServiceTransferFinish()'). Channels selected by 
+//!					transfers still in the queue are never relied on; the channel is selected again 
+//!					instead.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[out]		*chain				Destination for queued select writes (NULL == blocking).
+//!	@param[in,out]	*count				Number of transfers in 'chain' (updated when 'chain' is 
+//!										provided).
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_SelectMuxChannel( WiiLib_Device *device, WiiAsync_Transfer *chain, uint8_t *count )
+{
+	WiiLib_MuxState		*muxState	= device->muxState;
+	uint8_t				openAddr;
+	WII_LIB_RC			returnCode;
+	
+	if( !muxState )
+		return WII_LIB_RC_SUCCESS;
+	
+	// A transfer failed on the module (flagged from the I2C interrupt). Channel open is unknown.
+	if( muxState->invalid )
+	{
+		muxState->invalid	= FALSE;
+		muxState->muxAddr	= WII_LIB_MUX_UNKNOWN;
+	}
+	
+	if( !muxState->pending && muxState->muxAddr == device->muxAddr && muxState->channels == device->muxSelect )
+		return WII_LIB_RC_SUCCESS;
+	
+	// Close the channel open on a different multiplexer first. Otherwise two targets would answer 
+	// at the same address.
+	openAddr = ( muxState->pending ? muxState->pendingAddr : muxState->muxAddr );
+	if( openAddr != WII_LIB_MUX_NONE && openAddr != WII_LIB_MUX_UNKNOWN && openAddr != device->muxAddr )
+	{
+		returnCode = WiiLib_WriteMux( device, openAddr, (uint8_t*)&WiiLib_MuxClosed, chain, count );
+		if( returnCode != WII_LIB_RC_SUCCESS )
+		{
+			muxState->muxAddr = WII_LIB_MUX_UNKNOWN;
+			return returnCode;
+		}
+	}
+	
+	if( device->muxAddr != WII_LIB_MUX_NONE )
+	{
+		returnCode = WiiLib_WriteMux( device, device->muxAddr, &device->muxSelect, chain, count );
+		if( returnCode != WII_LIB_RC_SUCCESS )
+		{
+			muxState->muxAddr = WII_LIB_MUX_UNKNOWN;
+			return returnCode;
+		}
+	}
+	
+	if( !chain )
+	{
+		muxState->muxAddr	= device->muxAddr;
+		muxState->channels	= device->muxSelect;
+	}
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Writes the control byte of a multiplexer.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}' (port and backend used).
+//!	@param[in]		muxAddr				Address of the multiplexer.
+//!	@param[in]		*control			Channel mask to write. Must remain valid until the write 
+//!										completes when queued.
+//!	@param[out]		*chain				Destination for the queued write (NULL == blocking write).
+//!	@param[in,out]	*count				Number of transfers in 'chain' (incremented when queued).
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static WII_LIB_RC WiiLib_WriteMux( WiiLib_Device *device, uint8_t muxAddr, uint8_t *control, WiiAsync_Transfer *chain, uint8_t *count )
+{
+	WiiAsync_Transfer			*transfer;
+	I2C_Device					i2c;
+	
+	if( chain )
+	{
+		transfer			= &chain[(*count)++];
+		transfer->device	= device;
+		transfer->addr		= muxAddr;
+		transfer->data		= control;
+		transfer->len		= 1;
+		transfer->read		= FALSE;
+		transfer->result	= WII_LIB_RC_PENDING;
+		transfer->callback	= WiiLib_WriteMuxComplete;
+		transfer->context	= NULL;
+		return WII_LIB_RC_SUCCESS;
+	}
+	
+	i2c			= device->i2c;
+	i2c.addr	= muxAddr;
+	if( device->backend->transmit( &i2c, control, 1, TRUE ) != I2C_RC_SUCCESS )
+		return WII_LIB_RC_I2C_ERROR;
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Completion callback for queued multiplexer writes.
+//!	
+//!	@details		A failed write leaves the channel open unknown. The transfer chained behind it 
+//!					is dropped by the queue (see 'WiiAsync_SubmitChain()').
+//!	
+//!	@note			Invoked from the I2C interrupt (only sets 'WiiLib_MuxState.invalid').
+//!	
+//!	@param[in]		*transfer			Transfer that completed.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiLib_WriteMuxComplete( WiiAsync_Transfer *transfer )
+{
+	WiiLib_Device		*device		= transfer->device;
+	
+	if( transfer->result != WII_LIB_RC_SUCCESS && device->muxState )
+		device->muxState->invalid = TRUE;
+}
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Defines integer helpers shared by the sources of the "wii" library module.
+//!	
+//!	@note			Private to the library (not pulled into "wii_lib.h").
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef __WII_MATH__
+#define	__WII_MATH__
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Integer square root (digit by digit, no division).
+//!	
+//!	@param[in]		value				Value to take the square root of.
+//!	
+//!	@returns		Largest integer whose square does not exceed 'value'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static inline uint32_t WiiMath_Sqrt( uint32_t value )
+{
+	uint32_t		root		= 0;
+	uint32_t		bit			= (uint32_t)1 << 30;
+	uint32_t		mask;
+	
+	while( bit > value )
+		bit >>= 2;
+	
+	// 'mask' is all ones when the trial digit fits (avoids branching).
+	for( ; bit; bit >>= 2 )
+	{
+		mask	= -(uint32_t)( value >= root + bit );
+		value	-= (root + bit) & mask;
+		root	= (root >> 1) + (bit & mask);
+	}
+	
+	return root;
+	
+}
+
+
+#endif	// __WII_MATH__
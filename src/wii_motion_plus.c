@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements functions used to interpret data read from a Wii Motion Plus device.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <stddef.h>
+#include <string.h>
+#include "i2c.h"
+#include "wii_motion_plus.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static void						WiiMotionPlus_DecodeGyro(			WiiLib_Device *device		);
+static void						WiiMotionPlus_Age(					uint8_t *age				);
+
+
+
+
+//==================================================================================================
+//	PRIVATE CONSTANTS
+//--------------------------------------------------------------------------------------------------
+// Activation messages. Sent to 'WII_LIB_I2C_ADDR_WII_MOTION_PLUS' instead of the target address. 
+// Data is never encrypted once activated.
+static const uint8_t			WiiMotionPlus_ConfigStandalone[]		= { WII_MOTION_PLUS_REG_INIT, 0x55,		WII_MOTION_PLUS_REG_ACTIVATE, WII_MOTION_PLUS_MODE_STANDALONE		};	//!< Activates Wii Motion Plus without pass-through.
+static const uint8_t			WiiMotionPlus_ConfigPassNunchuck[]		= { WII_MOTION_PLUS_REG_INIT, 0x55,		WII_MOTION_PLUS_REG_ACTIVATE, WII_MOTION_PLUS_MODE_PASS_NUNCHUCK	};	//!< Activates Wii Motion Plus passing through a nunchuck.
+static const uint8_t			WiiMotionPlus_ConfigPassClassic[]		= { WII_MOTION_PLUS_REG_INIT, 0x55,		WII_MOTION_PLUS_REG_ACTIVATE, WII_MOTION_PLUS_MODE_PASS_CLASSIC		};	//!< Activates Wii Motion Plus passing through a classic controller.
+
+// Change each analog control must exceed to count as activity (see 'WiiDriver_Thresholds'). Controls 
+// a mode does not report never change, so the nunchuck table also serves the standalone mode.
+static const uint16_t			WiiMotionPlus_ThresholdsNunchuck[WII_LIB_CONTROL_ANALOG_COUNT]	=
+{
+	[WII_LIB_CONTROL_ANALOG_LEFT_X	- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_LEFT_Y	- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_X	- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_Y	- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ACCEL_X		- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ACCELEROMETER,
+	[WII_LIB_CONTROL_ACCEL_Y		- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ACCELEROMETER,
+	[WII_LIB_CONTROL_ACCEL_Z		- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ACCELEROMETER,
+	[WII_LIB_CONTROL_GYRO_X			- WII_LIB_BUTTON_COUNT]	= WII_MOTION_PLUS_THRESHOLD_GYRO,
+	[WII_LIB_CONTROL_GYRO_Y			- WII_LIB_BUTTON_COUNT]	= WII_MOTION_PLUS_THRESHOLD_GYRO,
+	[WII_LIB_CONTROL_GYRO_Z			- WII_LIB_BUTTON_COUNT]	= WII_MOTION_PLUS_THRESHOLD_GYRO,
+};
+
+static const uint16_t			WiiMotionPlus_ThresholdsClassic[WII_LIB_CONTROL_ANALOG_COUNT]	=
+{
+	[WII_LIB_CONTROL_TRIGGER_LEFT	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_TRIGGERS,
+	[WII_LIB_CONTROL_TRIGGER_RIGHT	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_TRIGGERS,
+	[WII_LIB_CONTROL_ANALOG_LEFT_X	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_ANALOG_LEFT,
+	[WII_LIB_CONTROL_ANALOG_LEFT_Y	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_ANALOG_LEFT,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_X	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_ANALOG_RIGHT,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_Y	- WII_LIB_BUTTON_COUNT]	= WII_CLASSIC_CONTROLLER_THRESHOLD_ANALOG_RIGHT,
+	[WII_LIB_CONTROL_GYRO_X			- WII_LIB_BUTTON_COUNT]	= WII_MOTION_PLUS_THRESHOLD_GYRO,
+	[WII_LIB_CONTROL_GYRO_Y			- WII_LIB_BUTTON_COUNT]	= WII_MOTION_PLUS_THRESHOLD_GYRO,
+	[WII_LIB_CONTROL_GYRO_Z			- WII_LIB_BUTTON_COUNT]	= WII_MOTION_PLUS_THRESHOLD_GYRO,
+};
+
+
+
+
+//==================================================================================================
+// PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Process current data for device as the response field from querying the device 
+//!					status register.
+//!	
+//!	@details		Populates the gyroscope values of 'device->interfaceCurrent'. Only used when 
+//!					the Wii Motion Plus is not passing through an extension (see 
+//!					'WiiMotionPlus_ProcessPassThrough()').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiMotionPlus_ProcessStatusParam(WiiLib_Device *device)
+{
+	const uint8_t		*data		= &device->dataCurrent[0];
+	
+	if( device->target != WII_LIB_TARGET_DEVICE_MOTION_PLUS )
+		return WII_LIB_RC_TARGET_ID_MISMATCH;
+	
+	// Extension frames are only interleaved in pass-through modes.
+	if( !(data[WII_MOTION_PLUS_FRAME_TYPE_BYTE] & WII_MOTION_PLUS_FRAME_TYPE_MASK) )
+		return WII_LIB_RC_DATA_RECEIVED_IS_INVALID;
+	
+	WiiMotionPlus_DecodeGyro( device );
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Process current data for a Wii Motion Plus in pass-through mode as the response 
+//!					field from querying the device status register.
+//!	
+//!	@details		In pass-through mode the target alternates between frames of gyroscope data and 
+//!					frames of extension (nunchuck or classic controller) data. Each frame is routed 
+//!					to the matching decoder based on the frame type flag and merged into 
+//!					'device->passThrough.staged'. The merged values are only published to 
+//!					'device->interfaceCurrent' once both halves are fresh (neither older than 
+//!					'WII_MOTION_PLUS_MERGE_MAX_AGE' frames). The age of each half is tracked in 
+//!					'device->passThrough'.
+//!	
+//!					When a gyroscope frame reports no extension plugged into the Wii Motion Plus, 
+//!					the extension half is dropped (values cleared) and the gyroscope values are 
+//!					published on their own.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@retval			WII_LIB_RC_SUCCESS	Merged values were published to 'device->interfaceCurrent'.
+//!	@retval			WII_LIB_RC_PENDING	Frame was merged but the other half is missing or stale. 
+//!										'device->interfaceCurrent' keeps the last published 
+//!										values with no button edges.
+//!	@returns		Any other entry in the 'WII_LIB_RC' enum indicates the error encountered.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiMotionPlus_ProcessPassThrough(WiiLib_Device *device)
+{
+	WiiLib_PassThrough	*merge		= &device->passThrough;
+	WiiLib_Interface	published	= device->interfaceCurrent;
+	WII_LIB_RC			returnCode;
+	BOOL				gyroOnly	= FALSE;
+	
+	// The decoders write to 'interfaceCurrent'. Decode on top of the staged halves and put the 
+	// published values back afterwards unless the merged values are ready.
+	device->interfaceCurrent = merge->staged;
+	
+	if( device->dataCurrent[WII_MOTION_PLUS_FRAME_TYPE_BYTE] & WII_MOTION_PLUS_FRAME_TYPE_MASK )
+	{
+		// Nothing plugged into the Wii Motion Plus: no extension frames will follow, so do not 
+		// wait for them (or keep publishing the values of an extension since unplugged).
+		if( !(device->dataCurrent[WII_MOTION_PLUS_EXTENSION_BYTE] & WII_MOTION_PLUS_EXTENSION_MASK) )
+		{
+			memset( &device->interfaceCurrent, 0, sizeof(device->interfaceCurrent) );
+			merge->ageExtension	= WII_MOTION_PLUS_AGE_NEVER;
+			gyroOnly			= TRUE;
+		}
+		
+		WiiMotionPlus_DecodeGyro( device );
+		returnCode = WII_LIB_RC_SUCCESS;
+	}
+	else if( device->target == WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK )
+		returnCode = WiiNunchuck_ProcessStatusParam( device );
+	else
+		returnCode = WiiClassic_ProcessStatusParam( device );
+	
+	merge->staged = device->interfaceCurrent;
+	
+	if( returnCode == WII_LIB_RC_SUCCESS )
+	{
+		WiiMotionPlus_Age( &merge->ageMotionPlus );
+		WiiMotionPlus_Age( &merge->ageExtension );
+		
+		if( device->dataCurrent[WII_MOTION_PLUS_FRAME_TYPE_BYTE] & WII_MOTION_PLUS_FRAME_TYPE_MASK )
+			merge->ageMotionPlus	= 0;
+		else
+			merge->ageExtension		= 0;
+		
+		if( gyroOnly || (merge->ageMotionPlus <= WII_MOTION_PLUS_MERGE_MAX_AGE && merge->ageExtension <= WII_MOTION_PLUS_MERGE_MAX_AGE) )
+			return WII_LIB_RC_SUCCESS;
+		
+		returnCode = WII_LIB_RC_PENDING;
+	}
+	
+	// Nothing new was published: the edges of the last published frame do not repeat.
+	device->interfaceCurrent					= published;
+	device->interfaceCurrent.buttonsPressed		= 0;
+	device->interfaceCurrent.buttonsReleased	= 0;
+	return returnCode;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Forgets both halves of the pass-through merge.
+//!	
+//!	@details		Called whenever the target is (re)configured so values merged before then are 
+//!					never published alongside values read afterwards.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiMotionPlus_ResetPassThrough(WiiLib_Device *device)
+{
+	device->passThrough.ageMotionPlus	= WII_MOTION_PLUS_AGE_NEVER;
+	device->passThrough.ageExtension	= WII_MOTION_PLUS_AGE_NEVER;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Selects the activation messages for the mode of the target (see 
+//!					'WiiDriver_Configure').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[out]		*count				Number of messages in the returned sequence.
+//!	
+//!	@returns		Pointer to the first message in the sequence (NULL == not a Wii Motion Plus).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const uint8_t * WiiMotionPlus_GetConfigSequence( WiiLib_Device *device, uint8_t *count )
+{
+	switch( device->target )
+	{
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS:
+			*count = sizeof(WiiMotionPlus_ConfigStandalone) / 2;
+			return &WiiMotionPlus_ConfigStandalone[0];
+		
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
+			*count = sizeof(WiiMotionPlus_ConfigPassNunchuck) / 2;
+			return &WiiMotionPlus_ConfigPassNunchuck[0];
+		
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
+			*count = sizeof(WiiMotionPlus_ConfigPassClassic) / 2;
+			return &WiiMotionPlus_ConfigPassClassic[0];
+		
+		default:
+			return NULL;
+		
+	}
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Returns the activity thresholds for the mode of the target (see 
+//!					'WiiDriver_Thresholds').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Change each analog control must exceed, indexed by control - 
+//!					'WII_LIB_BUTTON_COUNT' (NULL == not a Wii Motion Plus).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const uint16_t * WiiMotionPlus_GetThresholds( WiiLib_Device *device )
+{
+	switch( device->target )
+	{
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
+			return &WiiMotionPlus_ThresholdsNunchuck[0];
+		
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
+			return &WiiMotionPlus_ThresholdsClassic[0];
+		
+		default:
+			return NULL;
+		
+	}
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Converts a raw gyroscope reading to fixed-point deg/s.
+//!	
+//!	@details		Result has 'WII_MOTION_PLUS_GYRO_FRACTION_BITS' fractional bits (e.g. 8 == 
+//!					1 deg/s) regardless of the mode the reading was taken in, so slow and fast mode 
+//!					readings can be mixed freely by callers.
+//!	
+//!	@param[in]		raw					14-bit reading.
+//!	@param[in]		slow				Flag indicating if the reading was taken in slow mode.
+//!	
+//!	@returns		Angular rate in deg/s (fixed-point).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int16_t WiiMotionPlus_ScaleGyro( int16_t raw, BOOL slow )
+{
+	int32_t			scaled		= (int32_t)(raw - WII_MOTION_PLUS_GYRO_ZERO) * ( slow ? WII_MOTION_PLUS_GYRO_SCALE_SLOW : WII_MOTION_PLUS_GYRO_SCALE_FAST );
+	
+	return (int16_t)( scaled / (1L << WII_MOTION_PLUS_GYRO_SCALE_SHIFT) );
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Populates the gyroscope values of 'device->interfaceCurrent' from the present 
+//!					frame.
+//!	
+//!	@details		Applies the field descriptor table and converts each axis to fixed-point deg/s 
+//!					based on its slow/fast mode flag (see 'WiiMotionPlus_ScaleGyro()').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiMotionPlus_DecodeGyro( WiiLib_Device *device )
+{
+	const uint8_t		*data		= &device->dataCurrent[0];
+	WiiLib_Interface	*current	= &device->interfaceCurrent;
+	
+	WII_MOTION_PLUS_FIELDS_GYRO( WII_LIB_DECODE_FIELD )
+	
+	current->gyroX		= WiiMotionPlus_ScaleGyro( current->gyroX, (data[WII_MOTION_PLUS_SLOW_PITCH_BYTE]	& WII_MOTION_PLUS_SLOW_PITCH_MASK)	);
+	current->gyroY		= WiiMotionPlus_ScaleGyro( current->gyroY, (data[WII_MOTION_PLUS_SLOW_ROLL_BYTE]	& WII_MOTION_PLUS_SLOW_ROLL_MASK)	);
+	current->gyroZ		= WiiMotionPlus_ScaleGyro( current->gyroZ, (data[WII_MOTION_PLUS_SLOW_YAW_BYTE]		& WII_MOTION_PLUS_SLOW_YAW_MASK)	);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Ages a half of the pass-through merge by one frame.
+//!	
+//!	@param[in]		*age				Age to update (saturates at 'WII_MOTION_PLUS_AGE_NEVER').
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiMotionPlus_Age( uint8_t *age )
+{
+	if( *age != WII_MOTION_PLUS_AGE_NEVER )
+		++(*age);
+}
@@ -14,6 +14,25 @@
 
 
 
+//==================================================================================================
+//	PRIVATE CONSTANTS
+//--------------------------------------------------------------------------------------------------
+// Change each analog control must exceed to count as activity (see 'WiiDriver_Thresholds'). The 
+// nunchuck reports its joystick through both the left and right members.
+static const uint16_t			WiiNunchuck_Thresholds[WII_LIB_CONTROL_ANALOG_COUNT]	=
+{
+	[WII_LIB_CONTROL_ANALOG_LEFT_X	- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_LEFT_Y	- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_X	- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ANALOG_RIGHT_Y	- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ANALOG,
+	[WII_LIB_CONTROL_ACCEL_X		- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ACCELEROMETER,
+	[WII_LIB_CONTROL_ACCEL_Y		- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ACCELEROMETER,
+	[WII_LIB_CONTROL_ACCEL_Z		- WII_LIB_BUTTON_COUNT]	= WII_NUNCHUCK_THRESHOLD_ACCELEROMETER,
+};
+
+
+
+
 //==================================================================================================
 // PUBLIC METHODS
 //--------------------------------------------------------------------------------------------------
@@ -22,7 +41,8 @@
 //!					status register.
 //!	
 //!	@details		Populates the relevant 'device->interfaceCurrent' values by applying the 
-//!					appropriate bitfield mapping and merging values.
+//!					field descriptor table for the target mode. A buttons-only report (see 
+//!					'WiiLib_SetReport()') only updates the buttons.
 //!	
 //!	@note			The nunchuck does not have multiple (left and right) fields. For situations 
 //!					where the nunchuck uses a 'instance' member that is tracked across multipe 
@@ -36,47 +56,50 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 WII_LIB_RC WiiNunchuck_ProcessStatusParam(WiiLib_Device *device)
 {
+	const uint8_t		*data		= &device->dataCurrent[0];
+	WiiLib_Interface	*current	= &device->interfaceCurrent;
+	
 	switch( device->target )
 	{
 		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
-		{
-			WiiNunchuck_StatusNormal	*bitfields	= (WiiNunchuck_StatusNormal*)&device->dataCurrent[0];
+			if( device->report == WII_LIB_REPORT_BUTTONS )
+			{
+				WII_NUNCHUCK_FIELDS_BUTTONS( WII_LIB_DECODE_FIELD )
+				return WII_LIB_RC_SUCCESS;
+			}
 			
-			device->interfaceCurrent.buttonC			= !(bitfields->buttonC & 0x01);
-			device->interfaceCurrent.buttonZL			= !(bitfields->buttonZ & 0x01);
-			device->interfaceCurrent.analogLeftX		= bitfields->analogX;
-			device->interfaceCurrent.analogLeftY		= bitfields->analogY;
-			device->interfaceCurrent.accelX				= ( (bitfields->accelXHigh << 2) | (bitfields->accelXLow & 0x03) );
-			device->interfaceCurrent.accelY				= ( (bitfields->accelYHigh << 2) | (bitfields->accelYLow & 0x03) );
-			device->interfaceCurrent.accelZ				= ( (bitfields->accelZHigh << 2) | (bitfields->accelZLow & 0x03) );
+			WII_NUNCHUCK_FIELDS_NORMAL( WII_LIB_DECODE_FIELD )
 			break;
-		}
 		
 		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
-		{
-			WiiNunchuck_StatusPassThrough	*bitfields	= (WiiNunchuck_StatusPassThrough*)&device->dataCurrent[0];
-			
-			device->interfaceCurrent.buttonC			= !(bitfields->buttonC & 0x01);
-			device->interfaceCurrent.buttonZL			= !(bitfields->buttonZ & 0x01);
-			device->interfaceCurrent.analogLeftX		= bitfields->analogX;
-			device->interfaceCurrent.analogLeftY		= bitfields->analogY;
-			device->interfaceCurrent.accelX				= ( (bitfields->accelXHigh << 2)			| ((bitfields->accelXLow & 0x01) << 1)	);
-			device->interfaceCurrent.accelY				= ( (bitfields->accelYHigh << 2)			| ((bitfields->accelYLow & 0x01) << 1)	);
-			device->interfaceCurrent.accelZ				= ( ((bitfields->accelZHigh & 0xFE) << 2)	| ((bitfields->accelZLow & 0x03) << 1)	);
+			WII_NUNCHUCK_FIELDS_PASS_THROUGH( WII_LIB_DECODE_FIELD )
 			break;
-		}
 		
 		default:
 			return WII_LIB_RC_TARGET_ID_MISMATCH;
 		
 	}
 	
-	// Keep things consistent by duplicating left and right values for [relevant] nunchuck features.
-	device->interfaceCurrent.buttonZR				= device->interfaceCurrent.buttonZL;
-	device->interfaceCurrent.analogRightX			= device->interfaceCurrent.analogLeftX;
-	device->interfaceCurrent.analogRightY			= device->interfaceCurrent.analogLeftY;
+	// Keep things consistent by duplicating left and right values for [relevant] nunchuck features 
+	// (Z button already mapped to both ZL and ZR).
+	current->analogRightX		= current->analogLeftX;
+	current->analogRightY		= current->analogLeftY;
 	
 	return WII_LIB_RC_SUCCESS;
 	
 }
 
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Returns the activity thresholds of a nunchuck (see 'WiiDriver_Thresholds').
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Change each analog control must exceed, indexed by control - 
+//!					'WII_LIB_BUTTON_COUNT'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const uint16_t * WiiNunchuck_GetThresholds( WiiLib_Device *device )
+{
+	return &WiiNunchuck_Thresholds[0];
+	
+}
@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements the optional joystick output stage of the "wii" library module.
+//!	
+//!	@details		Each joystick is processed as follows:
+//!						1.	Relative values are scaled into Q15 by the multiplier matching their 
+//!							sign (joysticks are rarely centered in their range).
+//!						2.	Axial: each axis is replaced by the table value for its length. 
+//!							Radial: the length of the vector indexes a gain applied to both axes.
+//!	
+//!					The table holds the deadzone (lengths inside it map to zero, the remainder is 
+//!					stretched back to the full range) followed by the response curve.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+#include "i2c.h"
+#include "wii_lib.h"
+#include "wii_math.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static void						WiiOutput_SetScale(					WiiOutput_Config *config,	uint8_t axis,			int32_t below,			int32_t above			);
+static int32_t					WiiOutput_Curve(					const int16_t *curve,		int32_t value			);
+static int32_t					WiiOutput_Lookup(					const int32_t *table,		uint32_t value			);
+static int32_t					WiiOutput_Scale(					const WiiOutput_Config *config,	uint8_t axis,		int32_t value			);
+static int16_t					WiiOutput_Clamp(					int32_t value				);
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Precomputes the output stage settings for the provided device.
+//!	
+//!	@details		Joystick ranges come from the factory calibration of the device when available 
+//!					('device->calibration', home position == calibrated center). Otherwise the 
+//!					nominal half range of each joystick is used.
+//!	
+//!	@note			Invoke again after the device (re)connects to pick up its calibration.
+//!	
+//!	@param[out]		*config				Settings to initialize.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		mode				Shape of the deadzone.
+//!	@param[in]		deadzone			Size of the deadzone (Q15, 0 == none).
+//!	@param[in]		*curve				'WII_OUTPUT_CURVE_POINTS' response curve values (Q15, 
+//!										NULL == linear).
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiOutput_Init( WiiOutput_Config *config, WiiLib_Device *device, WII_OUTPUT_DEADZONE mode, int16_t deadzone, const int16_t *curve )
+{
+	const WiiLib_Interface	*minimum;
+	const WiiLib_Interface	*center;
+	const WiiLib_Interface	*maximum;
+	int32_t					length;
+	int32_t					value;
+	uint8_t					index;
+	
+	if( deadzone < 0 || deadzone >= WII_OUTPUT_Q15_MAX )
+		return WII_LIB_RC_UNKOWN_PARAMETER;
+	
+	switch( device->target )
+	{
+		case WII_LIB_TARGET_DEVICE_NUNCHUCK:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_NUNCHUCK:
+			for( index = 0; index < 4; ++index )
+				WiiOutput_SetScale( config, index, WII_NUNCHUCK_ANALOG_HALF_RANGE, WII_NUNCHUCK_ANALOG_HALF_RANGE );
+			break;
+		
+		case WII_LIB_TARGET_DEVICE_CLASSIC_CONTROLLER:
+		case WII_LIB_TARGET_DEVICE_MOTION_PLUS_PASS_CLASSIC:
+			if( device->report == WII_LIB_REPORT_HIGH_RESOLUTION )
+			{
+				for( index = 0; index < 4; ++index )
+					WiiOutput_SetScale( config, index, WII_CLASSIC_CONTROLLER_HIGH_RES_ANALOG_HALF_RANGE, WII_CLASSIC_CONTROLLER_HIGH_RES_ANALOG_HALF_RANGE );
+				break;
+			}
+			
+			WiiOutput_SetScale( config, 0, WII_CLASSIC_CONTROLLER_ANALOG_LEFT_HALF_RANGE,	WII_CLASSIC_CONTROLLER_ANALOG_LEFT_HALF_RANGE	);
+			WiiOutput_SetScale( config, 1, WII_CLASSIC_CONTROLLER_ANALOG_LEFT_HALF_RANGE,	WII_CLASSIC_CONTROLLER_ANALOG_LEFT_HALF_RANGE	);
+			WiiOutput_SetScale( config, 2, WII_CLASSIC_CONTROLLER_ANALOG_RIGHT_HALF_RANGE,	WII_CLASSIC_CONTROLLER_ANALOG_RIGHT_HALF_RANGE	);
+			WiiOutput_SetScale( config, 3, WII_CLASSIC_CONTROLLER_ANALOG_RIGHT_HALF_RANGE,	WII_CLASSIC_CONTROLLER_ANALOG_RIGHT_HALF_RANGE	);
+			break;
+		
+		default:
+			return WII_LIB_RC_UNSUPPORTED_DEVICE;
+		
+	}
+	
+	// Calibrated ranges (either side of the center).
+	if( device->calibration )
+	{
+		minimum	= &device->calibration->minimum;
+		center	= &device->calibration->center;
+		maximum	= &device->calibration->maximum;
+		WiiOutput_SetScale( config, 0, center->analogLeftX - minimum->analogLeftX,		maximum->analogLeftX - center->analogLeftX		);
+		WiiOutput_SetScale( config, 1, center->analogLeftY - minimum->analogLeftY,		maximum->analogLeftY - center->analogLeftY		);
+		WiiOutput_SetScale( config, 2, center->analogRightX - minimum->analogRightX,	maximum->analogRightX - center->analogRightX	);
+		WiiOutput_SetScale( config, 3, center->analogRightY - minimum->analogRightY,	maximum->analogRightY - center->analogRightY	);
+	}
+	
+	// Fold the deadzone (remainder stretched back to the full range) and response curve into the 
+	// table. Radial entries hold the gain (output length / input length) instead.
+	config->deadzoneMode = mode;
+	for( index = 0; index < WII_OUTPUT_TABLE_POINTS; ++index )
+	{
+		length	= (int32_t)index << WII_OUTPUT_TABLE_STEP_BITS;
+		if( mode == WII_OUTPUT_DEADZONE_RADIAL && !length )
+			length = 1;																			// Gain at the limit (avoids a zero gain ramp around the center).
+		value	= ( length <= deadzone ? 0 : ((length - deadzone) * WII_OUTPUT_Q15_MAX) / (WII_OUTPUT_Q15_MAX - deadzone) );
+		value	= WiiOutput_Curve( curve, value );
+		
+		// Radial output is limited to the unit circle (joystick corners keep their direction).
+		if( mode == WII_OUTPUT_DEADZONE_RADIAL )
+			value = (int32_t)( ((int64_t)WiiOutput_Clamp( value ) << WII_OUTPUT_SCALE_BITS) / length );
+		
+		config->table[index] = value;
+	}
+	
+	return WII_LIB_RC_SUCCESS;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Produces the normalized joystick axes for the relative values provided.
+//!	
+//!	@param[in]		*config				Settings initialized with 'WiiOutput_Init()'.
+//!	@param[in]		*relative			Relative interface values (see 'WiiLib_GetRelativeInterface()').
+//!	@param[out]		*axes				Normalized axes.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiOutput_Process( const WiiOutput_Config *config, const WiiLib_Interface *relative, WiiOutput_Axes *axes )
+{
+	int32_t			values[4];
+	int32_t			gain;
+	uint8_t			index;
+	
+	values[0]	= WiiOutput_Scale( config, 0, relative->analogLeftX );
+	values[1]	= WiiOutput_Scale( config, 1, relative->analogLeftY );
+	values[2]	= WiiOutput_Scale( config, 2, relative->analogRightX );
+	values[3]	= WiiOutput_Scale( config, 3, relative->analogRightY );
+	
+	if( config->deadzoneMode == WII_OUTPUT_DEADZONE_RADIAL )
+	{
+		for( index = 0; index < 4; index += 2 )
+		{
+			gain				= WiiOutput_Lookup( &config->table[0], WiiMath_Sqrt( (uint32_t)(values[index] * values[index]) + (uint32_t)(values[index + 1] * values[index + 1]) ) );
+			values[index]		= (int32_t)( ((int64_t)values[index] * gain) >> WII_OUTPUT_SCALE_BITS );		// Gain may exceed 1.0 (curve above linear).
+			values[index + 1]	= (int32_t)( ((int64_t)values[index + 1] * gain) >> WII_OUTPUT_SCALE_BITS );
+		}
+	}
+	else
+	{
+		for( index = 0; index < 4; ++index )
+		{
+			if( values[index] < 0 )
+				values[index] = -WiiOutput_Lookup( &config->table[0], (uint32_t)-values[index] );
+			else
+				values[index] = WiiOutput_Lookup( &config->table[0], (uint32_t)values[index] );
+		}
+	}
+	
+	axes->leftX		= WiiOutput_Clamp( values[0] );
+	axes->leftY		= WiiOutput_Clamp( values[1] );
+	axes->rightX	= WiiOutput_Clamp( values[2] );
+	axes->rightY	= WiiOutput_Clamp( values[3] );
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the multipliers of an axis.
+//!	
+//!	@param[out]		*config				Settings to update.
+//!	@param[in]		axis				Axis to update (left x, left y, right x, right y).
+//!	@param[in]		below				Travel (in counts) from the center to the lowest value.
+//!	@param[in]		above				Travel (in counts) from the center to the highest value.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiOutput_SetScale( WiiOutput_Config *config, uint8_t axis, int32_t below, int32_t above )
+{
+	below	= ( below > 0 ? below : 1 );
+	above	= ( above > 0 ? above : 1 );
+	
+	// Full travel maps to 2^15 (rounded up so it is reached; saturated by 'WiiOutput_Scale()').
+	config->scaleNegative[axis]	= (int32_t)( (((int64_t)(WII_OUTPUT_Q15_MAX + 1) << WII_OUTPUT_SCALE_BITS) + below - 1) / below );
+	config->scalePositive[axis]	= (int32_t)( (((int64_t)(WII_OUTPUT_Q15_MAX + 1) << WII_OUTPUT_SCALE_BITS) + above - 1) / above );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Applies a response curve (linear interpolation between its points).
+//!	
+//!	@param[in]		*curve				'WII_OUTPUT_CURVE_POINTS' values (NULL == linear).
+//!	@param[in]		value				Input value (Q15, non-negative).
+//!	
+//!	@returns		Output value (Q15).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static int32_t WiiOutput_Curve( const int16_t *curve, int32_t value )
+{
+	int32_t			index		= value >> WII_OUTPUT_CURVE_STEP_BITS;
+	int32_t			fraction;
+	
+	if( !curve )
+		return value;
+	
+	// Values past the last point follow the slope of the last segment.
+	if( index > WII_OUTPUT_CURVE_POINTS - 2 )
+		index = WII_OUTPUT_CURVE_POINTS - 2;
+	
+	fraction = value - (index << WII_OUTPUT_CURVE_STEP_BITS);
+	
+	return curve[index] + (((curve[index + 1] - curve[index]) * fraction) >> WII_OUTPUT_CURVE_STEP_BITS);
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reads the table (linear interpolation between its entries).
+//!	
+//!	@param[in]		*table				'WII_OUTPUT_TABLE_POINTS' entries.
+//!	@param[in]		value				Length (Q15, below 2^16).
+//!	
+//!	@returns		Table value for the length provided.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static int32_t WiiOutput_Lookup( const int32_t *table, uint32_t value )
+{
+	uint32_t		index		= value >> WII_OUTPUT_TABLE_STEP_BITS;
+	int32_t			fraction	= (int32_t)( value & ((1 << WII_OUTPUT_TABLE_STEP_BITS) - 1) );
+	
+	return table[index] + (((table[index + 1] - table[index]) * fraction) >> WII_OUTPUT_TABLE_STEP_BITS);
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Scales a relative value into Q15 (saturated).
+//!	
+//!	@param[in]		*config				Settings initialized with 'WiiOutput_Init()'.
+//!	@param[in]		axis				Axis the value belongs to.
+//!	@param[in]		value				Relative value (counts).
+//!	
+//!	@returns		Q15 value (-2^15 - 2^15, full travel lands on the last table entry used).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static int32_t WiiOutput_Scale( const WiiOutput_Config *config, uint8_t axis, int32_t value )
+{
+	value = (int32_t)( ((int64_t)value * ( value < 0 ? config->scaleNegative[axis] : config->scalePositive[axis] )) >> WII_OUTPUT_SCALE_BITS );
+	
+	if( value > WII_OUTPUT_Q15_MAX + 1 )
+		return WII_OUTPUT_Q15_MAX + 1;
+	
+	if( value < -(WII_OUTPUT_Q15_MAX + 1) )
+		return -(WII_OUTPUT_Q15_MAX + 1);
+	
+	return value;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Saturates a value to the normalized range.
+//!	
+//!	@param[in]		value				Value to saturate.
+//!	
+//!	@returns		Value limited to -'WII_OUTPUT_Q15_MAX' - 'WII_OUTPUT_Q15_MAX'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static int16_t WiiOutput_Clamp( int32_t value )
+{
+	if( value > WII_OUTPUT_Q15_MAX )
+		return WII_OUTPUT_Q15_MAX;
+	
+	if( value < -WII_OUTPUT_Q15_MAX )
+		return -WII_OUTPUT_Q15_MAX;
+	
+	return (int16_t)value;
+	
+}
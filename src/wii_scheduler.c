@@ -0,0 +1,418 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements servicing of multiple Wii targets spread across I2C modules and I2C 
+//!					multiplexers.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+#include "i2c.h"
+#include "wii_lib.h"
+
+
+
+
+//==================================================================================================
+//	PRIVATE CONSTANTS
+//--------------------------------------------------------------------------------------------------
+// Thresholds of targets whose driver has none (see 'WiiDriver_Thresholds'): any change of an analog 
+// control counts as activity. Indexed by control - 'WII_LIB_BUTTON_COUNT'.
+static const uint16_t	WiiScheduler_ThresholdsAny[WII_LIB_CONTROL_ANALOG_COUNT]	= { 0 };
+
+// Flags activity for an analog control that moved beyond its threshold (see 
+// 'WII_LIB_CONTROLS_ANALOG'). Expects 'current', 'reference', 'thresholds', and 'active' in scope.
+#define	WII_SCHEDULER_CHECK_ANALOG( control, member )													\
+	active |= WiiScheduler_Exceeds( current->member, reference->member, thresholds[(control) - WII_LIB_BUTTON_COUNT] );
+
+
+
+
+//==================================================================================================
+//	PRIVATE FUNCTION PROTOTYPES
+//--------------------------------------------------------------------------------------------------
+static BOOL			WiiScheduler_IsHeld(		WiiScheduler_Pacing *pacing,	WiiLib_Device *device,	uint32_t nowUs					);
+static void			WiiScheduler_Pace(			WiiScheduler *scheduler,		uint8_t index,			uint32_t nowUs					);
+static BOOL			WiiScheduler_IsActive(		WiiLib_Device *device,			const WiiLib_Interface *reference							);
+static BOOL			WiiScheduler_Exceeds(		int32_t value,					int32_t reference,		uint16_t threshold				);
+static void			WiiScheduler_UpdateRates(	WiiScheduler *scheduler,		uint32_t nowUs													);
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Initializes an empty scheduler.
+//!	
+//!	@param[in]		*scheduler			Scheduler to initialize.
+//!	@param[in]		clock				Time source (microseconds). Sampled before every call to 
+//!										'WiiLib_Service()' so deadlines stay accurate when 
+//!										transfers block.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiScheduler_Init( WiiScheduler *scheduler, WiiScheduler_Clock clock )
+{
+	uint32_t		index;
+	
+	memset( scheduler, 0, sizeof(WiiScheduler) );
+	scheduler->clock			= clock;
+	scheduler->windowStartUs	= clock();
+	
+	for( index = 0; index < I2C_NUMBER_OF_MODULES; ++index )
+		scheduler->buses[index].muxState.muxAddr = WII_LIB_MUX_UNKNOWN;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Adds a device to the scheduler.
+//!	
+//!	@details		The device must already be initialized with 'WiiLib_InitNonBlocking()' (no bus 
+//!					traffic yet). Its multiplexer route is defined against the channel tracking of 
+//!					its module (see 'WiiLib_SetMuxChannel()').
+//!	
+//!	@param[in]		*scheduler			Scheduler to add the device to.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		muxAddr				Address of the multiplexer the target sits behind 
+//!										('WII_LIB_MUX_NONE' == wired directly).
+//!	@param[in]		channel				Channel of the multiplexer the target is wired to.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiScheduler_AddDevice( WiiScheduler *scheduler, WiiLib_Device *device, uint8_t muxAddr, uint8_t channel )
+{
+	WiiScheduler_Bus	*bus;
+	WiiScheduler_Pacing	*pacing;
+	WII_LIB_RC			returnCode;
+	
+	if( scheduler->deviceCount >= WII_SCHEDULER_MAX_DEVICES || device->i2c.port.module >= I2C_NUMBER_OF_MODULES )
+		return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	
+	bus			= &scheduler->buses[device->i2c.port.module];
+	returnCode	= WiiLib_SetMuxChannel( device, &bus->muxState, muxAddr, channel );
+	if( returnCode != WII_LIB_RC_SUCCESS )
+		return returnCode;
+	
+	pacing					= &scheduler->pacing[scheduler->deviceCount];
+	pacing->minIntervalUs	= WII_SCHEDULER_DEFAULT_MIN_INTERVAL_US;
+	pacing->maxIntervalUs	= WII_SCHEDULER_DEFAULT_MAX_INTERVAL_US;
+	pacing->intervalUs		= WII_SCHEDULER_DEFAULT_MIN_INTERVAL_US;
+	pacing->primed			= FALSE;
+	
+	scheduler->devices[ scheduler->deviceCount++ ] = device;
+	++bus->deviceCount;
+	
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Selects how status polls are paced.
+//!	
+//!	@details		Switching modes restarts every device at its minimum poll interval (the next 
+//!					frame of each device becomes its activity reference).
+//!	
+//!	@param[in]		*scheduler			Scheduler to update.
+//!	@param[in]		mode				Pacing to apply.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiScheduler_SetMode( WiiScheduler *scheduler, WII_SCHEDULER_MODE mode )
+{
+	uint8_t			index;
+	
+	scheduler->mode = mode;
+	
+	for( index = 0; index < scheduler->deviceCount; ++index )
+	{
+		scheduler->pacing[index].intervalUs	= scheduler->pacing[index].minIntervalUs;
+		scheduler->pacing[index].primed		= FALSE;
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Defines the range of poll intervals of a device in adaptive mode.
+//!	
+//!	@param[in]		*scheduler			Scheduler owning the device.
+//!	@param[in]		index				Index of the device (order of 'WiiScheduler_AddDevice()' calls).
+//!	@param[in]		minIntervalUs		Poll interval while active (intervals shorter than the 
+//!										post-read delay of the target behave as full rate).
+//!	@param[in]		maxIntervalUs		Longest poll interval while idle.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiScheduler_SetPollInterval( WiiScheduler *scheduler, uint8_t index, uint32_t minIntervalUs, uint32_t maxIntervalUs )
+{
+	WiiScheduler_Pacing		*pacing;
+	
+	if( index >= scheduler->deviceCount )
+		return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	
+	// Interval doubles while idle, so it must start above zero.
+	if( minIntervalUs == 0 || minIntervalUs > maxIntervalUs )
+		return WII_LIB_RC_UNKOWN_PARAMETER;
+	
+	pacing					= &scheduler->pacing[index];
+	pacing->minIntervalUs	= minIntervalUs;
+	pacing->maxIntervalUs	= maxIntervalUs;
+	pacing->intervalUs		= minIntervalUs;
+	
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Services every device once.
+//!	
+//!	@details		Devices are serviced in round-robin order with the starting device rotating 
+//!					on every pass so no device is consistently serviced last. Each device executes 
+//!					at most one transfer per pass. In adaptive mode a device between polls is 
+//!					skipped until its poll interval elapses.
+//!	
+//!	@param[in]		*scheduler			Scheduler to service.
+//!	
+//!	@returns		Bitmask of the devices (index order of 'WiiScheduler_AddDevice()' calls) that 
+//!					decoded a new status frame during this pass.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t WiiScheduler_Service( WiiScheduler *scheduler )
+{
+	uint32_t		updated		= 0;
+	uint8_t			pass;
+	uint8_t			index;
+	
+	if( scheduler->deviceCount == 0 )
+		return 0;
+	
+	for( pass = 0, index = scheduler->next; pass < scheduler->deviceCount; ++pass )
+	{
+		WiiLib_Device	*device		= scheduler->devices[index];
+		uint32_t		nowUs		= scheduler->clock();
+		
+		if( scheduler->mode == WII_SCHEDULER_MODE_ADAPTIVE && WiiScheduler_IsHeld( &scheduler->pacing[index], device, nowUs ) )
+		{
+			// Poll interval not elapsed yet. Leave the bus to the other devices.
+		}
+		else if( WiiLib_Service( device, nowUs ) == WII_LIB_RC_SUCCESS )
+		{
+			updated |= ( 1UL << index );
+			++scheduler->buses[device->i2c.port.module].frames;
+			
+			if( scheduler->mode == WII_SCHEDULER_MODE_ADAPTIVE )
+				WiiScheduler_Pace( scheduler, index, scheduler->clock() );
+		}
+		
+		if( ++index >= scheduler->deviceCount )
+			index = 0;
+	}
+	
+	if( ++scheduler->next >= scheduler->deviceCount )
+		scheduler->next = 0;
+	
+	WiiScheduler_UpdateRates( scheduler, scheduler->clock() );
+	return updated;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reports the aggregate frame rate achieved on a module.
+//!	
+//!	@param[in]		*scheduler			Scheduler servicing the module.
+//!	@param[in]		module				Module to report.
+//!	
+//!	@returns		Frames per second (all devices on the module) measured over the last completed 
+//!					window of 'WII_SCHEDULER_RATE_WINDOW_US'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t WiiScheduler_GetFramesPerSecond( WiiScheduler *scheduler, I2C_MODULE module )
+{
+	if( module >= I2C_NUMBER_OF_MODULES )
+		return 0;
+	
+	return scheduler->buses[module].framesPerSecond;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Reports the share of full rate polling avoided on a module in adaptive mode.
+//!	
+//!	@details		Estimated as the time devices were held back past the point they were ready to 
+//!					poll again, relative to the time all devices on the module could have spent 
+//!					polling. Bus time saved follows the same share.
+//!	
+//!	@param[in]		*scheduler			Scheduler servicing the module.
+//!	@param[in]		module				Module to report.
+//!	
+//!	@returns		Percent (0 - 100) measured over the last completed window of 
+//!					'WII_SCHEDULER_RATE_WINDOW_US'.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t WiiScheduler_GetUtilizationSaved( WiiScheduler *scheduler, I2C_MODULE module )
+{
+	if( module >= I2C_NUMBER_OF_MODULES )
+		return 0;
+	
+	return scheduler->buses[module].utilizationSaved;
+}
+
+
+
+
+//==================================================================================================
+//	PRIVATE METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Checks if a device should be skipped because its poll interval has not elapsed.
+//!	
+//!	@details		Only devices that are active, error free, and between polls are held. Connection 
+//!					attempts, reconfiguration, and transfers in progress always proceed. A rejected 
+//!					frame (see 'WII_LIB_FRAME') counts as an error, so the device is polled again as 
+//!					soon as its own post-read wait ends.
+//!	
+//!	@param[in]		*pacing				Pacing of the device.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		nowUs				Current time in microseconds.
+//!	
+//!	@returns		TRUE if the device should not be serviced yet.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiScheduler_IsHeld( WiiScheduler_Pacing *pacing, WiiLib_Device *device, uint32_t nowUs )
+{
+	const WiiLib_ServiceTracking	*service	= &device->service;
+	
+	if( !pacing->primed || device->status != WII_LIB_DEVICE_STATUS_ACTIVE || device->failedParamQueryCount || service->job != WII_LIB_SERVICE_JOB_NONE )
+		return FALSE;
+	
+	if( service->state != WII_LIB_SERVICE_STATE_IDLE && !(service->state == WII_LIB_SERVICE_STATE_WAIT && service->nextState == WII_LIB_SERVICE_STATE_IDLE) )
+		return FALSE;
+	
+	return ( (int32_t)(nowUs - pacing->nextPollUs) < 0 );
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Updates the poll interval of a device after it decoded a status frame.
+//!	
+//!	@details		An active frame resets the interval to the minimum and becomes the new activity 
+//!					reference. An idle frame doubles the interval (up to the maximum) and keeps the 
+//!					old reference, so slow drifts still add up to activity. A frame where nothing 
+//!					changed (see 'WiiLib_Device{}.changedMask') is idle without comparing controls. 
+//!					Devices with orientation fusion attached are never held back longer than 
+//!					'WII_SCHEDULER_FUSION_MAX_INTERVAL_US'.
+//!	
+//!	@param[in]		*scheduler			Scheduler owning the device.
+//!	@param[in]		index				Index of the device.
+//!	@param[in]		nowUs				Time the frame was decoded (microseconds).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiScheduler_Pace( WiiScheduler *scheduler, uint8_t index, uint32_t nowUs )
+{
+	WiiScheduler_Pacing		*pacing		= &scheduler->pacing[index];
+	WiiLib_Device			*device		= scheduler->devices[index];
+	int32_t					heldUs;
+	
+	if( !pacing->primed || (device->changedMask && WiiScheduler_IsActive( device, &pacing->reference )) )
+	{
+		pacing->reference	= device->interfaceCurrent;
+		pacing->primed		= TRUE;
+		pacing->intervalUs	= pacing->minIntervalUs;
+	}
+	else if( pacing->intervalUs < pacing->maxIntervalUs )
+	{
+		pacing->intervalUs	= ( pacing->intervalUs > (pacing->maxIntervalUs / 2) ? pacing->maxIntervalUs : pacing->intervalUs * 2 );
+	}
+	
+	// Rates are integrated over the measured time between frames, which must stay within what the 
+	// fusion stage can integrate (see 'WiiFusion_ProcessDevice()').
+	if( device->fusion && pacing->intervalUs > WII_SCHEDULER_FUSION_MAX_INTERVAL_US )
+		pacing->intervalUs = WII_SCHEDULER_FUSION_MAX_INTERVAL_US;
+	
+	pacing->nextPollUs = nowUs + pacing->intervalUs;
+	
+	// Time held back beyond the wait the device observes on its own.
+	heldUs = (int32_t)( pacing->nextPollUs - device->service.deadlineUs );
+	if( heldUs > 0 && device->service.state == WII_LIB_SERVICE_STATE_WAIT )
+		scheduler->buses[device->i2c.port.module].heldUs += (uint32_t)heldUs;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Compares the latest frame of a device against its activity reference.
+//!	
+//!	@details		Analog thresholds come from the driver of the target (see 
+//!					'WiiDriver_Thresholds'); any change counts when it has none.
+//!	
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	@param[in]		*reference			Values of the last frame that showed activity.
+//!	
+//!	@returns		TRUE if a button changed or an analog control moved beyond its threshold.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiScheduler_IsActive( WiiLib_Device *device, const WiiLib_Interface *reference )
+{
+	const WiiLib_Interface		*current		= &device->interfaceCurrent;
+	const uint16_t				*thresholds;
+	BOOL						active;
+	
+	thresholds = ( device->driver && device->driver->thresholds ) ? device->driver->thresholds( device ) : NULL;
+	if( !thresholds )
+		thresholds = WiiScheduler_ThresholdsAny;
+	
+	active = ( current->buttons != reference->buttons );
+	WII_LIB_CONTROLS_ANALOG( WII_SCHEDULER_CHECK_ANALOG )
+	
+	return active;
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Checks if an analog control moved beyond its threshold.
+//!	
+//!	@param[in]		value				Current value of the control.
+//!	@param[in]		reference			Reference value of the control.
+//!	@param[in]		threshold			Change that must be exceeded.
+//!	
+//!	@returns		TRUE if the control moved beyond the threshold.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static BOOL WiiScheduler_Exceeds( int32_t value, int32_t reference, uint16_t threshold )
+{
+	int32_t			delta		= value - reference;
+	
+	return ( (delta < 0 ? -delta : delta) > (int32_t)threshold );
+	
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Closes the measurement window once it has elapsed and latches the frame rate of 
+//!					every module.
+//!	
+//!	@param[in]		*scheduler			Scheduler to update.
+//!	@param[in]		nowUs				Current time in microseconds.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void WiiScheduler_UpdateRates( WiiScheduler *scheduler, uint32_t nowUs )
+{
+	uint32_t		elapsedUs	= nowUs - scheduler->windowStartUs;
+	uint32_t		index;
+	uint64_t		saved;
+	
+	if( elapsedUs < WII_SCHEDULER_RATE_WINDOW_US )
+		return;
+	
+	for( index = 0; index < I2C_NUMBER_OF_MODULES; ++index )
+	{
+		WiiScheduler_Bus	*bus	= &scheduler->buses[index];
+		
+		bus->framesPerSecond	= (uint32_t)( ((uint64_t)bus->frames * 1000000ULL + (elapsedUs / 2)) / elapsedUs );
+		bus->frames				= 0;
+		
+		if( bus->deviceCount )
+		{
+			saved					= ( (uint64_t)bus->heldUs * 100ULL ) / ( (uint64_t)elapsedUs * bus->deviceCount );
+			bus->utilizationSaved	= (uint8_t)( saved > 100 ? 100 : saved );
+		}
+		bus->heldUs				= 0;
+	}
+	
+	scheduler->windowStartUs = nowUs;
+}
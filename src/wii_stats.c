@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@file
+//!	
+//!	@brief			Implements the optional per-device statistics of the "wii" library module.
+//!	
+//!	@note			Compiles to nothing unless 'WII_LIB_STATS' is non-zero.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+//==================================================================================================
+//	INCLUDES
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+#include "i2c.h"
+#include "wii_lib.h"
+
+
+#if WII_LIB_STATS
+
+
+
+
+//==================================================================================================
+//	PUBLIC METHODS
+//--------------------------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Clears the provided statistics block.
+//!	
+//!	@param[in]		*stats				Block to clear.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiStats_Init( WiiStats_Block *stats )
+{
+	uint8_t			index;
+	
+	memset( (void *)stats, 0, sizeof(WiiStats_Block) );
+	
+	for( index = 0; index < WII_STATS_TIMER_COUNT; ++index )
+		stats->timers[index].minimum = UINT32_MAX;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Attaches a statistics block to a device.
+//!	
+//!	@details		Passing a NULL block stops recording.
+//!	
+//!	@param[in]		*stats				Block initialized with 'WiiStats_Init()'.
+//!	@param[in]		*device				Instance of 'WiiLib_Device{}'.
+//!	
+//!	@returns		Return code corresponding to an entry in the 'WII_LIB_RC' enum (zero == success; 
+//!					non-zero == error code). Please see enum definition for details.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WII_LIB_RC WiiStats_Attach( WiiStats_Block *stats, WiiLib_Device *device )
+{
+	if( stats && !device->backend->cycles )
+		return WII_LIB_RC_UNSUPPORTED_DEVICE;
+	
+	device->stats = stats;
+	return WII_LIB_RC_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Records a single duration.
+//!	
+//!	@param[in]		*stats				Block to update.
+//!	@param[in]		timer				Timer the duration belongs to.
+//!	@param[in]		cycles				Duration in backend counter cycles.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiStats_AddTime( WiiStats_Block *stats, WII_STATS_TIMER timer, uint32_t cycles )
+{
+	WiiStats_Timer		*entry		= &stats->timers[timer];
+	
+	++entry->count;
+	entry->total += cycles;
+	
+	if( cycles < entry->minimum )
+		entry->minimum = cycles;
+	
+	if( cycles > entry->maximum )
+		entry->maximum = cycles;
+	
+	// Bin is the position of the highest bit set (count leading zeros is a single instruction on 
+	// the PIC32).
+	++entry->histogram[ cycles ? 31 - __builtin_clz( cycles ) : 0 ];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Records the outcome of a transfer or response.
+//!	
+//!	@param[in]		*stats				Block to update.
+//!	@param[in]		rc					Outcome to record.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WiiStats_AddResult( WiiStats_Block *stats, WII_LIB_RC rc )
+{
+	if( (uint32_t)rc < WII_LIB_RC_COUNT )
+		++stats->results[rc];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//!	@brief			Computes the average duration recorded by a timer.
+//!	
+//!	@param[in]		*timer				Timer to read.
+//!	
+//!	@returns		Average duration in backend counter cycles (zero if nothing was recorded).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t WiiStats_GetAverage( const WiiStats_Timer *timer )
+{
+	if( !timer->count )
+		return 0;
+	
+	return (uint32_t)( timer->total / timer->count );
+	
+}
+
+
+#endif	// WII_LIB_STATS